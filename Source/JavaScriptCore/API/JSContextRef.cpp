@@ -35,6 +35,7 @@
 #include "JSGlobalObject.h"
 #include "JSObject.h"
 #include "JSCInlines.h"
+#include "SamplingProfiler.h"
 #include "SourceProvider.h"
 #include "StackVisitor.h"
 #include "Watchdog.h"
@@ -377,6 +378,52 @@ void JSGlobalContextSetIncludesNativeCallStackWhenReportingExceptions(JSGlobalCo
 #endif
 }
 
+void JSGlobalContextStartSamplingProfiler(JSGlobalContextRef ctx)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return;
+    }
+
+    ExecState* exec = toJS(ctx);
+    JSLockHolder lock(exec);
+
+    SamplingProfiler& samplingProfiler = exec->vm().ensureSamplingProfiler(WTF::Stopwatch::create());
+    samplingProfiler.noticeCurrentThreadAsJSCExecutionThread();
+    samplingProfiler.start();
+#else
+    UNUSED_PARAM(ctx);
+#endif
+}
+
+bool JSGlobalContextWriteSamplingProfile(JSGlobalContextRef ctx, const char* path)
+{
+#if ENABLE(SAMPLING_PROFILER)
+    if (!ctx || !path) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    ExecState* exec = toJS(ctx);
+    JSLockHolder lock(exec);
+
+    SamplingProfiler* samplingProfiler = exec->vm().samplingProfiler();
+    if (!samplingProfiler)
+        return false;
+    if (!samplingProfiler->reportCollapsedStackTracesToFile(path))
+        return false;
+
+    LockHolder locker(samplingProfiler->getLock());
+    samplingProfiler->clearData(locker);
+    return true;
+#else
+    UNUSED_PARAM(ctx);
+    UNUSED_PARAM(path);
+    return false;
+#endif
+}
+
 #if USE(CF)
 CFRunLoopRef JSGlobalContextGetDebuggerRunLoop(JSGlobalContextRef ctx)
 {
@@ -128,6 +128,24 @@ JS_EXPORT bool JSGlobalContextGetIncludesNativeCallStackWhenReportingExceptions(
 */
 JS_EXPORT void JSGlobalContextSetIncludesNativeCallStackWhenReportingExceptions(JSGlobalContextRef ctx, bool includesNativeCallStack) CF_AVAILABLE(10_10, 8_0);
 
+/*!
+@function
+@abstract Starts sampling the JavaScript call stacks of a context's virtual machine.
+@param ctx The JSGlobalContext whose virtual machine you want to profile.
+@discussion The calling thread is the one that will be sampled. Samples accumulate until they are written out with JSGlobalContextWriteSamplingProfile.
+*/
+JS_EXPORT void JSGlobalContextStartSamplingProfiler(JSGlobalContextRef ctx);
+
+/*!
+@function
+@abstract Writes the samples collected for a context to a file and discards them.
+@param ctx The JSGlobalContext whose samples you want to write.
+@param path The path of the file to write.
+@result true if the samples were written, otherwise false.
+@discussion The file uses the collapsed stack format of flamegraph.pl: one line per distinct stack, with frames listed from outermost to innermost, separated by semicolons and followed by the number of samples. Native functions are marked with " [native]", and functions inlined by the optimizing JITs with " [inlined]".
+*/
+JS_EXPORT bool JSGlobalContextWriteSamplingProfile(JSGlobalContextRef ctx, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
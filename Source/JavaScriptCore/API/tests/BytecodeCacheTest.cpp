@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BytecodeCacheTest.h"
+
+#include "BytecodeCache.h"
+#include "Completion.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JSGlobalObject.h"
+#include "Options.h"
+#include "VM.h"
+#include <wtf/RefPtr.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/WTFString.h>
+
+#if OS(UNIX)
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+using namespace JSC;
+
+#if OS(UNIX)
+
+static const char* programSource =
+    "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }" "\n"
+    "var values = [];" "\n"
+    "for (var i = 0; i < 10; ++i)" "\n"
+    "    values.push(fib(i));" "\n"
+    "values.join(',') + ' ' + (function() { return 'nested'; })();";
+
+static const char* expectedResult = "0,1,1,2,3,5,8,13,21,34 nested";
+
+// Runs the program in a new VM, which writes the cache when it is destroyed.
+static bool runProgramInNewVM()
+{
+    bool passed;
+    RefPtr<VM> vm = VM::create();
+    {
+        JSLockHolder locker(vm.get());
+        JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+        ExecState* exec = globalObject->globalExec();
+
+        NakedPtr<Exception> exception;
+        JSValue result = evaluate(exec, makeSource(programSource, SourceOrigin()), JSValue(), exception);
+        passed = !exception && result.isString() && asString(result)->value(exec) == expectedResult;
+    }
+    vm = nullptr;
+    return passed;
+}
+
+template<typename Functor>
+static unsigned forEachCacheFile(const CString& directory, const Functor& functor)
+{
+    unsigned count = 0;
+    DIR* dir = opendir(directory.data());
+    if (!dir)
+        return count;
+    while (struct dirent* entry = readdir(dir)) {
+        String name = String::fromUTF8(entry->d_name);
+        if (!name.endsWith(".jscbytecode"))
+            continue;
+        functor(String::format("%s/%s", directory.data(), entry->d_name).utf8());
+        ++count;
+    }
+    closedir(dir);
+    return count;
+}
+
+// Flips the last byte of the file, which is part of the encoded payload.
+static bool corruptFile(const CString& path)
+{
+    int fd = open(path.data(), O_RDWR);
+    if (fd == -1)
+        return false;
+    off_t lastByte = lseek(fd, -1, SEEK_END);
+    uint8_t byte;
+    bool corrupted = false;
+    if (lastByte != -1 && pread(fd, &byte, 1, lastByte) == 1) {
+        byte = ~byte;
+        corrupted = pwrite(fd, &byte, 1, lastByte) == 1;
+    }
+    close(fd);
+    return corrupted;
+}
+
+int testBytecodeCache()
+{
+    JSC::initializeThreading();
+    Options::initialize();
+
+    char directoryTemplate[] = "/tmp/testapi-bytecode-cache-XXXXXX";
+    if (!mkdtemp(directoryTemplate)) {
+        printf("FAIL: bytecode cache test could not create a cache directory.\n");
+        return 1;
+    }
+    CString directory(directoryTemplate);
+
+    const char* oldDiskCachePath = Options::diskCachePath();
+    Options::diskCachePath() = directory.data();
+
+    bool failed = false;
+
+    // The first run compiles the program and writes it to the cache.
+    unsigned hits = numberOfBytecodeCacheHits();
+    if (!runProgramInNewVM() || numberOfBytecodeCacheHits() != hits) {
+        printf("FAIL: bytecode cache first run.\n");
+        failed = true;
+    }
+    if (forEachCacheFile(directory, [] (const CString&) { }) != 1) {
+        printf("FAIL: bytecode cache was not written when the VM was destroyed.\n");
+        failed = true;
+    }
+
+    // A new VM reads the program back from the cache and gets the same result.
+    hits = numberOfBytecodeCacheHits();
+    if (!runProgramInNewVM() || numberOfBytecodeCacheHits() != hits + 1) {
+        printf("FAIL: bytecode cache was not used, or the cached program gave the wrong result.\n");
+        failed = true;
+    }
+
+    // A corrupted entry is rejected, and the program is compiled from source again.
+    bool corrupted = true;
+    forEachCacheFile(directory, [&] (const CString& path) { corrupted = corruptFile(path) && corrupted; });
+    hits = numberOfBytecodeCacheHits();
+    if (!corrupted || !runProgramInNewVM() || numberOfBytecodeCacheHits() != hits) {
+        printf("FAIL: bytecode cache used a corrupted entry.\n");
+        failed = true;
+    }
+
+    // The entry written after the corrupted one was rejected is usable again.
+    hits = numberOfBytecodeCacheHits();
+    if (!runProgramInNewVM() || numberOfBytecodeCacheHits() != hits + 1) {
+        printf("FAIL: bytecode cache entry was not rewritten after being rejected.\n");
+        failed = true;
+    }
+
+    Options::diskCachePath() = oldDiskCachePath;
+    forEachCacheFile(directory, [] (const CString& path) { unlink(path.data()); });
+    rmdir(directory.data());
+
+    if (!failed)
+        printf("PASS: bytecode cache test.\n");
+    return failed;
+}
+
+#else
+
+int testBytecodeCache()
+{
+    printf("PASS: bytecode cache test (skipped, the bytecode cache needs a UNIX file system).\n");
+    return 0;
+}
+
+#endif // OS(UNIX)
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ConcurrentSweepingTest.h"
+
+#include "Completion.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JSGlobalObject.h"
+#include "Options.h"
+#include "VM.h"
+#include <wtf/RefPtr.h>
+
+using namespace JSC;
+
+// Churns through objects, arrays and strings without destructors, so that the blocks they live in
+// are swept by the concurrent sweeper, while keeping a live set whose contents are checked after
+// every round.
+static const char* stressSource =
+    "var live = [];" "\n"
+    "for (var i = 0; i < 256; ++i)" "\n"
+    "    live.push({ index: i, values: [i, i * 2], name: 'live' + i });" "\n"
+    "function churn(round) {" "\n"
+    "    var sum = 0;" "\n"
+    "    for (var i = 0; i < 20000; ++i) {" "\n"
+    "        var object = { a: i, b: [i, round], c: 'x' + i };" "\n"
+    "        sum += object.b[0] + object.c.length;" "\n"
+    "        if (!(i % 97))" "\n"
+    "            live[(i + round) % live.length] = { index: (i + round) % live.length, values: [i, round], name: 'live' + ((i + round) % live.length) };" "\n"
+    "    }" "\n"
+    "    return sum;" "\n"
+    "}" "\n"
+    "function check() {" "\n"
+    "    for (var i = 0; i < live.length; ++i) {" "\n"
+    "        var entry = live[i];" "\n"
+    "        if (entry.index !== i || entry.name !== 'live' + i || entry.values.length !== 2)" "\n"
+    "            return false;" "\n"
+    "    }" "\n"
+    "    return true;" "\n"
+    "}";
+
+int testConcurrentSweeping()
+{
+    JSC::initializeThreading();
+    Options::initialize();
+
+    bool oldUseConcurrentSweeping = Options::useConcurrentSweeping();
+    Options::useConcurrentSweeping() = true;
+
+    bool failed = false;
+    RefPtr<VM> vm = VM::create();
+    {
+        JSLockHolder locker(vm.get());
+        JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+        ExecState* exec = globalObject->globalExec();
+
+        NakedPtr<Exception> exception;
+        evaluate(exec, makeSource(stressSource, SourceOrigin()), JSValue(), exception);
+        failed = !!exception;
+
+        for (unsigned round = 0; round < 50 && !failed; ++round) {
+            String churn = String::format("churn(%u)", round);
+            JSValue sum = evaluate(exec, makeSource(churn, SourceOrigin()), JSValue(), exception);
+            JSValue checked = evaluate(exec, makeSource("check()", SourceOrigin()), JSValue(), exception);
+            if (exception || !sum.isNumber() || !checked.isTrue()) {
+                printf("FAIL: concurrent sweeping corrupted the heap in round %u.\n", round);
+                failed = true;
+            }
+
+            // Alternate between full collections and letting the allocation above trigger eden
+            // collections, so the sweeper is stopped both while idle and while it has work left.
+            if (round % 2)
+                vm->heap.collectAllGarbage();
+        }
+    }
+    vm = nullptr;
+
+    Options::useConcurrentSweeping() = oldUseConcurrentSweeping;
+
+    if (!failed)
+        printf("PASS: concurrent sweeping stress test.\n");
+    return failed;
+}
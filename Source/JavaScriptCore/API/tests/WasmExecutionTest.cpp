@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmExecutionTest.h"
+
+#include "Completion.h"
+#include "InitializeThreading.h"
+#include "JSCInlines.h"
+#include "JSGlobalObject.h"
+#include "Options.h"
+#include "VM.h"
+#include <wtf/RefPtr.h>
+
+using namespace JSC;
+
+#if ENABLE(WEBASSEMBLY)
+
+// A module with one page of memory and two functions of type (i32) -> i32:
+// sum(n) adds n, n - 1, ..., 1 in a loop, and load(index) is an i32.load from memory.
+static const char* testSource =
+    "var bytes = new Uint8Array([" "\n"
+    "    0x00, 0x61, 0x73, 0x6d, 0x0d, 0x00, 0x00, 0x00," "\n"
+    "    0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f," "\n" // Type section.
+    "    0x03, 0x03, 0x02, 0x00, 0x00," "\n" // Function section.
+    "    0x05, 0x03, 0x01, 0x00, 0x01," "\n" // Memory section: one page.
+    "    0x07, 0x0e, 0x02, 0x03, 0x73, 0x75, 0x6d, 0x00, 0x00, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x01," "\n" // Export section.
+    "    0x0a, 0x23, 0x02," "\n" // Code section.
+    "    0x19, 0x01, 0x01, 0x7f, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01," "\n"
+    "    0x20, 0x00, 0x41, 0x01, 0x6b, 0x22, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x0b," "\n"
+    "    0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b," "\n"
+    "]);" "\n"
+    "var exports = new WebAssembly.Instance(new WebAssembly.Module(bytes)).exports;" "\n"
+    "function expectedSum(n) {" "\n"
+    "    var sum = 0;" "\n"
+    "    for (var i = n; i > 0; --i)" "\n"
+    "        sum = (sum + i) | 0;" "\n"
+    "    return sum;" "\n"
+    "}" "\n"
+    "function traps(index) {" "\n"
+    "    try {" "\n"
+    "        exports.load(index);" "\n"
+    "    } catch (e) {" "\n"
+    "        return e instanceof WebAssembly.RuntimeError;" "\n"
+    "    }" "\n"
+    "    return false;" "\n"
+    "}" "\n"
+    "function checkBounds() {" "\n"
+    "    return exports.load(0) === 0 && exports.load(65532) === 0" "\n"
+    "        && traps(65533) && traps(65536) && traps(-4) && traps(0x7fffffff);" "\n"
+    "}";
+
+static bool evaluateToTrue(ExecState* exec, const char* source)
+{
+    NakedPtr<Exception> exception;
+    JSValue result = evaluate(exec, makeSource(source, SourceOrigin()), JSValue(), exception);
+    return !exception && result.isTrue();
+}
+
+int testWasmExecution()
+{
+    JSC::initializeThreading();
+    Options::initialize();
+
+    if (!Options::useWebAssembly()) {
+        printf("PASS: Wasm execution test (skipped, WebAssembly is disabled).\n");
+        return 0;
+    }
+
+    // Tier up after a few hundred loop iterations, so the first long call to sum() triggers the
+    // optimizing compile in the middle of its loop and later calls may run the optimized code.
+    bool oldUseWebAssemblyTierUp = Options::useWebAssemblyTierUp();
+    int32_t oldTierUpCount = Options::webAssemblyOMGTierUpCount();
+    Options::useWebAssemblyTierUp() = true;
+    Options::webAssemblyOMGTierUpCount() = 5000;
+
+    bool failed = false;
+    RefPtr<VM> vm = VM::create();
+    {
+        JSLockHolder locker(vm.get());
+        JSGlobalObject* globalObject = JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull()));
+        ExecState* exec = globalObject->globalExec();
+
+        NakedPtr<Exception> exception;
+        evaluate(exec, makeSource(testSource, SourceOrigin()), JSValue(), exception);
+        if (exception) {
+            printf("FAIL: Wasm execution test could not instantiate its module.\n");
+            failed = true;
+        }
+
+        // Out of bounds accesses trap, whether memory is guarded by fast memory's signal handler or
+        // by explicit bounds checks, and in the baseline as well as the optimized code.
+        if (!failed && !evaluateToTrue(exec, "checkBounds()")) {
+            printf("FAIL: Wasm out of bounds accesses in baseline code.\n");
+            failed = true;
+        }
+
+        if (!failed && !evaluateToTrue(exec, "exports.sum(1000000) === expectedSum(1000000)")) {
+            printf("FAIL: Wasm function that tiers up in the middle of its loop.\n");
+            failed = true;
+        }
+
+        static const char* repeatedCalls =
+            "var correct = true;" "\n"
+            "for (var i = 0; i < 2000; ++i) {" "\n"
+            "    var n = 1000 + i * 37;" "\n"
+            "    if (exports.sum(n) !== expectedSum(n) || exports.load(i * 4) !== 0)" "\n"
+            "        correct = false;" "\n"
+            "}" "\n"
+            "correct";
+        if (!failed && !evaluateToTrue(exec, repeatedCalls)) {
+            printf("FAIL: Wasm function after tier up.\n");
+            failed = true;
+        }
+
+        if (!failed && !evaluateToTrue(exec, "checkBounds()")) {
+            printf("FAIL: Wasm out of bounds accesses after tier up.\n");
+            failed = true;
+        }
+    }
+    vm = nullptr;
+
+    Options::useWebAssemblyTierUp() = oldUseWebAssemblyTierUp;
+    Options::webAssemblyOMGTierUpCount() = oldTierUpCount;
+
+    if (!failed)
+        printf("PASS: Wasm execution test.\n");
+    return failed;
+}
+
+#else
+
+int testWasmExecution()
+{
+    printf("PASS: Wasm execution test (skipped, WebAssembly is not enabled).\n");
+    return 0;
+}
+
+#endif // ENABLE(WEBASSEMBLY)
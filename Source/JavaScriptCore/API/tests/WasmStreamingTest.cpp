@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmStreamingTest.h"
+
+#include "JSCInlines.h"
+#include "Options.h"
+#include "VM.h"
+#include "WasmPlan.h"
+#include <wtf/RefPtr.h>
+
+using namespace JSC;
+
+#if ENABLE(WEBASSEMBLY)
+
+// Two functions of type (i32, i32) -> i32, followed by a custom section after the Code section.
+static const uint8_t wasmModule[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x0d, 0x00, 0x00, 0x00, // Magic number and version.
+    0x01, 0x07, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, // Type section.
+    0x03, 0x03, 0x02, 0x00, 0x00, // Function section.
+    0x0a, 0x0e, 0x02, // Code section.
+    0x07, 0x00, 0x20, 0x00, 0x20, 0x01, 0x6a, 0x0b, // get_local 0, get_local 1, i32.add.
+    0x04, 0x00, 0x41, 0x2a, 0x0b, // i32.const 42.
+    0x00, 0x05, 0x04, 0x74, 0x65, 0x73, 0x74, // Custom section named "test".
+};
+
+static bool compileStreaming(VM& vm, const uint8_t* bytes, size_t length, size_t chunkSize, String& errorMessage)
+{
+    Wasm::Plan plan(&vm);
+    for (size_t offset = 0; offset < length; offset += chunkSize)
+        plan.appendBytes(bytes + offset, std::min(chunkSize, length - offset));
+    plan.finishStreaming();
+    errorMessage = plan.errorMessage();
+    return !plan.failed() && plan.internalFunctionCount() == 2;
+}
+
+int testWasmStreaming()
+{
+    if (!Options::useWebAssembly()) {
+        printf("PASS: Wasm streaming test (skipped, WebAssembly is disabled).\n");
+        return 0;
+    }
+
+    bool failed = false;
+    RefPtr<VM> vm = VM::create();
+    {
+        JSLockHolder locker(vm.get());
+        String errorMessage;
+
+        // Every chunk boundary has to work, including ones inside LEB128 numbers and function bodies.
+        for (size_t chunkSize : { sizeof(wasmModule), static_cast<size_t>(1), static_cast<size_t>(3), static_cast<size_t>(9) }) {
+            if (!compileStreaming(*vm, wasmModule, sizeof(wasmModule), chunkSize, errorMessage)) {
+                printf("FAIL: Wasm streaming of a valid module in %zu byte chunks: %s\n", chunkSize, errorMessage.utf8().data());
+                failed = true;
+            }
+        }
+
+        // A module that stops inside the Code section or the custom section is rejected.
+        for (size_t length : { static_cast<size_t>(25), static_cast<size_t>(35), sizeof(wasmModule) - 1 }) {
+            if (compileStreaming(*vm, wasmModule, length, 1, errorMessage) || errorMessage.isNull()) {
+                printf("FAIL: Wasm streaming accepted a module truncated to %zu bytes.\n", length);
+                failed = true;
+            }
+        }
+
+        // So is a function body that does not validate.
+        Vector<uint8_t> invalidModule;
+        invalidModule.append(wasmModule, sizeof(wasmModule));
+        invalidModule[31] = 0x7c; // i32.add becomes i64.add.
+        if (compileStreaming(*vm, invalidModule.data(), invalidModule.size(), 4, errorMessage) || errorMessage.isNull()) {
+            printf("FAIL: Wasm streaming accepted a function that does not validate.\n");
+            failed = true;
+        }
+    }
+    vm = nullptr;
+
+    if (!failed)
+        printf("PASS: Wasm streaming test.\n");
+    return failed;
+}
+
+#else
+
+int testWasmStreaming()
+{
+    printf("PASS: Wasm streaming test (skipped, WebAssembly is not enabled).\n");
+    return 0;
+}
+
+#endif // ENABLE(WEBASSEMBLY)
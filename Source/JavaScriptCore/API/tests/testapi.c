@@ -32,14 +32,21 @@
 #include "JSScriptRefPrivate.h"
 #include "JSStringRefPrivate.h"
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #define ASSERT_DISABLED 0
 #include <wtf/Assertions.h>
 
 #if OS(WINDOWS)
 #include <windows.h>
+#else
+#include <unistd.h>
 #endif
 
+#include "BytecodeCacheTest.h"
 #include "CompareAndSwapTest.h"
+#include "ConcurrentSweepingTest.h"
 #include "CustomGlobalObjectClassTest.h"
 #include "ExecutionTimeLimitTest.h"
 #include "FunctionOverridesTest.h"
@@ -47,6 +54,8 @@
 #include "JSONParseTest.h"
 #include "PingPongStackOverflowTest.h"
 #include "TypedArrayCTest.h"
+#include "WasmExecutionTest.h"
+#include "WasmStreamingTest.h"
 
 #if JSC_OBJC_API_ENABLED
 void testObjectiveCAPI(void);
@@ -1107,6 +1116,61 @@ static bool globalContextNameTest()
     return result;
 }
 
+#if ENABLE(SAMPLING_PROFILER) && !OS(WINDOWS)
+static bool fileContains(const char* path, const char* string)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* contents = (char*)malloc(size + 1);
+    size_t length = fread(contents, 1, size, file);
+    contents[length] = '\0';
+    fclose(file);
+
+    bool result = strstr(contents, string);
+    free(contents);
+    return result;
+}
+#endif
+
+static bool samplingProfilerTest()
+{
+    bool result = true;
+    char path[] = "/tmp/testapi-sampling-profile-XXXXXX";
+
+    JSGlobalContextRef unsampledContext = JSGlobalContextCreate(0);
+    result &= assertTrue(!JSGlobalContextWriteSamplingProfile(unsampledContext, path), "Sampling profile written for a context that was not sampled");
+    JSGlobalContextRelease(unsampledContext);
+
+    JSGlobalContextRef context = JSGlobalContextCreate(0);
+    JSGlobalContextStartSamplingProfiler(context);
+
+    JSStringRef script = JSStringCreateWithUTF8CString("function sampledFunction(n) { var sum = 0; for (var i = 0; i < n; ++i) sum += Math.sqrt(i); return sum; } var start = Date.now(); while (Date.now() - start < 100) sampledFunction(10000);");
+    JSEvaluateScript(context, script, NULL, NULL, 1, NULL);
+    JSStringRelease(script);
+
+#if !ENABLE(SAMPLING_PROFILER)
+    result &= assertTrue(!JSGlobalContextWriteSamplingProfile(context, path), "Sampling profile written without the sampling profiler");
+#elif !OS(WINDOWS)
+    int fd = mkstemp(path);
+    result &= assertTrue(fd != -1, "Could not create a file for the sampling profile");
+    if (fd != -1) {
+        close(fd);
+        result &= assertTrue(JSGlobalContextWriteSamplingProfile(context, path), "Sampling profile was not written");
+        result &= assertTrue(fileContains(path, "sampledFunction"), "Sampling profile does not contain the sampled function");
+        unlink(path);
+    }
+#endif
+
+    JSGlobalContextRelease(context);
+    return result;
+}
+
 static void checkConstnessInJSObjectNames()
 {
     JSStaticFunction fun;
@@ -1889,6 +1953,10 @@ int main(int argc, char* argv[])
     failed = testGlobalContextWithFinalizer() || failed;
     failed = testPingPongStackOverflow() || failed;
     failed = testJSONParse() || failed;
+    failed = testWasmStreaming() || failed;
+    failed = testWasmExecution() || failed;
+    failed = testBytecodeCache() || failed;
+    failed = testConcurrentSweeping() || failed;
 
     // Clear out local variables pointing at JSObjectRefs to allow their values to be collected
     function = NULL;
@@ -1937,6 +2005,13 @@ int main(int argc, char* argv[])
     if (globalContextNameTest())
         printf("PASS: global context name behaves as expected.\n");
 
+    if (samplingProfilerTest())
+        printf("PASS: sampling profiles are written for sampled contexts.\n");
+    else {
+        printf("FAIL: sampling profiles are not written as expected.\n");
+        failed = true;
+    }
+
     customGlobalObjectClassTest();
     globalObjectSetPrototypeTest();
     globalObjectPrivatePropertyTest();
@@ -303,5 +303,87 @@ for (var i = 0; i < 6; ++i)
     var z = PropertyCatchalls.z;
 shouldBe("z", null);
 
+// Reading from a rope without resolving it has to keep working after one of its inner
+// fibers was resolved and the strings it was built from were collected.
+function freshString(characters)
+{
+    return characters.split("").join("");
+}
+
+var innerRope = freshString("abcdefghij") + freshString("klmnopqrst");
+var outerRope = innerRope + freshString("uvwxyz");
+shouldBe("outerRope[3]", "d");
+shouldBe("outerRope.charAt(12)", "m");
+innerRope.indexOf("z");
+innerRope = null;
+gc();
+shouldBe("outerRope[4]", "e");
+shouldBe("outerRope.charCodeAt(13)", 110);
+shouldBe("outerRope.startsWith('klm', 10)", true);
+shouldBe("outerRope.endsWith('uvwxyz')", true);
+shouldBe("outerRope.substring(2, 5)", "cde");
+
+var slicedFiber = freshString("0123456789").substring(2, 8);
+var ropeWithSlice = freshString("ab") + (slicedFiber + freshString("cd"));
+shouldBe("ropeWithSlice[3]", "3");
+slicedFiber.indexOf("x");
+slicedFiber = null;
+gc();
+shouldBe("ropeWithSlice[4]", "4");
+shouldBe("ropeWithSlice.charCodeAt(7)", 55);
+shouldBe("ropeWithSlice.substring(8)", "cd");
+shouldBe("ropeWithSlice", "ab234567cd");
+
+// Reading every character of a rope built with += walks it only until resolving would have been
+// cheaper, then resolves it once. The results must be the same either way.
+var flatString = "";
+for (var i = 0; i < 4096; ++i)
+    flatString += String.fromCharCode(32 + i % 90);
+var appendedRope = "";
+for (var i = 0; i < flatString.length; i += 64)
+    appendedRope += freshString(flatString.substring(i, i + 64));
+var charCodesMatch = true;
+for (var pass = 0; pass < 2; ++pass) {
+    for (var i = appendedRope.length - 1; i >= 0; --i) {
+        if (appendedRope.charCodeAt(i) !== flatString.charCodeAt(i) || appendedRope[i] !== flatString[i])
+            charCodesMatch = false;
+    }
+}
+shouldBe("charCodesMatch", true);
+shouldBe("appendedRope === flatString", true);
+
+// JSON.parse sizes objects from earlier objects that started with the same property name,
+// which must not change what they contain when their shapes differ.
+var mixedObjects = JSON.parse('[{"id":1,"a":1,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7,"h":8},{"id":2},{"id":3,"z":0},{"id":4,"a":1,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7,"h":8,"i":9}]');
+shouldBe("JSON.stringify(mixedObjects.map(Object.keys))", '[["id","a","b","c","d","e","f","g","h"],["id"],["id","z"],["id","a","b","c","d","e","f","g","h","i"]]');
+shouldBe("mixedObjects[3].i + mixedObjects[2].z + mixedObjects[1].id", 11);
+
+// Back references are compiled by the RegExp JIT when they are case sensitive and
+// unquantified; the other forms run in the interpreter. Both have to agree.
+function execResult(regExp, string)
+{
+    return JSON.stringify(regExp.exec(string));
+}
+
+shouldBe("execResult(/(a|b)\\1/, 'xabba')", '["bb","b"]');
+shouldBe("execResult(/(\\w+)\\s*=\\s*([\"'])(.*?)\\2/, 'key = \"it\\'s\" rest')", '["key = \\"it\'s\\"","key","\\"","it\'s"]');
+shouldBe("execResult(/(ab)\\1/, 'aba')", "null");
+shouldBe("execResult(/(ab)\\1|aba/, 'abac')", '["aba",null]');
+shouldBe("execResult(/(a)?b\\1/, 'b')", '["b",null]');
+shouldBe("execResult(/(a)?b\\1/, 'abab')", '["aba","a"]');
+shouldBe("execResult(/(a)?b\\1c/, 'abc')", '["bc",null]');
+shouldBe("execResult(/(a)??b\\1/, 'aba')", '["aba","a"]');
+shouldBe("execResult(/(?:(a)|b)c\\1/, 'bca')", '["bc",null]');
+shouldBe("execResult(/(a\\1)/, 'aa')", '["a","a"]');
+shouldBe("execResult(/\\1(a)/, 'a')", '["a","a"]');
+shouldBe("/(\\u0101.)\\1/.exec('x\\u0101b\\u0101b').index", 1);
+shouldBe("/(\\u0101.)\\1/.exec('x\\u0101b\\u0101b')[1]", "\u0101b");
+shouldBe("/(\\d)\\1/.test('1231')", false);
+shouldBe("/(\\d)\\1/.test('12331')", true);
+shouldBe("'a-aa-b'.replace(/(\\w)-\\1/g, '$1')", "aa-b");
+shouldBe("execResult(/(a)\\1/i, 'xaA')", '["aA","a"]');
+shouldBe("execResult(/(ab)\\1+/, 'ababababx')", '["abababab","ab"]');
+shouldBe("execResult(/(a)*b\\1/, 'aaba')", '["aaba","a"]');
+
 if (failed)
     throw "Some tests failed";
@@ -271,6 +271,11 @@ public:
 
     RefPtr<WasmBoundsCheckGenerator> wasmBoundsCheckGenerator() const { return m_wasmBoundsCheckGenerator; }
 
+    // Makes prepareForGeneration() spill every Tmp instead of running the register allocator, for
+    // clients that care more about compile time than code quality.
+    void setShouldSpillEverything(bool shouldSpillEverything) { m_shouldSpillEverything = shouldSpillEverything; }
+    bool shouldSpillEverything() const { return m_shouldSpillEverything; }
+
     // This is a hash of the code. You can use this if you want to put code into a hashtable, but
     // it's mainly for validating the results from JSAir.
     unsigned jsHash() const;
@@ -309,6 +314,7 @@ private:
     Vector<FrequentedBlock> m_entrypoints; // This is empty until after lowerEntrySwitch().
     Vector<CCallHelpers::Label> m_entrypointLabels; // This is empty until code generation.
     RefPtr<WasmBoundsCheckGenerator> m_wasmBoundsCheckGenerator;
+    bool m_shouldSpillEverything { false };
     const char* m_lastPhaseName;
 };
 
@@ -86,7 +86,8 @@ void prepareForGeneration(Code& code)
     // After this phase, every Tmp has a reg.
     //
     // For debugging, you can use spillEverything() to put everything to the stack between each Inst.
-    if (Options::airSpillsEverything())
+    // Clients that care more about compile time than code quality can ask for it too.
+    if (Options::airSpillsEverything() || code.shouldSpillEverything())
         spillEverything(code);
     else
         iteratedRegisterCoalescing(code);
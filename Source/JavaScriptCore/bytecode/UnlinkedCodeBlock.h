@@ -390,6 +390,8 @@ protected:
     }
 
 private:
+    friend class BytecodeCacheDecoder;
+    friend class BytecodeCacheEncoder;
     friend class BytecodeRewriter;
     void applyModification(BytecodeRewriter&);
 
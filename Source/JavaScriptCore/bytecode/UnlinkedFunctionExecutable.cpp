@@ -26,6 +26,7 @@
 #include "config.h"
 #include "UnlinkedFunctionExecutable.h"
 
+#include "BytecodeCache.h"
 #include "BytecodeGenerator.h"
 #include "ClassInfo.h"
 #include "CodeCache.h"
@@ -206,13 +207,23 @@ UnlinkedFunctionCodeBlock* UnlinkedFunctionExecutable::unlinkedCodeBlockFor(
         break;
     }
 
-    UnlinkedFunctionCodeBlock* result = generateUnlinkedFunctionCodeBlock(
-        vm, this, source, specializationKind, debuggerMode, 
-        isBuiltinFunction() ? UnlinkedBuiltinFunction : UnlinkedNormalFunction, 
-        error, parseMode);
+    UnlinkedFunctionCodeBlock* result = nullptr;
+    unsigned cachedOffset = specializationKind == CodeForCall ? m_cachedCodeBlockForCallOffset : m_cachedCodeBlockForConstructOffset;
+    if (cachedOffset && !Options::functionOverrides()) {
+        result = decodeFunctionCodeBlockFromBytecodeCache(vm, *m_cachedBytecode, cachedOffset, source);
+        if (result && (result->wasCompiledWithDebuggingOpcodes() != (debuggerMode == DebuggerOn) || result->parseMode() != parseMode))
+            result = nullptr;
+    }
+
+    if (!result) {
+        result = generateUnlinkedFunctionCodeBlock(
+            vm, this, source, specializationKind, debuggerMode, 
+            isBuiltinFunction() ? UnlinkedBuiltinFunction : UnlinkedNormalFunction, 
+            error, parseMode);
     
-    if (error.isValid())
-        return nullptr;
+        if (error.isValid())
+            return nullptr;
+    }
 
     switch (specializationKind) {
     case CodeForCall:
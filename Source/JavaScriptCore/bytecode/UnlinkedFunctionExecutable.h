@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "BytecodeCache.h"
 #include "BytecodeConventions.h"
 #include "CodeSpecializationKind.h"
 #include "CodeType.h"
@@ -58,6 +59,8 @@ enum UnlinkedFunctionKind {
 
 class UnlinkedFunctionExecutable final : public JSCell {
 public:
+    friend class BytecodeCacheDecoder;
+    friend class BytecodeCacheEncoder;
     friend class CodeCache;
     friend class VM;
 
@@ -146,6 +149,11 @@ public:
 
 private:
     UnlinkedFunctionExecutable(VM*, Structure*, const SourceCode&, SourceCode&& parentSourceOverride, FunctionMetadataNode*, UnlinkedFunctionKind, ConstructAbility, JSParserScriptMode, VariableEnvironment&,  JSC::DerivedContextType);
+    // Used by the bytecode cache, which fills in the fields itself.
+    UnlinkedFunctionExecutable(VM* vm, Structure* structure)
+        : Base(*vm, structure)
+    {
+    }
 
     unsigned m_firstLineOffset;
     unsigned m_lineCount;
@@ -184,6 +192,11 @@ private:
 
     VariableEnvironment m_parentScopeTDZVariables;
 
+    // Code blocks that are still encoded in a bytecode cache file; see BytecodeCache.h.
+    RefPtr<BytecodeCacheFile> m_cachedBytecode;
+    unsigned m_cachedCodeBlockForCallOffset { 0 };
+    unsigned m_cachedCodeBlockForConstructOffset { 0 };
+
 protected:
     static void visitChildren(JSCell*, SlotVisitor&);
 
@@ -36,10 +36,18 @@ class UnlinkedInstructionStream {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     explicit UnlinkedInstructionStream(const Vector<UnlinkedInstruction, 0, UnsafeVectorOverflow>&);
+    UnlinkedInstructionStream(RefCountedArray<unsigned char>&& data, unsigned instructionCount)
+        : m_data(WTFMove(data))
+        , m_instructionCount(instructionCount)
+    {
+    }
 
     unsigned count() const { return m_instructionCount; }
     size_t sizeInBytes() const;
 
+    // The packed stream, as described below. Used by the bytecode cache.
+    const RefCountedArray<unsigned char>& data() const { return m_data; }
+
     class Reader {
     public:
         explicit Reader(const UnlinkedInstructionStream&);
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AuxiliaryEvacuator.h"
+
+#include "ConservativeRoots.h"
+#include "Heap.h"
+#include "JSCInlines.h"
+#include "LargeAllocation.h"
+#include "MarkedAllocatorInlines.h"
+#include "MarkedBlockInlines.h"
+#include "MarkedSpaceInlines.h"
+#include <wtf/HashMap.h>
+
+namespace JSC {
+
+namespace {
+
+struct Relocation {
+    JSObject* owner;
+    HeapCell* cell;
+};
+
+struct Source {
+    MarkedBlock::Handle* block;
+    size_t liveCells;
+    Vector<Relocation> relocations;
+    bool isPinned { false };
+};
+
+// Hands out the dead cells of the destination blocks of one allocator, in order. Marking a cell
+// that we copy into is all it takes to make it live, since these blocks have up-to-date marks and
+// no newly allocated bits.
+class DestinationCursor {
+public:
+    void addBlock(MarkedBlock::Handle* block) { m_blocks.append(block); }
+    
+    HeapCell* takeCell()
+    {
+        while (m_freeCellIndex >= m_freeCells.size()) {
+            if (m_blockIndex >= m_blocks.size())
+                return nullptr;
+            MarkedBlock::Handle* block = m_blocks[m_blockIndex++];
+            m_freeCells.resize(0);
+            m_freeCellIndex = 0;
+            block->forEachCell(
+                [&] (HeapCell* cell, HeapCell::Kind) -> IterationStatus {
+                    if (!block->block().isMarkedRaw(cell))
+                        m_freeCells.append(cell);
+                    return IterationStatus::Continue;
+                });
+        }
+        return m_freeCells[m_freeCellIndex++];
+    }
+
+private:
+    Vector<MarkedBlock::Handle*> m_blocks;
+    size_t m_blockIndex { 0 };
+    Vector<HeapCell*> m_freeCells;
+    size_t m_freeCellIndex { 0 };
+};
+
+} // anonymous namespace
+
+AuxiliaryEvacuator::AuxiliaryEvacuator(Heap& heap)
+    : m_heap(heap)
+{
+}
+
+AuxiliaryEvacuator::~AuxiliaryEvacuator()
+{
+}
+
+void AuxiliaryEvacuator::beginCollection(CollectionScope scope)
+{
+    auto locker = holdLock(m_lock);
+    m_isActive = scope == CollectionScope::Full;
+    m_pinnedCells.clear();
+    m_pinnedBlocks.clear();
+    m_blocksEvacuatedLastCollection = 0;
+    m_bytesEvacuatedLastCollection = 0;
+}
+
+void AuxiliaryEvacuator::didGatherConservativeRoots(ConservativeRoots& roots)
+{
+    auto locker = holdLock(m_lock);
+    if (!m_isActive)
+        return;
+    
+    HeapCell** rootsArray = roots.roots();
+    for (size_t i = 0; i < roots.size(); ++i) {
+        HeapCell* cell = rootsArray[i];
+        m_pinnedCells.add(cell);
+        if (cell->cellKind() == HeapCell::Auxiliary && !cell->isLargeAllocation())
+            m_pinnedBlocks.add(&cell->markedBlock());
+    }
+}
+
+void AuxiliaryEvacuator::evacuate()
+{
+    auto locker = holdLock(m_lock);
+    if (!m_isActive)
+        return;
+    m_isActive = false;
+    
+    MarkedSpace& objectSpace = m_heap.objectSpace();
+    RELEASE_ASSERT(!objectSpace.isMarking());
+    
+    // First pick the blocks to evacuate. In each auxiliary size class we take the sparsest blocks
+    // for as long as the other blocks of that size class have enough dead cells to take their
+    // live cells.
+    Vector<Source> sources;
+    HashMap<MarkedBlock*, size_t> sourceIndices;
+    HashMap<MarkedAllocator*, DestinationCursor> destinations;
+    
+    size_t budget = Options::maximumAuxiliaryBlocksToEvacuatePerCollection();
+    double threshold = Options::auxiliaryEvacuationOccupancyThreshold();
+    
+    for (MarkedAllocator* allocator = objectSpace.firstAllocator(); allocator && budget; allocator = allocator->nextAllocator()) {
+        if (allocator->cellKind() != HeapCell::Auxiliary || allocator->needsDestruction())
+            continue;
+        
+        Vector<std::pair<size_t, MarkedBlock::Handle*>> candidates;
+        Vector<MarkedBlock::Handle*> fullerBlocks;
+        size_t availableCells = 0;
+        allocator->forEachNotEmptyBlock(
+            [&] (MarkedBlock::Handle* block) {
+                if (block->isFreeListed() || block->hasAnyNewlyAllocated())
+                    return;
+                MarkedBlock& markedBlock = block->block();
+                if (markedBlock.areMarksStale())
+                    return;
+                size_t capacity = block->cellsPerBlock();
+                size_t liveCells = markedBlock.m_marks.count();
+                if (!liveCells || liveCells >= capacity)
+                    return;
+                availableCells += capacity - liveCells;
+                if (liveCells <= capacity * threshold && !m_pinnedBlocks.contains(&markedBlock))
+                    candidates.append(std::make_pair(liveCells, block));
+                else
+                    fullerBlocks.append(block);
+            });
+        
+        std::sort(
+            candidates.begin(), candidates.end(),
+            [] (const std::pair<size_t, MarkedBlock::Handle*>& a, const std::pair<size_t, MarkedBlock::Handle*>& b) -> bool {
+                return a.first < b.first;
+            });
+        
+        size_t cellsToMove = 0;
+        size_t numSources = 0;
+        for (auto& candidate : candidates) {
+            if (!budget)
+                break;
+            size_t capacity = candidate.second->cellsPerBlock();
+            // Once a block is a source, its dead cells can no longer be used as destinations.
+            if (cellsToMove + candidate.first > availableCells - (capacity - candidate.first))
+                break;
+            availableCells -= capacity - candidate.first;
+            cellsToMove += candidate.first;
+            sourceIndices.add(&candidate.second->block(), sources.size());
+            sources.append(Source { candidate.second, candidate.first, { }, false });
+            numSources++;
+            budget--;
+        }
+        
+        if (!numSources)
+            continue;
+        
+        DestinationCursor& cursor = destinations.add(allocator, DestinationCursor()).iterator->value;
+        for (size_t i = numSources; i < candidates.size(); ++i)
+            cursor.addBlock(candidates[i].second);
+        for (MarkedBlock::Handle* block : fullerBlocks)
+            cursor.addBlock(block);
+    }
+    
+    if (sources.isEmpty())
+        return;
+    
+    // Now find the owners. Butterflies are only ever pointed to by their owner, but we must find
+    // every one of them before we can move anything.
+    auto visitCell = [&] (HeapCell* heapCell, HeapCell::Kind kind) -> IterationStatus {
+        if (kind != HeapCell::JSCell)
+            return IterationStatus::Continue;
+        JSCell* cell = static_cast<JSCell*>(heapCell);
+        if (!cell->isObject())
+            return IterationStatus::Continue;
+        JSObject* object = asObject(cell);
+        Butterfly* butterfly = object->butterfly();
+        if (!butterfly)
+            return IterationStatus::Continue;
+        
+        // The butterfly may point one past the end of its allocation, so look at the byte before.
+        char* pointer = bitwise_cast<char*>(butterfly) - 1;
+        auto iter = sourceIndices.find(MarkedBlock::blockFor(pointer));
+        if (iter == sourceIndices.end())
+            return IterationStatus::Continue;
+        
+        Source& source = sources[iter->value];
+        if (m_pinnedCells.contains(object)) {
+            source.isPinned = true;
+            return IterationStatus::Continue;
+        }
+        HeapCell* auxiliary = bitwise_cast<HeapCell*>(source.block->cellAlign(pointer));
+        source.relocations.append(Relocation { object, auxiliary });
+        return IterationStatus::Continue;
+    };
+    for (MarkedBlock* block : objectSpace.blocks().set())
+        block->handle().forEachLiveCell(visitCell);
+    for (LargeAllocation* allocation : objectSpace.largeAllocations()) {
+        if (allocation->isLive())
+            visitCell(allocation->cell(), allocation->attributes().cellKind);
+    }
+    
+    for (Source& source : sources) {
+        if (source.isPinned || source.relocations.size() != source.liveCells)
+            continue;
+        
+        // Make sure that we found exactly the live cells of the block, once each.
+        HashSet<HeapCell*> cells;
+        bool isExact = true;
+        for (const Relocation& relocation : source.relocations) {
+            if (!source.block->block().isMarkedRaw(relocation.cell) || !cells.add(relocation.cell).isNewEntry) {
+                isExact = false;
+                break;
+            }
+        }
+        if (!isExact)
+            continue;
+        
+        MarkedAllocator* allocator = source.block->allocator();
+        DestinationCursor& cursor = destinations.find(allocator)->value;
+        size_t cellSize = source.block->cellSize();
+        
+        for (const Relocation& relocation : source.relocations) {
+            HeapCell* destination = cursor.takeCell();
+            RELEASE_ASSERT(destination);
+            memcpy(destination, relocation.cell, cellSize);
+            destination->markedBlock().testAndSetMarked(destination);
+            
+            Butterfly* butterfly = relocation.owner->butterfly();
+            ptrdiff_t offset = bitwise_cast<char*>(butterfly) - bitwise_cast<char*>(relocation.cell);
+            relocation.owner->m_butterfly.setWithoutBarrier(bitwise_cast<Butterfly*>(bitwise_cast<char*>(destination) + offset));
+        }
+        
+        // The block is now empty. Tell the allocator, so that the sweeper will free it.
+        MarkedBlock& markedBlock = source.block->block();
+        markedBlock.m_marks.clearAll();
+        markedBlock.clearHasAnyMarked();
+        {
+            auto bitvectorLocker = holdLock(allocator->bitvectorLock());
+            allocator->setIsMarkingNotEmpty(bitvectorLocker, source.block, false);
+            allocator->setIsCanAllocateButNotEmpty(bitvectorLocker, source.block, false);
+            allocator->setIsEmpty(bitvectorLocker, source.block, true);
+        }
+        
+        m_blocksEvacuatedLastCollection++;
+        m_bytesEvacuatedLastCollection += source.relocations.size() * cellSize;
+    }
+    
+    m_totalBlocksEvacuated += m_blocksEvacuatedLastCollection;
+    m_totalBytesEvacuated += m_bytesEvacuatedLastCollection;
+    
+    if (Options::logGC())
+        dataLog("Evac: ", m_blocksEvacuatedLastCollection, "/", sources.size(), " blocks, ", m_bytesEvacuatedLastCollection / 1024, "kb ");
+}
+
+} // namespace JSC
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include "CollectionScope.h"
+#include <wtf/HashSet.h>
+#include <wtf/Lock.h>
+
+namespace JSC {
+
+class ConservativeRoots;
+class Heap;
+class HeapCell;
+class MarkedBlock;
+
+// The AuxiliaryEvacuator defragments the auxiliary space by moving butterflies out of sparsely
+// occupied MarkedBlocks, so that those blocks become empty and can be given back by the sweeper.
+// It runs at the end of full collections, while the world is still stopped, after marking has
+// told us exactly which auxiliary cells are live.
+//
+// A block is only evacuated if every live cell in it is the butterfly of some live object that
+// we found, and if nothing in the block nor any of those owners was found by the conservative
+// scan. We don't know who else might be holding on to a conservatively referenced cell. Each
+// butterfly is copied into a dead cell of a fuller block of the same size class, and its owner is
+// pointed at the copy. No more than Options::maximumAuxiliaryBlocksToEvacuatePerCollection()
+// blocks are evacuated per collection, so that the work is spread across collections.
+class AuxiliaryEvacuator {
+    WTF_MAKE_NONCOPYABLE(AuxiliaryEvacuator);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    AuxiliaryEvacuator(Heap&);
+    ~AuxiliaryEvacuator();
+    
+    void beginCollection(CollectionScope);
+    
+    // This may be called more than once per collection, since the conservative scan is redone
+    // every time we reach a fixpoint.
+    void didGatherConservativeRoots(ConservativeRoots&);
+    
+    // Must be called with the world stopped, after Heap::endMarking().
+    void evacuate();
+    
+    size_t blocksEvacuatedLastCollection() const { return m_blocksEvacuatedLastCollection; }
+    size_t bytesEvacuatedLastCollection() const { return m_bytesEvacuatedLastCollection; }
+    size_t totalBlocksEvacuated() const { return m_totalBlocksEvacuated; }
+    size_t totalBytesEvacuated() const { return m_totalBytesEvacuated; }
+
+private:
+    Heap& m_heap;
+    
+    Lock m_lock;
+    bool m_isActive { false };
+    HashSet<HeapCell*> m_pinnedCells;
+    HashSet<MarkedBlock*> m_pinnedBlocks;
+    
+    size_t m_blocksEvacuatedLastCollection { 0 };
+    size_t m_bytesEvacuatedLastCollection { 0 };
+    size_t m_totalBlocksEvacuated { 0 };
+    size_t m_totalBytesEvacuated { 0 };
+};
+
+} // namespace JSC
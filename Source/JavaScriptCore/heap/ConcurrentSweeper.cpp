@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ConcurrentSweeper.h"
+
+#include "Heap.h"
+#include "MarkedAllocator.h"
+#include "MarkedSpace.h"
+#include <wtf/MainThread.h>
+
+namespace JSC {
+
+class ConcurrentSweeper::Thread : public AutomaticThread {
+public:
+    Thread(const AbstractLocker& locker, ConcurrentSweeper& sweeper)
+        : AutomaticThread(locker, sweeper.m_lock, sweeper.m_condition)
+        , m_sweeper(sweeper)
+    {
+    }
+    
+protected:
+    PollResult poll(const AbstractLocker&) override
+    {
+        if (m_sweeper.m_shouldStop)
+            return PollResult::Stop;
+        if (m_sweeper.m_isSweeping)
+            return PollResult::Work;
+        return PollResult::Wait;
+    }
+    
+    WorkResult work() override
+    {
+        // We hold the lock for the duration of one block, so that stopSweeping() only has to wait
+        // for that one block to finish.
+        auto locker = holdLock(*m_sweeper.m_lock);
+        if (!m_sweeper.m_isSweeping)
+            return WorkResult::Continue;
+        if (!m_sweeper.sweepNextBlock(locker))
+            m_sweeper.m_isSweeping = false;
+        return WorkResult::Continue;
+    }
+    
+    void threadDidStart() override
+    {
+        WTF::registerGCThread(GCThreadType::Helper);
+    }
+
+private:
+    ConcurrentSweeper& m_sweeper;
+};
+
+ConcurrentSweeper::ConcurrentSweeper(Heap& heap)
+    : m_heap(heap)
+    , m_lock(Box<Lock>::create())
+    , m_condition(AutomaticThreadCondition::create())
+{
+    LockHolder locker(*m_lock);
+    m_thread = adoptRef(new Thread(locker, *this));
+}
+
+ConcurrentSweeper::~ConcurrentSweeper()
+{
+    shutdown();
+}
+
+void ConcurrentSweeper::startSweeping()
+{
+    LockHolder locker(*m_lock);
+    if (m_shouldStop)
+        return;
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_isSweeping = true;
+    m_currentAllocator = m_heap.objectSpace().firstAllocator();
+    m_blockCursor = 0;
+    m_condition->notifyOne(locker);
+}
+
+void ConcurrentSweeper::stopSweeping()
+{
+    // Taking the lock means that the thread is not in the middle of a block. Bumping the epoch
+    // invalidates whatever free lists the mutator has not consumed yet, since the collector is
+    // about to change the mark bits they were computed from.
+    LockHolder locker(*m_lock);
+    m_isSweeping = false;
+    m_epoch.fetch_add(1, std::memory_order_release);
+    m_currentAllocator = nullptr;
+}
+
+void ConcurrentSweeper::shutdown()
+{
+    bool stopped = false;
+    {
+        LockHolder locker(*m_lock);
+        if (m_shouldStop)
+            return;
+        m_isSweeping = false;
+        m_currentAllocator = nullptr;
+        stopped = m_thread->tryStop(locker);
+        m_shouldStop = true;
+        if (!stopped)
+            m_condition->notifyOne(locker);
+    }
+    if (!stopped)
+        m_thread->join();
+}
+
+bool ConcurrentSweeper::sweepNextBlock(const AbstractLocker&)
+{
+    for (; m_currentAllocator; m_currentAllocator = m_currentAllocator->nextAllocator(), m_blockCursor = 0) {
+        if (m_currentAllocator->needsDestruction())
+            continue;
+        
+        while (MarkedBlock::Handle* block = m_currentAllocator->findBlockToSweepConcurrently(m_blockCursor)) {
+            // Only startSweeping() and stopSweeping() change the epoch, and they hold m_lock too.
+            if (block->sweepConcurrently(m_epoch.load(std::memory_order_relaxed)))
+                return true;
+        }
+    }
+    return false;
+}
+
+} // namespace JSC
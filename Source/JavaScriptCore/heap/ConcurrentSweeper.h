@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#include <atomic>
+#include <wtf/AutomaticThread.h>
+#include <wtf/Box.h>
+#include <wtf/Lock.h>
+
+namespace JSC {
+
+class Heap;
+class MarkedAllocator;
+
+// The ConcurrentSweeper builds free lists for blocks that have no destructors on a helper thread,
+// while the mutator runs. It only considers blocks that are neither empty nor retired, since those
+// are the ones the mutator would otherwise have to sweep cell-by-cell when it first allocates in
+// them. Blocks that need destruction are left to the IncrementalSweeper, since destructors must
+// run on the mutator.
+//
+// The mutator and the helper agree on who sweeps a block using the block's lock and a sweep
+// epoch, see MarkedBlock::Handle::sweepConcurrently(). The epoch is bumped whenever we stop, so
+// anything built before a collection is never handed out after it.
+class ConcurrentSweeper {
+    WTF_MAKE_NONCOPYABLE(ConcurrentSweeper);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    ConcurrentSweeper(Heap&);
+    ~ConcurrentSweeper();
+
+    // Called at the end of a collection, after the heap has been prepared for allocation.
+    void startSweeping();
+    
+    // Called before marking begins. Waits for the block that is currently being swept, if any.
+    void stopSweeping();
+    
+    // Stops the helper thread for good. Called when the heap is shutting down.
+    void shutdown();
+    
+    // The mutator reads this without holding m_lock when it takes a block's free list. The
+    // acquire pairs with the release in startSweeping() and stopSweeping().
+    unsigned epoch() const { return m_epoch.load(std::memory_order_acquire); }
+
+private:
+    class Thread;
+    friend class Thread;
+    
+    bool sweepNextBlock(const AbstractLocker&);
+    
+    Heap& m_heap;
+    Box<Lock> m_lock;
+    RefPtr<AutomaticThreadCondition> m_condition;
+    RefPtr<AutomaticThread> m_thread;
+    
+    bool m_isSweeping { false };
+    bool m_shouldStop { false };
+    std::atomic<unsigned> m_epoch { 1 };
+    MarkedAllocator* m_currentAllocator { nullptr };
+    size_t m_blockCursor { 0 };
+};
+
+} // namespace JSC
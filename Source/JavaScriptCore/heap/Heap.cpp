@@ -21,9 +21,11 @@
 #include "config.h"
 #include "Heap.h"
 
+#include "AuxiliaryEvacuator.h"
 #include "CodeBlock.h"
 #include "CodeBlockSetInlines.h"
 #include "CollectingScope.h"
+#include "ConcurrentSweeper.h"
 #include "ConservativeRoots.h"
 #include "DFGWorklistInlines.h"
 #include "EdenGCActivityCallback.h"
@@ -306,6 +308,12 @@ Heap::Heap(VM* vm, HeapType heapType)
     if (Options::verifyHeap())
         m_verifier = std::make_unique<HeapVerifier>(this, Options::numberOfGCCyclesToRecordForVerification());
     
+    if (Options::useConcurrentSweeping())
+        m_concurrentSweeper = std::make_unique<ConcurrentSweeper>(*this);
+    
+    if (Options::useAuxiliaryEvacuation())
+        m_auxiliaryEvacuator = std::make_unique<AuxiliaryEvacuator>(*this);
+    
     m_collectorSlotVisitor->optimizeForStoppedMutator();
 
     LockHolder locker(*m_threadLock);
@@ -405,6 +413,9 @@ void Heap::lastChanceToFinalize()
     if (!stopped)
         m_thread->join();
     
+    if (m_concurrentSweeper)
+        m_concurrentSweeper->shutdown();
+    
     if (Options::logGC())
         dataLog("5 ");
     
@@ -1118,6 +1129,12 @@ NEVER_INLINE bool Heap::runBeginPhase(GCConductor conn)
         m_verifier->gatherLiveObjects(HeapVerifier::Phase::BeforeMarking);
     }
         
+    if (m_concurrentSweeper)
+        m_concurrentSweeper->stopSweeping();
+    
+    if (m_auxiliaryEvacuator)
+        m_auxiliaryEvacuator->beginCollection(*m_collectionScope);
+    
     prepareForMarking();
         
     if (m_collectionScope == CollectionScope::Full) {
@@ -1348,6 +1365,9 @@ NEVER_INLINE bool Heap::runEndPhase(GCConductor conn)
         m_verifier->gatherLiveObjects(HeapVerifier::Phase::AfterMarking);
         m_verifier->verify(HeapVerifier::Phase::AfterMarking);
     }
+    
+    if (m_auxiliaryEvacuator)
+        m_auxiliaryEvacuator->evacuate();
         
     if (vm()->typeProfiler())
         vm()->typeProfiler()->invalidateTypeSetCache();
@@ -1367,6 +1387,8 @@ NEVER_INLINE bool Heap::runEndPhase(GCConductor conn)
     m_codeBlocks->clearCurrentlyExecuting();
         
     m_objectSpace.prepareForAllocation();
+    if (m_concurrentSweeper)
+        m_concurrentSweeper->startSweeping();
     updateAllocationLimits();
 
     didFinishCollection();
@@ -2507,6 +2529,8 @@ void Heap::addCoreConstraints()
             gatherJSStackRoots(conservativeRoots);
             gatherScratchBufferRoots(conservativeRoots);
             slotVisitor.append(conservativeRoots);
+            if (m_auxiliaryEvacuator)
+                m_auxiliaryEvacuator->didGatherConservativeRoots(conservativeRoots);
         },
         ConstraintVolatility::GreyedByExecution);
     
@@ -53,7 +53,9 @@
 namespace JSC {
 
 class CodeBlock;
+class AuxiliaryEvacuator;
 class CodeBlockSet;
+class ConcurrentSweeper;
 class CollectingScope;
 class ConservativeRoots;
 class GCDeferralContext;
@@ -146,6 +148,8 @@ public:
     JS_EXPORT_PRIVATE void setGarbageCollectionTimerEnabled(bool);
 
     JS_EXPORT_PRIVATE IncrementalSweeper* sweeper();
+    ConcurrentSweeper* concurrentSweeper() { return m_concurrentSweeper.get(); }
+    AuxiliaryEvacuator* auxiliaryEvacuator() { return m_auxiliaryEvacuator.get(); }
 
     void addObserver(HeapObserver* observer) { m_observers.append(observer); }
     void removeObserver(HeapObserver* observer) { m_observers.removeFirst(observer); }
@@ -593,6 +597,8 @@ private:
     RefPtr<FullGCActivityCallback> m_fullActivityCallback;
     RefPtr<GCActivityCallback> m_edenActivityCallback;
     RefPtr<IncrementalSweeper> m_sweeper;
+    std::unique_ptr<ConcurrentSweeper> m_concurrentSweeper;
+    std::unique_ptr<AuxiliaryEvacuator> m_auxiliaryEvacuator;
     RefPtr<StopIfNecessaryTimer> m_stopIfNecessaryTimer;
 
     Vector<HeapObserver*> m_observers;
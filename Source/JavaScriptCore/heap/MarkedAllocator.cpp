@@ -275,23 +275,25 @@ void MarkedAllocator::addBlock(MarkedBlock::Handle* block)
         index = m_blocks.size();
 
         size_t oldCapacity = m_blocks.capacity();
-        m_blocks.append(block);
-        if (m_blocks.capacity() != oldCapacity) {
+        if (m_blocks.size() == oldCapacity) {
             forEachBitVector(
                 NoLockingNecessary,
                 [&] (FastBitVector& vector) {
                     ASSERT_UNUSED(vector, vector.numBits() == oldCapacity);
                 });
             
-            ASSERT(m_blocks.capacity() > oldCapacity);
-            
+            // The ConcurrentSweeper reads m_blocks while holding the bitvector lock, so we must
+            // not reallocate it behind its back.
             LockHolder locker(m_bitvectorLock);
+            m_blocks.append(block);
+            ASSERT(m_blocks.capacity() > oldCapacity);
             forEachBitVector(
                 locker,
                 [&] (FastBitVector& vector) {
                     vector.resize(m_blocks.capacity());
                 });
-        }
+        } else
+            m_blocks.append(block);
     } else {
         index = m_freeBlockIndices.takeLast();
         ASSERT(!m_blocks[index]);
@@ -440,6 +442,18 @@ MarkedBlock::Handle* MarkedAllocator::findBlockToSweep()
     return m_blocks[m_unsweptCursor];
 }
 
+MarkedBlock::Handle* MarkedAllocator::findBlockToSweepConcurrently(size_t& cursor)
+{
+    auto locker = holdLock(m_bitvectorLock);
+    for (;;) {
+        cursor = (m_canAllocateButNotEmpty & ~m_empty).findBit(cursor, true);
+        if (cursor >= m_blocks.size())
+            return nullptr;
+        if (MarkedBlock::Handle* block = m_blocks[cursor++])
+            return block;
+    }
+}
+
 void MarkedAllocator::sweep()
 {
     m_unswept.forEachSetBit(
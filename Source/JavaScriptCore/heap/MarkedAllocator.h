@@ -210,6 +210,10 @@ public:
     
     MarkedBlock::Handle* findBlockToSweep();
     
+    // Called by the ConcurrentSweeper without heap access. Returns the next block at or after the
+    // cursor that is neither empty nor retired, and advances the cursor past it.
+    MarkedBlock::Handle* findBlockToSweepConcurrently(size_t& cursor);
+    
     Subspace* subspace() const { return m_subspace; }
     MarkedSpace& markedSpace() const;
     
@@ -238,8 +242,8 @@ private:
     Vector<MarkedBlock::Handle*> m_blocks;
     Vector<unsigned> m_freeBlockIndices;
 
-    // Mutator uses this to guard resizing the bitvectors. Those things in the GC that may run
-    // concurrently to the mutator must lock this when accessing the bitvectors.
+    // Mutator uses this to guard resizing the bitvectors and m_blocks. Those things in the GC that
+    // may run concurrently to the mutator must lock this when accessing the bitvectors.
     Lock m_bitvectorLock;
 #define MARKED_ALLOCATOR_BIT_DECLARATION(lowerBitName, capitalBitName) \
     FastBitVector m_ ## lowerBitName;
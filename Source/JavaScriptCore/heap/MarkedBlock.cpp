@@ -26,6 +26,7 @@
 #include "config.h"
 #include "MarkedBlock.h"
 
+#include "ConcurrentSweeper.h"
 #include "JSCell.h"
 #include "JSDestructibleObject.h"
 #include "JSCInlines.h"
@@ -95,6 +96,58 @@ void MarkedBlock::Handle::unsweepWithNoNewlyAllocated()
     m_isFreeListed = false;
 }
 
+bool MarkedBlock::Handle::sweepConcurrently(unsigned epoch)
+{
+    auto locker = holdLock(block().m_lock);
+    
+    if (m_concurrentSweepEpoch == epoch)
+        return false;
+    
+    // We only do the common case: a pop free list built from up-to-date marks. Anything else is
+    // left for the mutator. Nobody changes the marks or the newly allocated bits of a block that
+    // the mutator has not claimed while we are running, since the collector stops us first.
+    if (scribbleMode() == Scribble || newlyAllocatedMode() == HasNewlyAllocated)
+        return false;
+    
+    MarkedBlock& block = this->block();
+    HeapVersion markingVersion = space()->markingVersion();
+    bool marksAreStale = block.areMarksStale(markingVersion);
+    
+    FreeCell* head = nullptr;
+    size_t count = 0;
+    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+        if (!marksAreStale && block.m_marks.get(i))
+            continue;
+        FreeCell* freeCell = reinterpret_cast_ptr<FreeCell*>(&block.atoms()[i]);
+        freeCell->next = head;
+        head = freeCell;
+        ++count;
+    }
+    
+    m_concurrentlySweptFreeList = FreeList::list(head, count * cellSize());
+    m_concurrentSweepEpoch = epoch;
+    m_isConcurrentlySwept = true;
+    return true;
+}
+
+bool MarkedBlock::Handle::takeConcurrentlySweptFreeList(unsigned epoch, FreeList& result)
+{
+    auto locker = holdLock(block().m_lock);
+    
+    // Either way, the block is ours for the rest of this epoch.
+    bool isConcurrentlySwept = m_concurrentSweepEpoch == epoch && m_isConcurrentlySwept;
+    m_concurrentSweepEpoch = epoch;
+    m_isConcurrentlySwept = false;
+    if (!isConcurrentlySwept)
+        return false;
+    
+    result = m_concurrentlySweptFreeList;
+    m_concurrentlySweptFreeList = FreeList();
+    if (false)
+        dataLog("Took concurrently swept block ", RawPointer(&block()), ": ", result, "\n");
+    return true;
+}
+
 void MarkedBlock::Handle::setIsFreeListed()
 {
     m_allocator->setIsEmpty(NoLockingNecessary, this, false);
@@ -425,6 +478,16 @@ FreeList MarkedBlock::Handle::sweep(SweepMode sweepMode)
     
     ASSERT(!m_allocator->isAllocated(NoLockingNecessary, this));
     
+    if (m_attributes.destruction == DoesNotNeedDestruction && !space()->isMarking()) {
+        if (ConcurrentSweeper* concurrentSweeper = heap()->concurrentSweeper()) {
+            FreeList result;
+            if (takeConcurrentlySweptFreeList(concurrentSweeper->epoch(), result)) {
+                setIsFreeListed();
+                return result;
+            }
+        }
+    }
+    
     if (space()->isMarking())
         block().m_lock.lock();
     
@@ -56,6 +56,7 @@ typedef uint32_t HeapVersion;
 
 class MarkedBlock {
     WTF_MAKE_NONCOPYABLE(MarkedBlock);
+    friend class AuxiliaryEvacuator;
     friend class LLIntOffsetsExtractor;
     friend struct VerifyMarked;
 
@@ -135,6 +136,12 @@ public:
         
         void unsweepWithNoNewlyAllocated();
         
+        // Called by the ConcurrentSweeper. Builds a free list for this block and stashes it for
+        // the mutator, unless the mutator has already claimed the block during this sweep epoch
+        // or the block is not in a state where a pop free list can be built without the mutator.
+        // Returns true if it did any work.
+        bool sweepConcurrently(unsigned epoch);
+        
         void zap(const FreeList&);
         
         void shrink();
@@ -220,6 +227,8 @@ public:
         
         void setIsFreeListed();
         
+        bool takeConcurrentlySweptFreeList(unsigned epoch, FreeList&);
+        
         MarkedBlock::Handle* m_prev;
         MarkedBlock::Handle* m_next;
             
@@ -236,6 +245,13 @@ public:
         WeakSet m_weakSet;
         
         HeapVersion m_newlyAllocatedVersion;
+        
+        // These are guarded by the block's lock. If m_concurrentSweepEpoch is the sweeper's
+        // current epoch then either the mutator has claimed the block, or the sweeper has built
+        // m_concurrentlySweptFreeList and m_isConcurrentlySwept is set.
+        unsigned m_concurrentSweepEpoch { 0 };
+        bool m_isConcurrentlySwept { false };
+        FreeList m_concurrentlySweptFreeList;
             
         MarkedBlock* m_block { nullptr };
     };
@@ -73,6 +73,7 @@
 #include "TypeProfilerLog.h"
 #include "WasmPlan.h"
 #include "WasmMemory.h"
+#include "WebAssemblyModuleConstructor.h"
 #include <locale.h>
 #include <math.h>
 #include <stdio.h>
@@ -1057,6 +1058,7 @@ static EncodedJSValue JSC_HOST_CALL functionMaxArguments(ExecState*);
 
 #if ENABLE(WEBASSEMBLY)
 static EncodedJSValue JSC_HOST_CALL functionTestWasmModuleFunctions(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionCompileWebAssemblyStreaming(ExecState*);
 #endif
 
 #if ENABLE(SAMPLING_FLAGS)
@@ -1135,6 +1137,7 @@ public:
     String m_uncaughtExceptionName;
     bool m_alwaysDumpUncaughtException { false };
     bool m_dumpSamplingProfilerData { false };
+    String m_samplingProfilerCollapsedStacksPath;
     bool m_enableRemoteDebugging { false };
 
     void parseArguments(int, char**);
@@ -1328,6 +1331,7 @@ protected:
 
 #if ENABLE(WEBASSEMBLY)
         addFunction(vm, "testWasmModuleFunctions", functionTestWasmModuleFunctions, 0);
+        addFunction(vm, "compileWebAssemblyStreaming", functionCompileWebAssemblyStreaming, 0);
 #endif
 
         if (!arguments.isEmpty()) {
@@ -3179,6 +3183,29 @@ static EncodedJSValue JSC_HOST_CALL functionTestWasmModuleFunctions(ExecState* e
     return encodedJSUndefined();
 }
 
+// compileWebAssemblyStreaming(...JSArrayBufferView chunks) feeds the chunks to a streaming Wasm::Plan one at a time,
+// the way a loader would as the module arrives, and returns the resulting WebAssembly.Module.
+static EncodedJSValue JSC_HOST_CALL functionCompileWebAssemblyStreaming(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    if (!Options::useWebAssembly())
+        return throwVMTypeError(exec, scope, ASCIILiteral("compileWebAssemblyStreaming should only be called if the useWebAssembly option is set"));
+
+    Wasm::Plan plan(&vm);
+    for (unsigned i = 0; i < exec->argumentCount(); ++i) {
+        JSArrayBufferView* chunk = jsDynamicCast<JSArrayBufferView*>(vm, exec->uncheckedArgument(i));
+        if (!chunk)
+            return throwVMTypeError(exec, scope, ASCIILiteral("compileWebAssemblyStreaming expects ArrayBufferView chunks"));
+        plan.appendBytes(static_cast<uint8_t*>(chunk->vector()), chunk->byteLength());
+    }
+    plan.finishStreaming();
+
+    scope.release();
+    return JSValue::encode(WebAssemblyModuleConstructor::createModule(exec, exec->lexicalGlobalObject()->WebAssemblyModuleStructure(), plan));
+}
+
 #endif // ENABLE(WEBASSEBLY)
 
 // Use SEH for Release builds only to get rid of the crash report dialog
@@ -3517,6 +3544,7 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "  -x         Output exit code before terminating\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "  --sample                   Collects and outputs sampling profiler data\n");
+    fprintf(stderr, "  --sample-collapsed=<file>  Collects sampling profiler data and writes it to the file as collapsed stacks\n");
     fprintf(stderr, "  --test262-async            Check that some script calls the print function with the string 'Test262:AsyncTestComplete'\n");
     fprintf(stderr, "  --strict-file=<file>       Parse the given file as if it were in strict mode (this option may be passed more than once)\n");
     fprintf(stderr, "  --module-file=<file>       Parse and evaluate the given file as module (this option may be passed more than once)\n");
@@ -3607,6 +3635,14 @@ void CommandLine::parseArguments(int argc, char** argv)
             m_dumpSamplingProfilerData = true;
             continue;
         }
+        static const char* sampleCollapsedOptStr = "--sample-collapsed=";
+        static const unsigned sampleCollapsedOptStrLength = strlen(sampleCollapsedOptStr);
+        if (!strncmp(arg, sampleCollapsedOptStr, sampleCollapsedOptStrLength)) {
+            JSC::Options::useSamplingProfiler() = true;
+            JSC::Options::collectSamplingProfilerDataForJSCShell() = true;
+            m_samplingProfilerCollapsedStacksPath = String(&arg[sampleCollapsedOptStrLength]);
+            continue;
+        }
 
         static const char* timeoutMultiplierOptStr = "--timeoutMultiplier=";
         static const unsigned timeoutMultiplierOptStrLength = strlen(timeoutMultiplierOptStr);
@@ -3703,6 +3739,8 @@ int runJSC(CommandLine options, const Func& func)
         runInteractive(globalObject);
 
     vm.drainMicrotasks();
+    // The shell never destroys its VM, so write the bytecode cache here.
+    vm.flushBytecodeCache();
     result = success && (test262AsyncTest == test262AsyncPassed) ? 0 : 3;
 
     if (options.m_exitCode)
@@ -3750,6 +3788,16 @@ int runJSC(CommandLine options, const Func& func)
 #endif
     }
 
+    if (!options.m_samplingProfilerCollapsedStacksPath.isNull()) {
+#if ENABLE(SAMPLING_PROFILER)
+        JSLockHolder locker(&vm);
+        if (!vm.samplingProfiler()->reportCollapsedStackTracesToFile(options.m_samplingProfilerCollapsedStacksPath.utf8().data()))
+            dataLog("Could not write sampling profiler data to ", options.m_samplingProfilerCollapsedStacksPath, "\n");
+#else
+        dataLog("Sampling profiler is not enabled on this platform\n");
+#endif
+    }
+
     return result;
 }
 
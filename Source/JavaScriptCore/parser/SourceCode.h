@@ -77,8 +77,6 @@ namespace JSC {
             return m_provider->asID();
         }
 
-        SourceProvider* provider() const { return m_provider.get(); }
-
         SourceCode subExpression(unsigned openBrace, unsigned closeBrace, int firstLine, int startColumn);
 
     private:
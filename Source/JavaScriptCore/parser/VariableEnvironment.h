@@ -56,6 +56,9 @@ public:
 
     ALWAYS_INLINE void clearIsVar() { m_bits &= ~IsVar; }
 
+    uint16_t bits() const { return m_bits; }
+    void setBits(uint16_t bits) { m_bits = bits; }
+
 private:
     enum Traits : uint16_t {
         IsCaptured = 1 << 0,
@@ -105,6 +108,7 @@ public:
     void markVariableAsCaptured(const RefPtr<UniquedStringImpl>& identifier);
     void markAllVariablesAsCaptured();
     bool hasCapturedVariables() const;
+    bool isEverythingCaptured() const { return m_isEverythingCaptured; }
     bool captures(UniquedStringImpl* identifier) const;
     void markVariableAsImported(const RefPtr<UniquedStringImpl>& identifier);
     void markVariableAsExported(const RefPtr<UniquedStringImpl>& identifier);
@@ -0,0 +1,1308 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BytecodeCache.h"
+
+#include "BuiltinNames.h"
+#include "DeferGC.h"
+#include "JSCInlines.h"
+#include "JSTemplateRegistryKey.h"
+#include "Opcode.h"
+#include "SourceCode.h"
+#include "SourceCodeKey.h"
+#include "SymbolTable.h"
+#include "TemplateRegistryKeyTable.h"
+#include "UnlinkedFunctionCodeBlock.h"
+#include "UnlinkedInstructionStream.h"
+#include "UnlinkedProgramCodeBlock.h"
+#include <atomic>
+#include <mutex>
+#include <wtf/Condition.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/ProcessID.h>
+#include <wtf/SHA1.h>
+#include <wtf/WorkQueue.h>
+#include <wtf/text/StringHash.h>
+
+#if OS(UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+// Bump this whenever the encoding below changes. Changes to the bytecode list are
+// detected automatically through bytecodeFingerprint().
+static const uint32_t bytecodeCacheMagic = 0x42435343; // "CSCB"
+static const uint32_t bytecodeCacheFormatVersion = 2;
+
+struct BytecodeCacheHeader {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t bytecodeFingerprint;
+    uint32_t sourceCodeFlags;
+    uint32_t sourceLength;
+    uint32_t payloadSize;
+    SHA1::Digest keyDigest;
+    // The decoder trusts operand indices and offsets in the payload, so a truncated or
+    // corrupted file must be rejected before anything is decoded from it.
+    SHA1::Digest payloadDigest;
+};
+
+enum class CachedIdentifierKind : uint8_t { Null, String, PrivateName, WellKnownSymbol };
+enum class CachedConstantKind : uint8_t { Immediate, String, SymbolTable, TemplateRegistryKey };
+
+static const Identifier CommonIdentifiers::* const wellKnownSymbols[] = {
+#define WELL_KNOWN_SYMBOL_MEMBER(name) &CommonIdentifiers::name##Symbol,
+    JSC_COMMON_PRIVATE_IDENTIFIERS_EACH_WELL_KNOWN_SYMBOL(WELL_KNOWN_SYMBOL_MEMBER)
+#undef WELL_KNOWN_SYMBOL_MEMBER
+};
+
+static uint32_t bytecodeFingerprint()
+{
+    static uint32_t fingerprint;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+        StringHasher hasher;
+        hasher.addCharacter(numOpcodeIDs);
+        for (unsigned i = 0; i < numOpcodeIDs; ++i)
+            hasher.addCharacter(opcodeLength(static_cast<OpcodeID>(i)));
+        hasher.addCharacter(sizeof(ExpressionRangeInfo));
+        hasher.addCharacter(sizeof(EncodedJSValue));
+        hasher.addCharacter(LinkTimeConstantCount);
+        hasher.addCharacter(WTF_ARRAY_LENGTH(wellKnownSymbols));
+        fingerprint = hasher.hash();
+    });
+    return fingerprint;
+}
+
+static std::optional<unsigned> wellKnownSymbolIndex(VM& vm, UniquedStringImpl* uid)
+{
+    for (unsigned i = 0; i < WTF_ARRAY_LENGTH(wellKnownSymbols); ++i) {
+        if ((vm.propertyNames->*wellKnownSymbols[i]).impl() == uid)
+            return i;
+    }
+    return std::nullopt;
+}
+
+class BytecodeCacheEncoder {
+    WTF_MAKE_NONCOPYABLE(BytecodeCacheEncoder);
+public:
+    BytecodeCacheEncoder(VM& vm, SourceProvider* provider)
+        : m_vm(vm)
+        , m_provider(provider)
+    {
+    }
+
+    bool failed() const { return m_failed; }
+    Vector<uint8_t>& buffer() { return m_buffer; }
+    Vector<uint8_t> takeBuffer() { return WTFMove(m_buffer); }
+
+    void writeProgramCodeBlock(UnlinkedProgramCodeBlock*, int sourceStartOffset);
+
+private:
+    void fail() { m_failed = true; }
+
+    void writeBytes(const void* data, size_t size) { m_buffer.append(static_cast<const uint8_t*>(data), size); }
+    void write8(uint8_t value) { m_buffer.append(value); }
+    void write32(uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void write64(uint64_t value) { writeBytes(&value, sizeof(value)); }
+    void writeBool(bool value) { write8(value); }
+
+    template<typename T>
+    void writeVector(const Vector<T>& vector)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be written as raw bytes");
+        write32(vector.size());
+        writeBytes(vector.data(), vector.size() * sizeof(T));
+    }
+
+    void writeString(const String&);
+    void writeUid(UniquedStringImpl*);
+    void writeIdentifier(const Identifier& identifier) { writeUid(identifier.impl()); }
+    void writeVariableEnvironment(const VariableEnvironment&);
+    void writeBitVector(const BitVector&);
+    void writeConstant(JSValue);
+    void writeConstantBufferValue(UnlinkedCodeBlock*, JSValue);
+    void writeSymbolTable(SymbolTable*);
+    void writeTemplateRegistryKey(JSTemplateRegistryKey*);
+    void writeFunctionExecutable(UnlinkedFunctionExecutable*, int parentSourceStartOffset);
+    void writeNestedCodeBlock(UnlinkedFunctionCodeBlock*, int sourceStartOffset);
+    void writeCodeBlock(UnlinkedCodeBlock*, int sourceStartOffset);
+
+    VM& m_vm;
+    SourceProvider* m_provider;
+    Vector<uint8_t> m_buffer;
+    bool m_failed { false };
+};
+
+void BytecodeCacheEncoder::writeString(const String& string)
+{
+    if (string.isNull()) {
+        write32(UINT_MAX);
+        return;
+    }
+    write32(string.length());
+    writeBool(string.is8Bit());
+    if (string.is8Bit())
+        writeBytes(string.characters8(), string.length() * sizeof(LChar));
+    else
+        writeBytes(string.characters16(), string.length() * sizeof(UChar));
+}
+
+void BytecodeCacheEncoder::writeUid(UniquedStringImpl* uid)
+{
+    if (!uid) {
+        write8(static_cast<uint8_t>(CachedIdentifierKind::Null));
+        return;
+    }
+
+    if (!uid->isSymbol()) {
+        write8(static_cast<uint8_t>(CachedIdentifierKind::String));
+        writeString(String(uid));
+        return;
+    }
+
+    // Symbols can only be named by reference to something every VM creates in the same way.
+    Identifier identifier = Identifier::fromUid(&m_vm, uid);
+    const Identifier& publicName = m_vm.propertyNames->lookUpPublicName(identifier);
+    if (!publicName.isEmpty()) {
+        write8(static_cast<uint8_t>(CachedIdentifierKind::PrivateName));
+        writeString(publicName.string());
+        return;
+    }
+
+    if (std::optional<unsigned> index = wellKnownSymbolIndex(m_vm, uid)) {
+        write8(static_cast<uint8_t>(CachedIdentifierKind::WellKnownSymbol));
+        write32(*index);
+        return;
+    }
+
+    fail();
+}
+
+void BytecodeCacheEncoder::writeVariableEnvironment(const VariableEnvironment& environment)
+{
+    writeBool(environment.isEverythingCaptured());
+    write32(environment.size());
+    for (auto& entry : environment) {
+        writeUid(entry.key.get());
+        write32(entry.value.bits());
+    }
+}
+
+void BytecodeCacheEncoder::writeBitVector(const BitVector& bitVector)
+{
+    write32(bitVector.size());
+    for (size_t i = 0; i < bitVector.size(); i += 8) {
+        uint8_t byte = 0;
+        for (size_t bit = 0; bit < 8 && i + bit < bitVector.size(); ++bit) {
+            if (bitVector.quickGet(i + bit))
+                byte |= 1 << bit;
+        }
+        write8(byte);
+    }
+}
+
+void BytecodeCacheEncoder::writeConstant(JSValue value)
+{
+    if (value.isEmpty() || !value.isCell()) {
+        write8(static_cast<uint8_t>(CachedConstantKind::Immediate));
+        write64(JSValue::encode(value));
+        return;
+    }
+
+    JSCell* cell = value.asCell();
+    if (JSString* string = jsDynamicCast<JSString*>(m_vm, cell)) {
+        write8(static_cast<uint8_t>(CachedConstantKind::String));
+        writeString(string->tryGetValue());
+        return;
+    }
+    if (SymbolTable* symbolTable = jsDynamicCast<SymbolTable*>(m_vm, cell)) {
+        write8(static_cast<uint8_t>(CachedConstantKind::SymbolTable));
+        writeSymbolTable(symbolTable);
+        return;
+    }
+    if (JSTemplateRegistryKey* templateRegistryKey = jsDynamicCast<JSTemplateRegistryKey*>(m_vm, cell)) {
+        write8(static_cast<uint8_t>(CachedConstantKind::TemplateRegistryKey));
+        writeTemplateRegistryKey(templateRegistryKey);
+        return;
+    }
+
+    fail();
+}
+
+void BytecodeCacheEncoder::writeConstantBufferValue(UnlinkedCodeBlock* codeBlock, JSValue value)
+{
+    // Constant buffers are not visited by the GC; any cell in them is kept alive by the
+    // constant pool, so we refer to it by its index there.
+    if (value.isEmpty() || !value.isCell()) {
+        writeBool(false);
+        write64(JSValue::encode(value));
+        return;
+    }
+
+    for (size_t i = 0; i < codeBlock->m_constantRegisters.size(); ++i) {
+        if (codeBlock->m_constantRegisters[i].get() == value) {
+            writeBool(true);
+            write32(i);
+            return;
+        }
+    }
+
+    fail();
+}
+
+void BytecodeCacheEncoder::writeSymbolTable(SymbolTable* symbolTable)
+{
+    // CodeBlock only ever links against cloneScopePart(), so that is all we keep.
+    ConcurrentJSLocker locker(symbolTable->m_lock);
+    write8(symbolTable->scopeType());
+    writeBool(symbolTable->usesNonStrictEval());
+    writeBool(symbolTable->isNestedLexicalScope());
+    write32(symbolTable->maxScopeOffset().offsetUnchecked());
+
+    unsigned scopeEntries = 0;
+    for (auto iter = symbolTable->begin(locker), end = symbolTable->end(locker); iter != end; ++iter) {
+        if (iter->value.varOffset().isScope())
+            scopeEntries++;
+    }
+    write32(scopeEntries);
+    for (auto iter = symbolTable->begin(locker), end = symbolTable->end(locker); iter != end; ++iter) {
+        if (!iter->value.varOffset().isScope())
+            continue;
+        writeUid(iter->key.get());
+        write32(iter->value.scopeOffset().offset());
+        write32(iter->value.getAttributes());
+    }
+
+    uint32_t argumentsLength = symbolTable->argumentsLength();
+    writeBool(argumentsLength);
+    write32(argumentsLength);
+    for (uint32_t i = 0; i < argumentsLength; ++i)
+        write32(symbolTable->argumentOffset(i).offsetUnchecked());
+}
+
+void BytecodeCacheEncoder::writeTemplateRegistryKey(JSTemplateRegistryKey* templateRegistryKey)
+{
+    const TemplateRegistryKey& key = templateRegistryKey->templateRegistryKey();
+    write32(key.rawStrings().size());
+    for (const String& string : key.rawStrings())
+        writeString(string);
+    write32(key.cookedStrings().size());
+    for (const std::optional<String>& string : key.cookedStrings()) {
+        writeBool(!!string);
+        if (string)
+            writeString(*string);
+    }
+}
+
+void BytecodeCacheEncoder::writeFunctionExecutable(UnlinkedFunctionExecutable* executable, int parentSourceStartOffset)
+{
+    if (executable->isBuiltinFunction() || !executable->m_parentSourceOverride.isNull()) {
+        fail();
+        return;
+    }
+
+    write32(executable->m_firstLineOffset);
+    write32(executable->m_lineCount);
+    write32(executable->m_unlinkedFunctionNameStart);
+    write32(executable->m_unlinkedBodyStartColumn);
+    write32(executable->m_unlinkedBodyEndColumn);
+    write32(executable->m_startOffset);
+    write32(executable->m_sourceLength);
+    write32(executable->m_parametersStartOffset);
+    write32(executable->m_typeProfilingStartOffset);
+    write32(executable->m_typeProfilingEndOffset);
+    write32(executable->m_parameterCount);
+    write32(executable->m_features);
+    write32(static_cast<uint32_t>(executable->m_sourceParseMode));
+    writeBool(executable->m_isInStrictContext);
+    writeBool(executable->m_hasCapturedVariables);
+    write8(executable->m_constructAbility);
+    write8(executable->m_constructorKind);
+    write8(executable->m_functionMode);
+    write8(executable->m_scriptMode);
+    write8(executable->m_superBinding);
+    write8(executable->m_derivedContextType);
+
+    writeIdentifier(executable->m_name);
+    writeIdentifier(executable->m_ecmaName);
+    writeIdentifier(executable->m_inferredName);
+
+    const SourceCode& classSource = executable->m_classSource;
+    writeBool(!classSource.isNull());
+    if (!classSource.isNull()) {
+        if (classSource.provider() != m_provider) {
+            fail();
+            return;
+        }
+        write32(classSource.startOffset() - parentSourceStartOffset);
+        write32(classSource.endOffset() - parentSourceStartOffset);
+        write32(classSource.firstLine().oneBasedInt());
+        write32(classSource.startColumn().oneBasedInt());
+    }
+
+    writeString(executable->m_sourceURLDirective);
+    writeString(executable->m_sourceMappingURLDirective);
+    writeVariableEnvironment(executable->m_parentScopeTDZVariables);
+
+    int sourceStartOffset = parentSourceStartOffset + executable->m_startOffset;
+    writeNestedCodeBlock(executable->m_unlinkedCodeBlockForCall.get(), sourceStartOffset);
+    writeNestedCodeBlock(executable->m_unlinkedCodeBlockForConstruct.get(), sourceStartOffset);
+}
+
+void BytecodeCacheEncoder::writeNestedCodeBlock(UnlinkedFunctionCodeBlock* codeBlock, int sourceStartOffset)
+{
+    // Nested code blocks are length-prefixed so that the decoder can skip over them and
+    // come back once the function is actually called.
+    writeBool(codeBlock);
+    if (!codeBlock)
+        return;
+
+    size_t lengthOffset = m_buffer.size();
+    write32(0);
+    writeCodeBlock(codeBlock, sourceStartOffset);
+    uint32_t length = m_buffer.size() - lengthOffset - sizeof(uint32_t);
+    memcpy(m_buffer.data() + lengthOffset, &length, sizeof(length));
+}
+
+void BytecodeCacheEncoder::writeCodeBlock(UnlinkedCodeBlock* codeBlock, int sourceStartOffset)
+{
+    if (m_failed)
+        return;
+
+    write8(codeBlock->m_codeType);
+    write32(static_cast<uint32_t>(codeBlock->m_parseMode));
+    writeBool(codeBlock->m_usesEval);
+    writeBool(codeBlock->m_isStrictMode);
+    writeBool(codeBlock->m_isConstructor);
+    writeBool(codeBlock->m_hasCapturedVariables);
+    writeBool(codeBlock->m_isBuiltinFunction);
+    write8(codeBlock->m_superBinding);
+    write8(codeBlock->m_scriptMode);
+    writeBool(codeBlock->m_isArrowFunctionContext);
+    writeBool(codeBlock->m_isClassContext);
+    writeBool(codeBlock->m_wasCompiledWithDebuggingOpcodes);
+    write8(codeBlock->m_constructorKind);
+    write8(codeBlock->m_derivedContextType);
+    write8(codeBlock->m_evalContextType);
+
+    write32(codeBlock->m_numVars);
+    write32(codeBlock->m_numCapturedVars);
+    write32(codeBlock->m_numCalleeLocals);
+    write32(codeBlock->m_numParameters);
+    write32(codeBlock->m_thisRegister.offset());
+    write32(codeBlock->m_scopeRegister.offset());
+    write32(codeBlock->m_globalObjectRegister.offset());
+    write32(codeBlock->m_lineCount);
+    write32(codeBlock->m_endColumn);
+    write32(codeBlock->m_features);
+    writeString(codeBlock->m_sourceURLDirective);
+    writeString(codeBlock->m_sourceMappingURLDirective);
+
+    const UnlinkedInstructionStream& instructions = codeBlock->instructions();
+    write32(instructions.count());
+    write32(instructions.data().size());
+    writeBytes(instructions.data().data(), instructions.data().size());
+
+    writeVector(codeBlock->m_jumpTargets);
+    writeVector(codeBlock->m_propertyAccessInstructions);
+
+    write32(codeBlock->m_identifiers.size());
+    for (const Identifier& identifier : codeBlock->m_identifiers)
+        writeIdentifier(identifier);
+
+    write32(codeBlock->m_bitVectors.size());
+    for (const BitVector& bitVector : codeBlock->m_bitVectors)
+        writeBitVector(bitVector);
+
+    write32(codeBlock->m_constantRegisters.size());
+    for (size_t i = 0; i < codeBlock->m_constantRegisters.size(); ++i) {
+        writeConstant(codeBlock->m_constantRegisters[i].get());
+        write8(static_cast<uint8_t>(codeBlock->m_constantsSourceCodeRepresentation[i]));
+    }
+    for (unsigned index : codeBlock->m_linkTimeConstants)
+        write32(index);
+
+    write32(codeBlock->m_functionDecls.size());
+    for (auto& executable : codeBlock->m_functionDecls)
+        writeFunctionExecutable(executable.get(), sourceStartOffset);
+    write32(codeBlock->m_functionExprs.size());
+    for (auto& executable : codeBlock->m_functionExprs)
+        writeFunctionExecutable(executable.get(), sourceStartOffset);
+
+    write32(codeBlock->m_arrayProfileCount);
+    write32(codeBlock->m_arrayAllocationProfileCount);
+    write32(codeBlock->m_objectAllocationProfileCount);
+    write32(codeBlock->m_valueProfileCount);
+    write32(codeBlock->m_llintCallLinkInfoCount);
+
+    writeVector(codeBlock->m_expressionInfo);
+
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+    writeBool(rareData);
+    if (!rareData)
+        return;
+
+    write32(rareData->m_exceptionHandlers.size());
+    for (const UnlinkedHandlerInfo& handler : rareData->m_exceptionHandlers) {
+        write32(handler.start);
+        write32(handler.end);
+        write32(handler.target);
+        write8(static_cast<uint8_t>(handler.type()));
+    }
+
+    write32(rareData->m_regexps.size());
+    for (auto& regExp : rareData->m_regexps) {
+        writeString(regExp->pattern());
+        write32(regExp->key().flagsValue);
+    }
+
+    write32(rareData->m_constantBuffers.size());
+    for (const UnlinkedCodeBlock::ConstantBuffer& buffer : rareData->m_constantBuffers) {
+        write32(buffer.size());
+        for (JSValue value : buffer)
+            writeConstantBufferValue(codeBlock, value);
+    }
+
+    write32(rareData->m_switchJumpTables.size());
+    for (const UnlinkedSimpleJumpTable& table : rareData->m_switchJumpTables) {
+        write32(table.min);
+        writeVector(table.branchOffsets);
+    }
+
+    write32(rareData->m_stringSwitchJumpTables.size());
+    for (const UnlinkedStringJumpTable& table : rareData->m_stringSwitchJumpTables) {
+        write32(table.offsetTable.size());
+        for (auto& entry : table.offsetTable) {
+            writeString(entry.key.get());
+            write32(entry.value.branchOffset);
+        }
+    }
+
+    writeVector(rareData->m_expressionInfoFatPositions);
+
+    write32(rareData->m_typeProfilerInfoMap.size());
+    for (auto& entry : rareData->m_typeProfilerInfoMap) {
+        write32(entry.key);
+        write32(entry.value.m_startDivot);
+        write32(entry.value.m_endDivot);
+    }
+
+    write32(rareData->m_opProfileControlFlowBytecodeOffsets.size());
+    for (size_t offset : rareData->m_opProfileControlFlowBytecodeOffsets)
+        write64(offset);
+}
+
+void BytecodeCacheEncoder::writeProgramCodeBlock(UnlinkedProgramCodeBlock* codeBlock, int sourceStartOffset)
+{
+    writeCodeBlock(codeBlock, sourceStartOffset);
+    writeVariableEnvironment(codeBlock->variableDeclarations());
+    writeVariableEnvironment(codeBlock->lexicalDeclarations());
+}
+
+class BytecodeCacheDecoder {
+    WTF_MAKE_NONCOPYABLE(BytecodeCacheDecoder);
+public:
+    BytecodeCacheDecoder(VM& vm, BytecodeCacheFile& file, size_t offset, SourceProvider* provider)
+        : m_vm(vm)
+        , m_file(file)
+        , m_offset(offset)
+        , m_provider(provider)
+    {
+    }
+
+    bool failed() const { return m_failed; }
+
+    UnlinkedProgramCodeBlock* readProgramCodeBlock(int sourceStartOffset);
+    UnlinkedFunctionCodeBlock* readFunctionCodeBlock(int sourceStartOffset);
+
+private:
+    void fail() { m_failed = true; }
+
+    bool readBytes(void* data, size_t size)
+    {
+        if (m_failed || size > m_file.size() - m_offset) {
+            fail();
+            return false;
+        }
+        memcpy(data, m_file.data() + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    uint8_t read8()
+    {
+        uint8_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+
+    uint32_t read32()
+    {
+        uint32_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+
+    uint64_t read64()
+    {
+        uint64_t value = 0;
+        readBytes(&value, sizeof(value));
+        return value;
+    }
+
+    bool readBool() { return read8(); }
+
+    // Reads an element count, rejecting counts that could not possibly fit in the rest
+    // of the file so that a damaged file cannot trigger huge allocations.
+    uint32_t readCount(size_t minimumElementSize = 1)
+    {
+        uint32_t count = read32();
+        if (m_failed || static_cast<uint64_t>(count) * minimumElementSize > m_file.size() - m_offset) {
+            fail();
+            return 0;
+        }
+        return count;
+    }
+
+    template<typename T>
+    void readVector(Vector<T>& vector)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain data can be read as raw bytes");
+        uint32_t size = readCount(sizeof(T));
+        vector.resize(size);
+        readBytes(vector.data(), size * sizeof(T));
+    }
+
+    String readString();
+    RefPtr<UniquedStringImpl> readUid();
+    Identifier readIdentifier();
+    void readVariableEnvironment(VariableEnvironment&);
+    void readBitVector(BitVector&);
+    JSValue readConstant();
+    SymbolTable* readSymbolTable();
+    JSTemplateRegistryKey* readTemplateRegistryKey();
+    UnlinkedFunctionExecutable* readFunctionExecutable(int parentSourceStartOffset);
+    unsigned skipNestedCodeBlock();
+
+    template<typename CodeBlockType, typename Functor>
+    CodeBlockType* readCodeBlock(int sourceStartOffset, const Functor& createCodeBlock);
+
+    VM& m_vm;
+    BytecodeCacheFile& m_file;
+    size_t m_offset;
+    SourceProvider* m_provider;
+    bool m_failed { false };
+};
+
+String BytecodeCacheDecoder::readString()
+{
+    uint32_t length = read32();
+    if (length == UINT_MAX || m_failed)
+        return String();
+    bool is8Bit = readBool();
+    size_t size = static_cast<size_t>(length) * (is8Bit ? sizeof(LChar) : sizeof(UChar));
+    if (m_failed || size > m_file.size() - m_offset) {
+        fail();
+        return String();
+    }
+
+    const uint8_t* characters = m_file.data() + m_offset;
+    m_offset += size;
+    if (is8Bit)
+        return String(reinterpret_cast<const LChar*>(characters), length);
+
+    // The mapping gives us no alignment guarantees for 16-bit characters.
+    UChar* buffer;
+    String result = String::createUninitialized(length, buffer);
+    memcpy(buffer, characters, size);
+    return result;
+}
+
+RefPtr<UniquedStringImpl> BytecodeCacheDecoder::readUid()
+{
+    switch (static_cast<CachedIdentifierKind>(read8())) {
+    case CachedIdentifierKind::Null:
+        return nullptr;
+    case CachedIdentifierKind::String: {
+        String string = readString();
+        if (m_failed || string.isNull())
+            break;
+        return Identifier::fromString(&m_vm, string).impl();
+    }
+    case CachedIdentifierKind::PrivateName: {
+        String publicName = readString();
+        if (m_failed || publicName.isNull())
+            break;
+        if (const Identifier* privateName = m_vm.propertyNames->lookUpPrivateName(Identifier::fromString(&m_vm, publicName)))
+            return privateName->impl();
+        break;
+    }
+    case CachedIdentifierKind::WellKnownSymbol: {
+        uint32_t index = read32();
+        if (m_failed || index >= WTF_ARRAY_LENGTH(wellKnownSymbols))
+            break;
+        return (m_vm.propertyNames->*wellKnownSymbols[index]).impl();
+    }
+    }
+
+    fail();
+    return nullptr;
+}
+
+Identifier BytecodeCacheDecoder::readIdentifier()
+{
+    RefPtr<UniquedStringImpl> uid = readUid();
+    if (!uid)
+        return Identifier();
+    return Identifier::fromUid(&m_vm, uid.get());
+}
+
+void BytecodeCacheDecoder::readVariableEnvironment(VariableEnvironment& environment)
+{
+    if (readBool())
+        environment.markAllVariablesAsCaptured();
+    uint32_t size = readCount();
+    for (uint32_t i = 0; i < size && !m_failed; ++i) {
+        RefPtr<UniquedStringImpl> uid = readUid();
+        uint32_t bits = read32();
+        if (m_failed || !uid) {
+            fail();
+            return;
+        }
+        environment.add(uid).iterator->value.setBits(bits);
+    }
+}
+
+void BytecodeCacheDecoder::readBitVector(BitVector& bitVector)
+{
+    uint32_t size = read32();
+    if (m_failed || (size + 7) / 8 > m_file.size() - m_offset) {
+        fail();
+        return;
+    }
+    bitVector.ensureSize(size);
+    for (uint32_t i = 0; i < size; i += 8) {
+        uint8_t byte = read8();
+        for (uint32_t bit = 0; bit < 8 && i + bit < size; ++bit) {
+            if (byte & (1 << bit))
+                bitVector.quickSet(i + bit);
+        }
+    }
+}
+
+JSValue BytecodeCacheDecoder::readConstant()
+{
+    switch (static_cast<CachedConstantKind>(read8())) {
+    case CachedConstantKind::Immediate: {
+        JSValue value = JSValue::decode(read64());
+        if (!value.isEmpty() && value.isCell())
+            break;
+        return value;
+    }
+    case CachedConstantKind::String: {
+        String string = readString();
+        if (m_failed || string.isNull())
+            break;
+        return jsString(&m_vm, string);
+    }
+    case CachedConstantKind::SymbolTable:
+        return readSymbolTable();
+    case CachedConstantKind::TemplateRegistryKey:
+        return readTemplateRegistryKey();
+    }
+
+    fail();
+    return JSValue();
+}
+
+SymbolTable* BytecodeCacheDecoder::readSymbolTable()
+{
+    SymbolTable* symbolTable = SymbolTable::create(m_vm);
+    symbolTable->setScopeType(static_cast<SymbolTable::ScopeType>(read8()));
+    symbolTable->setUsesNonStrictEval(readBool());
+    if (readBool())
+        symbolTable->markIsNestedLexicalScope();
+    ScopeOffset maxScopeOffset(read32());
+
+    uint32_t size = readCount();
+    for (uint32_t i = 0; i < size && !m_failed; ++i) {
+        RefPtr<UniquedStringImpl> uid = readUid();
+        ScopeOffset offset(read32());
+        unsigned attributes = read32();
+        if (m_failed || !uid || !offset) {
+            fail();
+            return nullptr;
+        }
+        symbolTable->set(uid.get(), SymbolTableEntry(VarOffset(offset), attributes));
+    }
+    if (!!maxScopeOffset)
+        symbolTable->didUseScopeOffset(maxScopeOffset);
+
+    bool hasArguments = readBool();
+    uint32_t argumentsLength = readCount(sizeof(uint32_t));
+    if (hasArguments) {
+        symbolTable->setArgumentsLength(m_vm, argumentsLength);
+        for (uint32_t i = 0; i < argumentsLength && !m_failed; ++i)
+            symbolTable->setArgumentOffset(m_vm, i, ScopeOffset(read32()));
+    }
+
+    if (m_failed)
+        return nullptr;
+    return symbolTable;
+}
+
+JSTemplateRegistryKey* BytecodeCacheDecoder::readTemplateRegistryKey()
+{
+    TemplateRegistryKey::StringVector rawStrings;
+    uint32_t rawCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < rawCount && !m_failed; ++i)
+        rawStrings.append(readString());
+
+    TemplateRegistryKey::OptionalStringVector cookedStrings;
+    uint32_t cookedCount = readCount();
+    for (uint32_t i = 0; i < cookedCount && !m_failed; ++i) {
+        if (readBool())
+            cookedStrings.append(readString());
+        else
+            cookedStrings.append(std::nullopt);
+    }
+
+    if (m_failed)
+        return nullptr;
+    return JSTemplateRegistryKey::create(m_vm, m_vm.templateRegistryKeyTable().createKey(WTFMove(rawStrings), WTFMove(cookedStrings)));
+}
+
+unsigned BytecodeCacheDecoder::skipNestedCodeBlock()
+{
+    if (!readBool())
+        return 0;
+
+    uint32_t length = read32();
+    if (m_failed || length > m_file.size() - m_offset) {
+        fail();
+        return 0;
+    }
+    unsigned offset = m_offset;
+    m_offset += length;
+    return offset;
+}
+
+UnlinkedFunctionExecutable* BytecodeCacheDecoder::readFunctionExecutable(int parentSourceStartOffset)
+{
+    UnlinkedFunctionExecutable* executable = new (NotNull, allocateCell<UnlinkedFunctionExecutable>(m_vm.heap)) UnlinkedFunctionExecutable(&m_vm, m_vm.unlinkedFunctionExecutableStructure.get());
+    executable->finishCreation(m_vm);
+
+    executable->m_firstLineOffset = read32();
+    executable->m_lineCount = read32();
+    executable->m_unlinkedFunctionNameStart = read32();
+    executable->m_unlinkedBodyStartColumn = read32();
+    executable->m_unlinkedBodyEndColumn = read32();
+    executable->m_startOffset = read32();
+    executable->m_sourceLength = read32();
+    executable->m_parametersStartOffset = read32();
+    executable->m_typeProfilingStartOffset = read32();
+    executable->m_typeProfilingEndOffset = read32();
+    executable->m_parameterCount = read32();
+    executable->m_features = read32();
+    executable->m_sourceParseMode = static_cast<SourceParseMode>(read32());
+    executable->m_isInStrictContext = readBool();
+    executable->m_hasCapturedVariables = readBool();
+    executable->m_isBuiltinFunction = false;
+    executable->m_constructAbility = read8();
+    executable->m_constructorKind = read8();
+    executable->m_functionMode = read8();
+    executable->m_scriptMode = read8();
+    executable->m_superBinding = read8();
+    executable->m_derivedContextType = read8();
+
+    executable->m_name = readIdentifier();
+    executable->m_ecmaName = readIdentifier();
+    executable->m_inferredName = readIdentifier();
+
+    if (readBool()) {
+        int startOffset = parentSourceStartOffset + static_cast<int32_t>(read32());
+        int endOffset = parentSourceStartOffset + static_cast<int32_t>(read32());
+        int firstLine = read32();
+        int startColumn = read32();
+        if (m_failed || startOffset < 0 || endOffset < startOffset || static_cast<unsigned>(endOffset) > m_provider->source().length()) {
+            fail();
+            return nullptr;
+        }
+        executable->m_classSource = SourceCode(RefPtr<SourceProvider>(m_provider), startOffset, endOffset, firstLine, startColumn);
+    }
+
+    executable->m_sourceURLDirective = readString();
+    executable->m_sourceMappingURLDirective = readString();
+    readVariableEnvironment(executable->m_parentScopeTDZVariables);
+
+    executable->m_cachedCodeBlockForCallOffset = skipNestedCodeBlock();
+    executable->m_cachedCodeBlockForConstructOffset = skipNestedCodeBlock();
+    if (executable->m_cachedCodeBlockForCallOffset || executable->m_cachedCodeBlockForConstructOffset)
+        executable->m_cachedBytecode = &m_file;
+
+    if (m_failed)
+        return nullptr;
+    return executable;
+}
+
+template<typename CodeBlockType, typename Functor>
+CodeBlockType* BytecodeCacheDecoder::readCodeBlock(int sourceStartOffset, const Functor& createCodeBlock)
+{
+    CodeType codeType = static_cast<CodeType>(read8());
+    SourceParseMode parseMode = static_cast<SourceParseMode>(read32());
+    bool usesEval = readBool();
+    bool isStrictMode = readBool();
+    bool isConstructor = readBool();
+    bool hasCapturedVariables = readBool();
+    bool isBuiltinFunction = readBool();
+    SuperBinding superBinding = static_cast<SuperBinding>(read8());
+    JSParserScriptMode scriptMode = static_cast<JSParserScriptMode>(read8());
+    bool isArrowFunctionContext = readBool();
+    bool isClassContext = readBool();
+    bool wasCompiledWithDebuggingOpcodes = readBool();
+    ConstructorKind constructorKind = static_cast<ConstructorKind>(read8());
+    DerivedContextType derivedContextType = static_cast<DerivedContextType>(read8());
+    EvalContextType evalContextType = static_cast<EvalContextType>(read8());
+    if (m_failed)
+        return nullptr;
+
+    ExecutableInfo info(usesEval, isStrictMode, isConstructor, isBuiltinFunction, constructorKind, scriptMode, superBinding, parseMode, derivedContextType, isArrowFunctionContext, isClassContext, evalContextType);
+    CodeBlockType* codeBlock = createCodeBlock(codeType, info, wasCompiledWithDebuggingOpcodes ? DebuggerOn : DebuggerOff);
+    codeBlock->m_hasCapturedVariables = hasCapturedVariables;
+    codeBlock->m_wasCompiledWithDebuggingOpcodes = wasCompiledWithDebuggingOpcodes;
+
+    codeBlock->m_numVars = read32();
+    codeBlock->m_numCapturedVars = read32();
+    codeBlock->m_numCalleeLocals = read32();
+    codeBlock->m_numParameters = read32();
+    codeBlock->m_thisRegister = VirtualRegister(static_cast<int32_t>(read32()));
+    codeBlock->m_scopeRegister = VirtualRegister(static_cast<int32_t>(read32()));
+    codeBlock->m_globalObjectRegister = VirtualRegister(static_cast<int32_t>(read32()));
+    codeBlock->m_lineCount = read32();
+    codeBlock->m_endColumn = read32();
+    codeBlock->m_features = read32();
+    codeBlock->m_sourceURLDirective = readString();
+    codeBlock->m_sourceMappingURLDirective = readString();
+
+    unsigned instructionCount = read32();
+    uint32_t instructionsSize = readCount();
+    RefCountedArray<unsigned char> instructions(instructionsSize);
+    readBytes(instructions.data(), instructionsSize);
+    if (m_failed)
+        return nullptr;
+    codeBlock->m_unlinkedInstructions = std::make_unique<UnlinkedInstructionStream>(WTFMove(instructions), instructionCount);
+
+    readVector(codeBlock->m_jumpTargets);
+    readVector(codeBlock->m_propertyAccessInstructions);
+
+    uint32_t identifierCount = readCount();
+    codeBlock->m_identifiers.reserveInitialCapacity(identifierCount);
+    for (uint32_t i = 0; i < identifierCount && !m_failed; ++i)
+        codeBlock->m_identifiers.uncheckedAppend(readIdentifier());
+
+    uint32_t bitVectorCount = readCount(sizeof(uint32_t));
+    codeBlock->m_bitVectors.resize(bitVectorCount);
+    for (uint32_t i = 0; i < bitVectorCount && !m_failed; ++i)
+        readBitVector(codeBlock->m_bitVectors[i]);
+
+    uint32_t constantCount = readCount(2);
+    for (uint32_t i = 0; i < constantCount && !m_failed; ++i) {
+        JSValue constant = readConstant();
+        SourceCodeRepresentation representation = static_cast<SourceCodeRepresentation>(read8());
+        if (m_failed)
+            return nullptr;
+        auto locker = lockDuringMarking(m_vm.heap, *codeBlock);
+        codeBlock->m_constantRegisters.append(WriteBarrier<Unknown>());
+        codeBlock->m_constantRegisters.last().set(m_vm, codeBlock, constant);
+        codeBlock->m_constantsSourceCodeRepresentation.append(representation);
+    }
+    for (unsigned& index : codeBlock->m_linkTimeConstants) {
+        index = read32();
+        // Zero means the link-time constant is unused, even when there are no constants at all.
+        if (index && index >= constantCount)
+            fail();
+    }
+
+    uint32_t functionDeclCount = readCount();
+    for (uint32_t i = 0; i < functionDeclCount && !m_failed; ++i) {
+        if (UnlinkedFunctionExecutable* executable = readFunctionExecutable(sourceStartOffset))
+            codeBlock->addFunctionDecl(executable);
+    }
+    uint32_t functionExprCount = readCount();
+    for (uint32_t i = 0; i < functionExprCount && !m_failed; ++i) {
+        if (UnlinkedFunctionExecutable* executable = readFunctionExecutable(sourceStartOffset))
+            codeBlock->addFunctionExpr(executable);
+    }
+
+    codeBlock->m_arrayProfileCount = read32();
+    codeBlock->m_arrayAllocationProfileCount = read32();
+    codeBlock->m_objectAllocationProfileCount = read32();
+    codeBlock->m_valueProfileCount = read32();
+    codeBlock->m_llintCallLinkInfoCount = read32();
+
+    readVector(codeBlock->m_expressionInfo);
+
+    if (!readBool() || m_failed)
+        return m_failed ? nullptr : codeBlock;
+
+    codeBlock->createRareDataIfNecessary();
+    UnlinkedCodeBlock::RareData& rareData = *codeBlock->m_rareData;
+
+    uint32_t handlerCount = readCount(3 * sizeof(uint32_t) + 1);
+    for (uint32_t i = 0; i < handlerCount && !m_failed; ++i) {
+        uint32_t start = read32();
+        uint32_t end = read32();
+        uint32_t target = read32();
+        HandlerType type = static_cast<HandlerType>(read8());
+        rareData.m_exceptionHandlers.append(UnlinkedHandlerInfo(start, end, target, type));
+    }
+
+    uint32_t regExpCount = readCount();
+    for (uint32_t i = 0; i < regExpCount && !m_failed; ++i) {
+        String pattern = readString();
+        RegExpFlags flags = static_cast<RegExpFlags>(read32());
+        if (m_failed || pattern.isNull())
+            return nullptr;
+        codeBlock->addRegExp(RegExp::create(m_vm, pattern, flags));
+    }
+
+    uint32_t constantBufferCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < constantBufferCount && !m_failed; ++i) {
+        uint32_t length = readCount();
+        UnlinkedCodeBlock::ConstantBuffer& buffer = rareData.m_constantBuffers[codeBlock->addConstantBuffer(length)];
+        for (uint32_t j = 0; j < length && !m_failed; ++j) {
+            if (readBool()) {
+                uint32_t index = read32();
+                if (index >= codeBlock->m_constantRegisters.size()) {
+                    fail();
+                    break;
+                }
+                buffer[j] = codeBlock->m_constantRegisters[index].get();
+                continue;
+            }
+            JSValue value = JSValue::decode(read64());
+            if (!value.isEmpty() && value.isCell())
+                fail();
+            else
+                buffer[j] = value;
+        }
+    }
+
+    uint32_t switchJumpTableCount = readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < switchJumpTableCount && !m_failed; ++i) {
+        UnlinkedSimpleJumpTable& table = codeBlock->addSwitchJumpTable();
+        table.min = read32();
+        readVector(table.branchOffsets);
+    }
+
+    uint32_t stringSwitchJumpTableCount = readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < stringSwitchJumpTableCount && !m_failed; ++i) {
+        UnlinkedStringJumpTable& table = codeBlock->addStringSwitchJumpTable();
+        uint32_t size = readCount();
+        for (uint32_t j = 0; j < size && !m_failed; ++j) {
+            String string = readString();
+            int32_t branchOffset = read32();
+            if (m_failed || string.isNull())
+                return nullptr;
+            table.offsetTable.add(AtomicString(string).impl(), UnlinkedStringJumpTable::OffsetLocation { branchOffset });
+        }
+    }
+
+    readVector(rareData.m_expressionInfoFatPositions);
+
+    uint32_t typeProfilerInfoCount = readCount(3 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < typeProfilerInfoCount && !m_failed; ++i) {
+        unsigned instructionOffset = read32();
+        unsigned startDivot = read32();
+        unsigned endDivot = read32();
+        rareData.m_typeProfilerInfoMap.set(instructionOffset, UnlinkedCodeBlock::RareData::TypeProfilerExpressionRange { startDivot, endDivot });
+    }
+
+    uint32_t controlFlowOffsetCount = readCount(sizeof(uint64_t));
+    for (uint32_t i = 0; i < controlFlowOffsetCount && !m_failed; ++i)
+        rareData.m_opProfileControlFlowBytecodeOffsets.append(read64());
+
+    if (m_failed)
+        return nullptr;
+    return codeBlock;
+}
+
+UnlinkedProgramCodeBlock* BytecodeCacheDecoder::readProgramCodeBlock(int sourceStartOffset)
+{
+    UnlinkedProgramCodeBlock* codeBlock = readCodeBlock<UnlinkedProgramCodeBlock>(sourceStartOffset, [&] (CodeType codeType, const ExecutableInfo& info, DebuggerMode debuggerMode) {
+        if (codeType != GlobalCode)
+            fail();
+        return UnlinkedProgramCodeBlock::create(&m_vm, info, debuggerMode);
+    });
+    if (!codeBlock)
+        return nullptr;
+
+    VariableEnvironment variableDeclarations;
+    readVariableEnvironment(variableDeclarations);
+    VariableEnvironment lexicalDeclarations;
+    readVariableEnvironment(lexicalDeclarations);
+    if (m_failed)
+        return nullptr;
+    codeBlock->setVariableDeclarations(variableDeclarations);
+    codeBlock->setLexicalDeclarations(lexicalDeclarations);
+    return codeBlock;
+}
+
+UnlinkedFunctionCodeBlock* BytecodeCacheDecoder::readFunctionCodeBlock(int sourceStartOffset)
+{
+    return readCodeBlock<UnlinkedFunctionCodeBlock>(sourceStartOffset, [&] (CodeType codeType, const ExecutableInfo& info, DebuggerMode debuggerMode) {
+        if (codeType != FunctionCode)
+            fail();
+        return UnlinkedFunctionCodeBlock::create(&m_vm, FunctionCode, info, debuggerMode);
+    });
+}
+
+RefPtr<BytecodeCacheFile> BytecodeCacheFile::open(const CString& path)
+{
+#if OS(UNIX)
+    int fd = ::open(path.data(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) || fileStat.st_size < static_cast<off_t>(sizeof(BytecodeCacheHeader))) {
+        close(fd);
+        return nullptr;
+    }
+
+    size_t size = fileStat.st_size;
+    void* buffer = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (buffer == MAP_FAILED)
+        return nullptr;
+
+    return adoptRef(new BytecodeCacheFile(static_cast<const uint8_t*>(buffer), size));
+#else
+    UNUSED_PARAM(path);
+    return nullptr;
+#endif
+}
+
+BytecodeCacheFile::~BytecodeCacheFile()
+{
+#if OS(UNIX)
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+bool isBytecodeCacheEnabled(VM& vm)
+{
+#if OS(UNIX)
+    // The profilers attach data to unlinked code that we do not persist.
+    return Options::diskCachePath() && Options::useCodeCache() && !vm.typeProfiler() && !vm.controlFlowProfiler();
+#else
+    UNUSED_PARAM(vm);
+    return false;
+#endif
+}
+
+static SHA1::Digest computeKeyDigest(const SourceCodeKey& key)
+{
+    SHA1 sha1;
+    uint32_t flags = key.flags().bits();
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(&flags), sizeof(flags));
+    CString name = key.name().utf8();
+    uint32_t nameLength = name.length();
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(&nameLength), sizeof(nameLength));
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(name.data()), name.length());
+
+    StringView source = key.string();
+    uint8_t is8Bit = source.is8Bit();
+    sha1.addBytes(&is8Bit, sizeof(is8Bit));
+    if (source.is8Bit())
+        sha1.addBytes(source.characters8(), source.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters16()), source.length() * sizeof(UChar));
+
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    return digest;
+}
+
+static std::atomic<unsigned> bytecodeCacheHitCount;
+
+unsigned numberOfBytecodeCacheHits()
+{
+    return bytecodeCacheHitCount.load();
+}
+
+static SHA1::Digest computePayloadDigest(const uint8_t* payload, size_t size)
+{
+    SHA1 sha1;
+    sha1.addBytes(payload, size);
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    return digest;
+}
+
+static CString cacheFilePath(const SHA1::Digest& keyDigest)
+{
+    return String::format("%s/%s.jscbytecode", Options::diskCachePath(), SHA1::hexDigest(keyDigest).data()).utf8();
+}
+
+UnlinkedProgramCodeBlock* readProgramCodeBlockFromBytecodeCache(VM& vm, const SourceCodeKey& key, const SourceCode& source)
+{
+    if (!isBytecodeCacheEnabled(vm) || Options::functionOverrides())
+        return nullptr;
+
+    SHA1::Digest keyDigest = computeKeyDigest(key);
+    RefPtr<BytecodeCacheFile> file = BytecodeCacheFile::open(cacheFilePath(keyDigest));
+    if (!file)
+        return nullptr;
+
+    BytecodeCacheHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != bytecodeCacheMagic
+        || header.formatVersion != bytecodeCacheFormatVersion
+        || header.bytecodeFingerprint != bytecodeFingerprint()
+        || header.sourceCodeFlags != key.flags().bits()
+        || header.sourceLength != key.length()
+        || header.payloadSize != file->size() - sizeof(header)
+        || header.keyDigest != keyDigest
+        || header.payloadDigest != computePayloadDigest(file->data() + sizeof(header), header.payloadSize))
+        return nullptr;
+
+    DeferGC deferGC(vm.heap);
+    BytecodeCacheDecoder decoder(vm, *file, sizeof(header), source.provider());
+    UnlinkedProgramCodeBlock* codeBlock = decoder.readProgramCodeBlock(source.startOffset());
+    if (decoder.failed())
+        return nullptr;
+    ++bytecodeCacheHitCount;
+    return codeBlock;
+}
+
+UnlinkedFunctionCodeBlock* decodeFunctionCodeBlockFromBytecodeCache(VM& vm, BytecodeCacheFile& file, unsigned offset, const SourceCode& source)
+{
+    DeferGC deferGC(vm.heap);
+    BytecodeCacheDecoder decoder(vm, file, offset, source.provider());
+    UnlinkedFunctionCodeBlock* codeBlock = decoder.readFunctionCodeBlock(source.startOffset());
+    if (decoder.failed())
+        return nullptr;
+    return codeBlock;
+}
+
+static bool writeFile(const CString& path, const BytecodeCacheHeader& header, const Vector<uint8_t>& payload)
+{
+#if OS(UNIX)
+    // Write to a private file first so that readers never observe a partial entry.
+    CString temporaryPath = String::format("%s.%d", path.data(), getCurrentProcessID()).utf8();
+    int fd = ::open(temporaryPath.data(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1)
+        return false;
+
+    auto writeAll = [&] (const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size) {
+            ssize_t written = ::write(fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            bytes += written;
+            size -= written;
+        }
+        return true;
+    };
+
+    bool success = writeAll(&header, sizeof(header)) && writeAll(payload.data(), payload.size());
+    success = !close(fd) && success;
+    if (success)
+        success = !rename(temporaryPath.data(), path.data());
+    if (!success)
+        unlink(temporaryPath.data());
+    return success;
+#else
+    UNUSED_PARAM(path);
+    UNUSED_PARAM(header);
+    UNUSED_PARAM(payload);
+    return false;
+#endif
+}
+
+static WorkQueue& bytecodeCacheWriteQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("com.apple.JavaScriptCore.BytecodeCacheWrite", WorkQueue::Type::Serial, WorkQueue::QOS::Background));
+    return queue.get();
+}
+
+bool writeProgramCodeBlockToBytecodeCache(VM& vm, const SourceCodeKey& key, UnlinkedProgramCodeBlock* codeBlock)
+{
+    if (!isBytecodeCacheEnabled(vm) || Options::functionOverrides())
+        return false;
+
+    BytecodeCacheEncoder encoder(vm, key.source().provider());
+    encoder.writeProgramCodeBlock(codeBlock, key.source().startOffset());
+    if (encoder.failed())
+        return false;
+
+    BytecodeCacheHeader header;
+    header.magic = bytecodeCacheMagic;
+    header.formatVersion = bytecodeCacheFormatVersion;
+    header.bytecodeFingerprint = bytecodeFingerprint();
+    header.sourceCodeFlags = key.flags().bits();
+    header.sourceLength = key.length();
+    header.payloadSize = encoder.buffer().size();
+    header.keyDigest = computeKeyDigest(key);
+
+    // Encoding needs the VM, but hashing the payload and writing the file do not. Memory
+    // pressure should not block on disk; VM teardown waits with waitForBytecodeCacheWrites().
+    CString path = cacheFilePath(header.keyDigest);
+    bytecodeCacheWriteQueue().dispatch([header, path = WTFMove(path), payload = encoder.takeBuffer()] () mutable {
+        header.payloadDigest = computePayloadDigest(payload.data(), payload.size());
+        writeFile(path, header, payload);
+    });
+    return true;
+}
+
+void waitForBytecodeCacheWrites()
+{
+    Lock lock;
+    Condition condition;
+    bool done = false;
+
+    bytecodeCacheWriteQueue().dispatch([&] {
+        LockHolder locker(lock);
+        done = true;
+        condition.notifyOne();
+    });
+
+    LockHolder locker(lock);
+    condition.wait(lock, [&] { return done; });
+}
+
+} // namespace JSC
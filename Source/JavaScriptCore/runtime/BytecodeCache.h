@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <wtf/Noncopyable.h>
+#include <wtf/RefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/text/CString.h>
+
+namespace JSC {
+
+class SourceCode;
+class SourceCodeKey;
+class UnlinkedFunctionCodeBlock;
+class UnlinkedProgramCodeBlock;
+class VM;
+
+// The bytecode cache persists UnlinkedProgramCodeBlocks, together with the tree of
+// UnlinkedFunctionExecutables they own, in Options::diskCachePath(). Each entry is a
+// single file named after a digest of its SourceCodeKey and source text. Files are
+// memory mapped when read: the program code block and the function executables are
+// decoded right away, but the code blocks of nested functions stay in the mapping
+// until the function is first called. Writes are encoded on the calling thread and
+// flushed to disk from a background queue; VM::flushBytecodeCache() waits for them.
+class BytecodeCacheFile : public ThreadSafeRefCounted<BytecodeCacheFile> {
+    WTF_MAKE_NONCOPYABLE(BytecodeCacheFile);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static RefPtr<BytecodeCacheFile> open(const CString& path);
+    ~BytecodeCacheFile();
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    BytecodeCacheFile(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+};
+
+bool isBytecodeCacheEnabled(VM&);
+
+UnlinkedProgramCodeBlock* readProgramCodeBlockFromBytecodeCache(VM&, const SourceCodeKey&, const SourceCode&);
+bool writeProgramCodeBlockToBytecodeCache(VM&, const SourceCodeKey&, UnlinkedProgramCodeBlock*);
+// Blocks until every write started so far has reached the disk.
+void waitForBytecodeCacheWrites();
+
+// The number of program code blocks read from the cache so far, for testing.
+JS_EXPORT_PRIVATE unsigned numberOfBytecodeCacheHits();
+
+UnlinkedFunctionCodeBlock* decodeFunctionCodeBlockFromBytecodeCache(VM&, BytecodeCacheFile&, unsigned offset, const SourceCode&);
+
+} // namespace JSC
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "CodeCache.h"
 
+#include "BytecodeCache.h"
 #include "IndirectEvalExecutable.h"
 
 namespace JSC {
@@ -48,6 +49,31 @@ void CodeCacheMap::pruneSlowCase()
     }
 }
 
+template <class UnlinkedCodeBlockType, class ExecutableType>
+static void recordCachedParse(ExecutableType* executable, UnlinkedCodeBlockType* unlinkedCodeBlock, const SourceCode& source)
+{
+    unsigned lineCount = unlinkedCodeBlock->lineCount();
+    unsigned startColumn = unlinkedCodeBlock->startColumn() + source.startColumn().oneBasedInt();
+    bool endColumnIsOnStartLine = !lineCount;
+    unsigned endColumn = unlinkedCodeBlock->endColumn() + (endColumnIsOnStartLine ? startColumn : 1);
+    executable->recordParse(unlinkedCodeBlock->codeFeatures(), unlinkedCodeBlock->hasCapturedVariables(), source.firstLine().oneBasedInt() + lineCount, endColumn);
+    source.provider()->setSourceURLDirective(unlinkedCodeBlock->sourceURLDirective());
+    source.provider()->setSourceMappingURLDirective(unlinkedCodeBlock->sourceMappingURLDirective());
+}
+
+// Only program code is kept in the bytecode cache.
+template <class UnlinkedCodeBlockType>
+static UnlinkedCodeBlockType* readFromBytecodeCache(VM&, const SourceCodeKey&, const SourceCode&)
+{
+    return nullptr;
+}
+
+template <>
+UnlinkedProgramCodeBlock* readFromBytecodeCache<UnlinkedProgramCodeBlock>(VM& vm, const SourceCodeKey& key, const SourceCode& source)
+{
+    return readProgramCodeBlockFromBytecodeCache(vm, key, source);
+}
+
 template <class UnlinkedCodeBlockType, class ExecutableType>
 UnlinkedCodeBlockType* CodeCache::getUnlinkedGlobalCodeBlock(VM& vm, ExecutableType* executable, const SourceCode& source, JSParserStrictMode strictMode, JSParserScriptMode scriptMode, DebuggerMode debuggerMode, ParserError& error, EvalContextType evalContextType)
 {
@@ -61,13 +87,13 @@ UnlinkedCodeBlockType* CodeCache::getUnlinkedGlobalCodeBlock(VM& vm, ExecutableT
     SourceCodeValue* cache = m_sourceCode.findCacheAndUpdateAge(key);
     if (cache && Options::useCodeCache()) {
         UnlinkedCodeBlockType* unlinkedCodeBlock = jsCast<UnlinkedCodeBlockType*>(cache->cell.get());
-        unsigned lineCount = unlinkedCodeBlock->lineCount();
-        unsigned startColumn = unlinkedCodeBlock->startColumn() + source.startColumn().oneBasedInt();
-        bool endColumnIsOnStartLine = !lineCount;
-        unsigned endColumn = unlinkedCodeBlock->endColumn() + (endColumnIsOnStartLine ? startColumn : 1);
-        executable->recordParse(unlinkedCodeBlock->codeFeatures(), unlinkedCodeBlock->hasCapturedVariables(), source.firstLine().oneBasedInt() + lineCount, endColumn);
-        source.provider()->setSourceURLDirective(unlinkedCodeBlock->sourceURLDirective());
-        source.provider()->setSourceMappingURLDirective(unlinkedCodeBlock->sourceMappingURLDirective());
+        recordCachedParse(executable, unlinkedCodeBlock, source);
+        return unlinkedCodeBlock;
+    }
+
+    if (UnlinkedCodeBlockType* unlinkedCodeBlock = readFromBytecodeCache<UnlinkedCodeBlockType>(vm, key, source)) {
+        recordCachedParse(executable, unlinkedCodeBlock, source);
+        m_sourceCode.addCache(key, SourceCodeValue(vm, unlinkedCodeBlock, m_sourceCode.age(), true));
         return unlinkedCodeBlock;
     }
     
@@ -80,6 +106,20 @@ UnlinkedCodeBlockType* CodeCache::getUnlinkedGlobalCodeBlock(VM& vm, ExecutableT
     return unlinkedCodeBlock;
 }
 
+void CodeCache::write(VM& vm)
+{
+    if (!isBytecodeCacheEnabled(vm))
+        return;
+
+    for (auto& entry : m_sourceCode) {
+        if (entry.value.written)
+            continue;
+        if (UnlinkedProgramCodeBlock* unlinkedCodeBlock = jsDynamicCast<UnlinkedProgramCodeBlock*>(vm, entry.value.cell.get()))
+            writeProgramCodeBlockToBytecodeCache(vm, entry.key, unlinkedCodeBlock);
+        entry.value.written = true;
+    }
+}
+
 UnlinkedProgramCodeBlock* CodeCache::getUnlinkedProgramCodeBlock(VM& vm, ProgramExecutable* executable, const SourceCode& source, JSParserStrictMode strictMode, DebuggerMode debuggerMode, ParserError& error)
 {
     return getUnlinkedGlobalCodeBlock<UnlinkedProgramCodeBlock>(vm, executable, source, strictMode, JSParserScriptMode::Classic, debuggerMode, error, EvalContextType::None);
@@ -65,14 +65,16 @@ struct SourceCodeValue {
     {
     }
 
-    SourceCodeValue(VM& vm, JSCell* cell, int64_t age)
+    SourceCodeValue(VM& vm, JSCell* cell, int64_t age, bool written = false)
         : cell(vm, cell)
         , age(age)
+        , written(written)
     {
     }
 
     Strong<JSCell> cell;
     int64_t age;
+    bool written { false }; // Whether the bytecode cache on disk already has this entry.
 };
 
 class CodeCacheMap {
@@ -132,6 +134,9 @@ public:
         return addResult;
     }
 
+    iterator begin() { return m_map.begin(); }
+    iterator end() { return m_map.end(); }
+
     void remove(iterator it)
     {
         m_size -= it->key.length();
@@ -200,6 +205,9 @@ public:
 
     void clear() { m_sourceCode.clear(); }
 
+    // Persists cached program code to the bytecode cache, if it is enabled.
+    void write(VM&);
+
 private:
     template <class UnlinkedCodeBlockType, class ExecutableType> 
     UnlinkedCodeBlockType* getUnlinkedGlobalCodeBlock(VM&, ExecutableType*, const SourceCode&, JSParserStrictMode, JSParserScriptMode, DebuggerMode, ParserError&, EvalContextType);
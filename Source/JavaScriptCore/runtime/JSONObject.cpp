@@ -39,6 +39,8 @@
 #include "ObjectConstructor.h"
 #include "JSCInlines.h"
 #include "PropertyNameArray.h"
+#include "StrongInlines.h"
+#include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
 #include <wtf/text/StringBuilder.h>
 
@@ -91,6 +93,21 @@ public:
     void visitAggregate(SlotVisitor&);
 
 private:
+    // For plain objects whose Structure has only ordinary data properties, we remember the
+    // enumeration order, offsets and quoted names of the properties, so that arrays of
+    // same-shaped objects don't pay for getOwnPropertyNames and a lookup per property.
+    struct CachedProperty {
+        Identifier name;
+        PropertyOffset offset;
+        String quotedNameAndColon;
+    };
+    struct CachedShape {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Strong<Structure> structure;
+        Vector<CachedProperty> properties;
+    };
+
     class Holder {
     public:
         enum RootHolderTag { RootHolder };
@@ -109,10 +126,14 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        Structure* m_structure;
+        const CachedShape* m_cachedShape;
     };
 
     friend class Holder;
 
+    const CachedShape* cachedShapeFor(JSObject*);
+
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
     JSValue toJSONImpl(JSValue value, JSValue toJSONFunction, const PropertyNameForFunctionCall&);
 
@@ -133,6 +154,7 @@ private:
     String m_gap;
 
     Vector<Holder, 16, UnsafeVectorOverflow> m_holderStack;
+    HashMap<Structure*, std::unique_ptr<CachedShape>> m_shapeCache;
     String m_repeatedGap;
     String m_indent;
 };
@@ -409,6 +431,53 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
     return StringifySucceeded;
 }
 
+const Stringifier::CachedShape* Stringifier::cachedShapeFor(JSObject* object)
+{
+    static const unsigned maximumCachedShapes = 64;
+
+    if (m_usingArrayReplacer || m_replacerCallType != CallType::None)
+        return nullptr;
+
+    VM& vm = m_exec->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    Structure* structure = object->structure(vm);
+    if (object->type() != FinalObjectType
+        || structure->isDictionary()
+        || structure->hasGetterSetterProperties()
+        || structure->hasCustomGetterSetterProperties()
+        || hasIndexedProperties(structure->indexingType()))
+        return nullptr;
+
+    auto iter = m_shapeCache.find(structure);
+    if (iter != m_shapeCache.end())
+        return iter->value.get();
+    if (m_shapeCache.size() >= maximumCachedShapes)
+        return nullptr;
+
+    PropertyNameArray propertyNames(m_exec, PropertyNameMode::Strings);
+    object->methodTable(vm)->getOwnPropertyNames(object, m_exec, propertyNames, EnumerationMode());
+    ASSERT_UNUSED(scope, !scope.exception());
+
+    auto shape = std::make_unique<CachedShape>();
+    shape->structure.set(vm, structure);
+    shape->properties.reserveInitialCapacity(propertyNames.size());
+    for (const Identifier& name : propertyNames) {
+        unsigned attributes;
+        PropertyOffset offset = structure->get(vm, name, attributes);
+        if (!isValidOffset(offset) || (attributes & (Accessor | CustomAccessor))) {
+            // Remember that this shape can't take the fast path.
+            m_shapeCache.add(structure, nullptr);
+            return nullptr;
+        }
+        StringBuilder quotedName;
+        quotedName.appendQuotedJSONString(name.string());
+        quotedName.append(':');
+        shape->properties.uncheckedAppend(CachedProperty { name, offset, quotedName.toString() });
+    }
+
+    return m_shapeCache.add(structure, WTFMove(shape)).iterator->value.get();
+}
+
 inline bool Stringifier::willIndent() const
 {
     return !m_gap.isEmpty();
@@ -446,6 +515,8 @@ inline Stringifier::Holder::Holder(VM& vm, ExecState* exec, JSObject* object)
 #ifndef NDEBUG
     , m_size(0)
 #endif
+    , m_structure(nullptr)
+    , m_cachedShape(nullptr)
 {
 }
 
@@ -457,6 +528,8 @@ inline Stringifier::Holder::Holder(RootHolderTag, VM& vm, JSObject* object)
 #ifndef NDEBUG
     , m_size(0)
 #endif
+    , m_structure(nullptr)
+    , m_cachedShape(nullptr)
 {
 }
 
@@ -480,6 +553,10 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
                 RETURN_IF_EXCEPTION(scope, false);
             }
             builder.append('[');
+        } else if ((m_cachedShape = stringifier.cachedShapeFor(m_object.get()))) {
+            m_structure = m_cachedShape->structure.get();
+            m_size = m_cachedShape->properties.size();
+            builder.append('{');
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
@@ -530,6 +607,36 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         // Append the stringified value.
         stringifyResult = stringifier.appendStringifiedValue(builder, value, *this, index);
         ASSERT(stringifyResult != StringifyFailedDueToUndefinedOrSymbolValue);
+    } else if (m_cachedShape) {
+        const CachedProperty& property = m_cachedShape->properties[index];
+
+        // Get the value. A toJSON function called on a previous value may have reshaped the
+        // object, in which case we look the property up like the generic path does.
+        JSValue value;
+        if (LIKELY(m_object->structure(vm) == m_structure))
+            value = m_object->getDirect(property.offset);
+        else {
+            PropertySlot slot(m_object.get(), PropertySlot::InternalMethodType::Get);
+            if (!m_object->methodTable(vm)->getOwnPropertySlot(m_object.get(), exec, property.name, slot))
+                return true;
+            value = slot.getValue(exec, property.name);
+            RETURN_IF_EXCEPTION(scope, false);
+        }
+
+        rollBackPoint = builder.length();
+
+        // Append the separator string.
+        if (builder[rollBackPoint - 1] != '{')
+            builder.append(',');
+        stringifier.startNewLine(builder);
+
+        // Append the property name.
+        builder.append(property.quotedNameAndColon);
+        if (stringifier.willIndent())
+            builder.append(' ');
+
+        // Append the stringified value.
+        stringifyResult = stringifier.appendStringifiedValue(builder, value, *this, property.name);
     } else {
         // Get the value.
         PropertySlot slot(m_object.get(), PropertySlot::InternalMethodType::Get);
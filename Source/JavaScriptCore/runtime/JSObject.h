@@ -90,6 +90,7 @@ COMPILE_ASSERT(Accessor < FirstInternalAttribute, Accessor_is_below_FirstInterna
 class JSFinalObject;
 
 class JSObject : public JSCell {
+    friend class AuxiliaryEvacuator;
     friend class BatchedTransitionOptimizer;
     friend class JIT;
     friend class JSCell;
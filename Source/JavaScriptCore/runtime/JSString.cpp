@@ -111,6 +111,67 @@ void JSRopeString::visitFibers(SlotVisitor& visitor)
         visitor.append(fiber(i));
 }
 
+bool JSRopeString::findResolvedBaseContaining(unsigned offset, unsigned length, const JSString*& base, unsigned& baseOffset) const
+{
+    ASSERT(isRope());
+    ASSERT(offset + length <= this->length());
+
+    if (isSubstring()) {
+        base = substringBase().get();
+        baseOffset = substringOffset() + offset;
+        return true;
+    }
+
+    if (!length)
+        return false;
+
+    // A walk takes up to s_maxRopeWalkDepth steps and resolving takes length() steps. Give up
+    // once the walks could have paid for resolving, so that reading every character of a rope
+    // in a loop resolves it once and stays linear instead of walking for each character.
+    if (ropeWalkCount() >= this->length() / s_maxRopeWalkDepth)
+        return false;
+    incrementRopeWalkCount();
+
+    const JSRopeString* rope = this;
+    unsigned ropeStart = 0;
+    for (unsigned depth = 0; depth < s_maxRopeWalkDepth; ++depth) {
+        const JSString* fiberContainingRange = nullptr;
+        unsigned fiberStart = ropeStart;
+        for (size_t i = 0; i < s_maxInternalRopeLength && rope->fiber(i); ++i) {
+            const JSString* fiber = rope->fiber(i).get();
+            unsigned fiberEnd = fiberStart + fiber->length();
+            if (offset < fiberEnd) {
+                if (offset + length > fiberEnd)
+                    return false;
+                fiberContainingRange = fiber;
+                break;
+            }
+            fiberStart = fiberEnd;
+        }
+        ASSERT(fiberContainingRange);
+
+        const JSString* fiberBase;
+        unsigned fiberBaseOffset;
+        if (!fiberContainingRange->isRope()) {
+            fiberBase = fiberContainingRange;
+            fiberBaseOffset = 0;
+        } else if (fiberContainingRange->isSubstring()) {
+            const JSRopeString* substring = static_cast<const JSRopeString*>(fiberContainingRange);
+            fiberBase = substring->substringBase().get();
+            fiberBaseOffset = substring->substringOffset();
+        } else {
+            rope = static_cast<const JSRopeString*>(fiberContainingRange);
+            ropeStart = fiberStart;
+            continue;
+        }
+
+        base = fiberBase;
+        baseOffset = fiberBaseOffset + offset - fiberStart;
+        return true;
+    }
+    return false;
+}
+
 static const unsigned maxLengthForOnStackResolve = 2048;
 
 void JSRopeString::resolveRopeInternal8(LChar* buffer) const
@@ -185,6 +185,11 @@ public:
     bool canGetIndex(unsigned i) { return i < length(); }
     JSString* getIndex(ExecState*, unsigned);
 
+    // These look at part of the string without resolving it, which only works for ropes
+    // when the part lies within a single fiber that is not buried too deep.
+    bool tryGetCharacterWithoutResolving(unsigned index, UChar&) const;
+    bool tryGetViewWithoutResolving(unsigned offset, unsigned length, StringView&) const;
+
     static Structure* createStructure(VM&, JSGlobalObject*, JSValue);
 
     static size_t offsetOfLength() { return OBJECT_OFFSETOF(JSString, m_length); }
@@ -222,6 +227,12 @@ protected:
         m_length = length;
     }
 
+    // Ropes count the reads that walked down their fibers instead of resolving them in the
+    // bits of m_flags above Is8Bit. Compiled code only ever looks at Is8Bit.
+    static const unsigned s_ropeWalkCountShift = 1;
+    unsigned ropeWalkCount() const { return m_flags >> s_ropeWalkCountShift; }
+    void incrementRopeWalkCount() const { m_flags += 1u << s_ropeWalkCountShift; }
+
 private:
     mutable unsigned m_flags;
 
@@ -379,6 +390,17 @@ private:
 public:
     static JSString* create(VM& vm, ExecState* exec, JSString* base, unsigned offset, unsigned length)
     {
+        // Slicing a rope only has to resolve it when the slice straddles its fibers.
+        if (base->isRope() && !base->isSubstring()) {
+            const JSString* resolvedBase;
+            unsigned baseOffset;
+            if (jsCast<JSRopeString*>(base)->findResolvedBaseContaining(offset, length, resolvedBase, baseOffset)) {
+                if (!baseOffset && length == resolvedBase->length())
+                    return const_cast<JSString*>(resolvedBase);
+                return createSubstringOfResolved(vm, const_cast<JSString*>(resolvedBase), baseOffset, length);
+            }
+        }
+
         JSRopeString* newString = new (NotNull, allocateCell<JSRopeString>(vm.heap)) JSRopeString(vm);
         newString->finishCreation(vm, exec, base, offset, length);
         return newString;
@@ -398,9 +420,16 @@ public:
 
     void visitFibers(SlotVisitor&);
 
+    // Finds the resolved string that holds the characters in [offset, offset + length) of this
+    // rope, and where they start in it. Fails if the range straddles fibers, if reaching its
+    // fiber would mean walking more than s_maxRopeWalkDepth levels down the rope, or once the
+    // walks so far have cost about as much as resolving the rope would.
+    bool findResolvedBaseContaining(unsigned offset, unsigned length, const JSString*& base, unsigned& baseOffset) const;
+
     static ptrdiff_t offsetOfFibers() { return OBJECT_OFFSETOF(JSRopeString, u); }
 
     static const unsigned s_maxInternalRopeLength = 3;
+    static const unsigned s_maxRopeWalkDepth = 32;
 
 private:
     static JSString* create(VM& vm, JSString* s1, JSString* s2)
@@ -557,6 +586,11 @@ inline const String& JSString::tryGetValue() const
 inline JSString* JSString::getIndex(ExecState* exec, unsigned i)
 {
     ASSERT(canGetIndex(i));
+    if (isRope()) {
+        UChar character;
+        if (tryGetCharacterWithoutResolving(i, character))
+            return jsSingleCharacterString(exec, character);
+    }
     return jsSingleCharacterString(exec, unsafeView(*exec)[i]);
 }
 
@@ -742,6 +776,31 @@ ALWAYS_INLINE StringViewWithUnderlyingString JSString::viewWithUnderlyingString(
     return { m_value, m_value };
 }
 
+inline bool JSString::tryGetViewWithoutResolving(unsigned offset, unsigned length, StringView& view) const
+{
+    if (offset > this->length() || length > this->length() - offset)
+        return false;
+    if (!isRope()) {
+        view = StringView(m_value).substring(offset, length);
+        return true;
+    }
+    const JSString* base;
+    unsigned baseOffset;
+    if (!static_cast<const JSRopeString*>(this)->findResolvedBaseContaining(offset, length, base, baseOffset))
+        return false;
+    view = StringView(base->m_value).substring(baseOffset, length);
+    return true;
+}
+
+inline bool JSString::tryGetCharacterWithoutResolving(unsigned index, UChar& character) const
+{
+    StringView view;
+    if (index >= length() || !tryGetViewWithoutResolving(index, 1, view))
+        return false;
+    character = view[0];
+    return true;
+}
+
 inline bool JSString::isSubstring() const
 {
     return isRope() && static_cast<const JSRopeString*>(this)->isSubstring();
@@ -38,6 +38,10 @@
 #include <wtf/ASCIICType.h>
 #include <wtf/dtoa.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace JSC {
 
 template <typename CharType>
@@ -348,13 +352,49 @@ template <ParserMode mode, typename CharType, UChar terminator> static ALWAYS_IN
     return (c >= ' ' && (mode == StrictJSON || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && mode != StrictJSON);
 }
 
+template <ParserMode mode, char terminator>
+static ALWAYS_INLINE const LChar* skipSafeStringCharacters(const LChar* ptr, const LChar* end)
+{
+#if CPU(X86_SSE2)
+    // Most strings in big JSON payloads are long runs of plain characters, so look for the end of
+    // the run 16 characters at a time. The scalar loop below decides what to do with whatever
+    // character stopped us, which also takes care of tabs in non-strict mode.
+    const __m128i terminatorMask = _mm_set1_epi8(terminator);
+    const __m128i backslashMask = _mm_set1_epi8('\\');
+    const __m128i controlCharacterLimit = _mm_set1_epi8(0x1f);
+    while (end - ptr >= 16) {
+        __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i isControlCharacter = _mm_cmpeq_epi8(_mm_max_epu8(characters, controlCharacterLimit), controlCharacterLimit);
+        __m128i isUnsafe = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(characters, terminatorMask), _mm_cmpeq_epi8(characters, backslashMask)),
+            isControlCharacter);
+        int mask = _mm_movemask_epi8(isUnsafe);
+        if (mask) {
+            ptr += WTF::countTrailingZeros(static_cast<uint32_t>(mask));
+            break;
+        }
+        ptr += 16;
+    }
+#endif
+    while (ptr < end && isSafeStringCharacter<mode, LChar, terminator>(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+template <ParserMode mode, char terminator>
+static ALWAYS_INLINE const UChar* skipSafeStringCharacters(const UChar* ptr, const UChar* end)
+{
+    while (ptr < end && isSafeStringCharacter<mode, UChar, terminator>(*ptr))
+        ++ptr;
+    return ptr;
+}
+
 template <typename CharType>
 template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token)
 {
     ++m_ptr;
     const CharType* runStart = m_ptr;
-    while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
-        ++m_ptr;
+    m_ptr = skipSafeStringCharacters<mode, terminator>(m_ptr, m_end);
     if (LIKELY(m_ptr < m_end && *m_ptr == terminator)) {
         setParserTokenString<CharType>(token, runStart);
         token.stringLength = m_ptr - runStart;
@@ -568,6 +608,31 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
     return TokNumber;
 }
 
+template <typename CharType>
+Structure* LiteralParser<CharType>::structureForObjectStartingWith(const Identifier& firstProperty)
+{
+    JSGlobalObject* globalObject = m_exec->lexicalGlobalObject();
+    auto iter = m_inlineCapacityForFirstProperty.find(firstProperty.impl());
+    if (iter == m_inlineCapacityForFirstProperty.end() || iter->value <= JSFinalObject::defaultInlineCapacity())
+        return globalObject->objectStructureForObjectConstructor();
+    
+    // Objects of the same shape get the same Structure, and so share one chain of property
+    // transitions, without ever having to grow out-of-line storage along the way.
+    return m_exec->vm().prototypeMap.emptyObjectStructureForPrototype(globalObject, globalObject->objectPrototype(), iter->value);
+}
+
+template <typename CharType>
+void LiteralParser<CharType>::didFinishObject(const Identifier& firstProperty, JSObject* object)
+{
+    Structure* structure = object->structure(m_exec->vm());
+    if (structure->isDictionary())
+        return;
+    unsigned propertyCount = std::min(structure->inlineSize() + structure->outOfLineSize(), JSFinalObject::maxInlineCapacity());
+    auto addResult = m_inlineCapacityForFirstProperty.add(firstProperty.impl(), propertyCount);
+    if (!addResult.isNewEntry)
+        addResult.iterator->value = std::min(addResult.iterator->value, propertyCount);
+}
+
 template <typename CharType>
 JSValue LiteralParser<CharType>::parse(ParserState initialState)
 {
@@ -578,6 +643,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
     JSValue lastValue;
     Vector<ParserState, 16, UnsafeVectorOverflow> stateStack;
     Vector<Identifier, 16, UnsafeVectorOverflow> identifierStack;
+    Vector<Identifier, 16, UnsafeVectorOverflow> firstIdentifierStack;
     HashSet<JSObject*> visitedUnderscoreProto;
     while (1) {
         switch(state) {
@@ -624,9 +690,6 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             startParseObject:
             case StartParseObject: {
-                JSObject* object = constructEmptyObject(m_exec);
-                objectStack.append(object);
-
                 TokenType type = m_lexer.next();
                 if (type == TokString || (m_mode != StrictJSON && type == TokIdentifier)) {
                     typename Lexer::LiteralParserTokenPtr identifierToken = m_lexer.currentToken();
@@ -635,6 +698,11 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     else
                         identifierStack.append(makeIdentifier(identifierToken->stringToken16, identifierToken->stringLength));
 
+                    // We wait for the first property name before creating the object, so that we
+                    // can give it the shape of the last object that started with the same name.
+                    objectStack.append(constructEmptyObject(m_exec, structureForObjectStartingWith(identifierStack.last())));
+                    firstIdentifierStack.append(identifierStack.last());
+
                     // Check for colon
                     if (m_lexer.next() != TokColon) {
                         m_parseErrorMessage = ASCIILiteral("Expected ':' before value in object property definition");
@@ -650,8 +718,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
-                lastValue = objectStack.last();
-                objectStack.removeLast();
+                lastValue = constructEmptyObject(m_exec);
                 break;
             }
             doParseObjectStartExpression:
@@ -703,6 +770,8 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
+                didFinishObject(firstIdentifierStack.last(), object);
+                firstIdentifierStack.removeLast();
                 lastValue = objectStack.last();
                 objectStack.removeLast();
                 break;
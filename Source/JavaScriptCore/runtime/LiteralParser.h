@@ -190,6 +190,9 @@ private:
     
     class StackGuard;
     JSValue parse(ParserState);
+    
+    Structure* structureForObjectStartingWith(const Identifier&);
+    void didFinishObject(const Identifier& firstProperty, JSObject*);
 
     ExecState* m_exec;
     typename LiteralParser<CharType>::Lexer m_lexer;
@@ -200,6 +203,12 @@ private:
     std::array<Identifier, MaximumCachableCharacter> m_recentIdentifiers;
     ALWAYS_INLINE const Identifier makeIdentifier(const LChar* characters, size_t length);
     ALWAYS_INLINE const Identifier makeIdentifier(const UChar* characters, size_t length);
+    
+    // The smallest number of named properties among the objects we parsed that started with a given
+    // property name. In the common case of an array of same-shaped objects, this lets us allocate
+    // every object after the first one with enough inline storage for all of its properties, while
+    // differently shaped objects that start with the same name never get more than the smallest used.
+    HashMap<RefPtr<UniquedStringImpl>, unsigned, IdentifierRepHash> m_inlineCapacityForFirstProperty;
 };
 
 } // namespace JSC
@@ -29,6 +29,7 @@
 #include "LLIntCommon.h"
 #include "LLIntData.h"
 #include "SigillCrashAnalyzer.h"
+#include "WasmFaultSignalHandler.h"
 #include <algorithm>
 #include <limits>
 #include <math.h>
@@ -446,6 +447,11 @@ static void recomputeDependentOptions()
 
     if (Options::useSigillCrashAnalyzer())
         enableSigillCrashAnalyzer();
+
+#if ENABLE(WEBASSEMBLY)
+    if (Options::useWebAssemblyFastMemory())
+        Wasm::enableFastMemory();
+#endif
 }
 
 void Options::initialize()
@@ -108,6 +108,7 @@ typedef const char* optionString;
     v(bool, useJIT,    true, Normal, "allows the baseline JIT to be used if true") \
     v(bool, useDFGJIT, true, Normal, "allows the DFG JIT to be used if true") \
     v(bool, useRegExpJIT, true, Normal, "allows the RegExp JIT to be used if true") \
+    v(bool, dumpRegExpJITFallBacks, false, Normal, "dumps the regular expressions that the RegExp JIT could not compile") \
     v(bool, useDOMJIT, true, Normal, "allows the DOMJIT to be used if true") \
     \
     v(bool, reportMustSucceedExecutableAllocations, false, Normal, nullptr) \
@@ -186,6 +187,10 @@ typedef const char* optionString;
     v(bool, useGenerationalGC, true, Normal, nullptr) \
     v(bool, useConcurrentBarriers, true, Normal, nullptr) \
     v(bool, useConcurrentGC, true, Normal, nullptr) \
+    v(bool, useConcurrentSweeping, false, Normal, "build free lists for blocks without destructors on a helper thread after each collection") \
+    v(bool, useAuxiliaryEvacuation, false, Normal, "move butterflies out of sparse auxiliary blocks at the end of full collections") \
+    v(double, auxiliaryEvacuationOccupancyThreshold, 0.25, Normal, "auxiliary blocks whose fraction of live cells is at most this are evacuated") \
+    v(unsigned, maximumAuxiliaryBlocksToEvacuatePerCollection, 64, Normal, nullptr) \
     v(bool, collectContinuously, false, Normal, nullptr) \
     v(double, collectContinuouslyPeriodMS, 1, Normal, nullptr) \
     v(bool, forceFencedBarrier, false, Normal, nullptr) \
@@ -250,6 +255,8 @@ typedef const char* optionString;
     v(unsigned, numberOfFTLCompilerThreads, computeNumberOfWorkerThreads(8, 2) - 1, Normal, nullptr) \
     v(int32, priorityDeltaOfDFGCompilerThreads, computePriorityDeltaOfWorkerThreads(-1, 0), Normal, nullptr) \
     v(int32, priorityDeltaOfFTLCompilerThreads, computePriorityDeltaOfWorkerThreads(-2, 0), Normal, nullptr) \
+    v(unsigned, numberOfWebAssemblyCompilerThreads, computeNumberOfWorkerThreads(16, 2) - 1, Normal, "number of threads shared by all WebAssembly compilations; the thread that requests a compile also helps with it") \
+    v(int32, priorityDeltaOfWebAssemblyCompilerThreads, computePriorityDeltaOfWorkerThreads(-1, 0), Normal, nullptr) \
     \
     v(bool, useProfiler, false, Normal, nullptr) \
     v(bool, disassembleBaselineForProfiler, true, Normal, nullptr) \
@@ -421,9 +428,17 @@ typedef const char* optionString;
     \
     v(bool, useSourceProviderCache, true, Normal, "If false, the parser will not use the source provider cache. It's good to verify everything works when this is false. Because the cache is so successful, it can mask bugs.") \
     v(bool, useCodeCache, true, Normal, "If false, the unlinked byte code cache will not be used.") \
+    v(optionString, diskCachePath, nullptr, Normal, "If set, program bytecode is persisted across runs in this directory.") \
     \
     v(bool, useWebAssembly, true, Normal, "Expose the WebAssembly global object.") \
+    v(bool, useWebAssemblyFastMemory, true, Normal, "If true, WebAssembly memories reserve their whole 32-bit index space and rely on a signal handler instead of explicit bounds checks.") \
     v(bool, simulateWebAssemblyLowMemory, false, Normal, "If true, the Memory object won't mmap the full 'maximum' range and instead will allocate the minimum required amount.") \
+    v(bool, useWebAssemblyTierUp, true, Normal, "If true, WebAssembly functions are first compiled by a fast baseline tier and hot functions are re-compiled with full optimizations in the background.") \
+    v(unsigned, webAssemblyBBQOptimizationLevel, 0, Normal, "B3 optimization level for the WebAssembly baseline tier.") \
+    v(unsigned, webAssemblyOMGOptimizationLevel, 1, Normal, "B3 optimization level for the WebAssembly optimizing tier.") \
+    v(int32, webAssemblyOMGTierUpCount, 5000, Normal, "The countdown before we tier up a WebAssembly function to the optimizing tier.") \
+    v(int32, webAssemblyLoopDecrement, 15, Normal, "The amount the tier up countdown is decremented on each loop back edge.") \
+    v(int32, webAssemblyFunctionEntryDecrement, 1, Normal, "The amount the tier up countdown is decremented on each function entry.") \
 
 enum OptionEquivalence {
     SameOption,
@@ -208,6 +208,7 @@ RegExp::RegExp(VM& vm, const String& patternString, RegExpFlags flags)
     , m_flags(flags)
     , m_constructionError(0)
     , m_numSubpatterns(0)
+    , m_containsBackreferences(false)
 #if ENABLE(REGEXP_TRACING)
     , m_rtMatchOnlyTotalSubjectStringLen(0.0)
     , m_rtMatchTotalSubjectStringLen(0.0)
@@ -225,8 +226,10 @@ void RegExp::finishCreation(VM& vm)
     Yarr::YarrPattern pattern(m_patternString, m_flags, &m_constructionError, vm.stackLimit());
     if (!isValid())
         m_state = ParseError;
-    else
+    else {
         m_numSubpatterns = pattern.m_numSubpatterns;
+        m_containsBackreferences = pattern.m_containsBackreferences;
+    }
 }
 
 void RegExp::destroy(JSCell* cell)
@@ -281,12 +284,13 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && !pattern.containsUnsignedLengthPattern() && !unicode() && vm->canUseRegExpJIT()) {
+    if (!pattern.containsUnsignedLengthPattern() && !unicode() && vm->canUseRegExpJIT()) {
         Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode);
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
             return;
         }
+        noteJITFallBack();
     }
 #else
     UNUSED_PARAM(charSize);
@@ -334,12 +338,15 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && !pattern.containsUnsignedLengthPattern() && !unicode() && vm->canUseRegExpJIT()) {
-        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, Yarr::MatchOnly);
+    if (!pattern.containsUnsignedLengthPattern() && !unicode() && vm->canUseRegExpJIT()) {
+        // Match-only code does not record subpatterns, which back references need to
+        // look at, so we use the full code to answer match-only requests for them.
+        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, pattern.m_containsBackreferences ? Yarr::IncludeSubpatterns : Yarr::MatchOnly);
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
             return;
         }
+        noteJITFallBack();
     }
 #else
     UNUSED_PARAM(charSize);
@@ -365,6 +372,30 @@ bool RegExp::matchConcurrently(VM& vm, const String& s, unsigned startOffset, Ma
     return true;
 }
 
+#if ENABLE(YARR_JIT)
+static std::atomic<unsigned> s_numberOfJITFallBacks;
+
+void RegExp::noteJITFallBack()
+{
+    // We may try to compile for both 8-bit and 16-bit strings, and for both kinds of
+    // matching, but we only count each regular expression once.
+    if (m_regExpBytecode)
+        return;
+    s_numberOfJITFallBacks++;
+    if (Options::dumpRegExpJITFallBacks())
+        dataLog("RegExp JIT fell back to the interpreter for /", m_patternString, "/\n");
+}
+#endif
+
+unsigned RegExp::numberOfJITFallBacks()
+{
+#if ENABLE(YARR_JIT)
+    return s_numberOfJITFallBacks.load();
+#else
+    return 0;
+#endif
+}
+
 void RegExp::deleteCode()
 {
     ConcurrentJSLocker locker(m_lock);
@@ -87,6 +87,10 @@ public:
     bool hasCodeFor(Yarr::YarrCharSize);
     bool hasMatchOnlyCodeFor(Yarr::YarrCharSize);
 
+    // The number of regular expressions, over the lifetime of the process, that we
+    // tried to compile with the JIT but had to run in the interpreter instead.
+    JS_EXPORT_PRIVATE static unsigned numberOfJITFallBacks();
+
     void deleteCode();
 
 #if ENABLE(REGEXP_TRACING)
@@ -126,6 +130,10 @@ private:
     void compileMatchOnly(VM*, Yarr::YarrCharSize);
     void compileIfNecessaryMatchOnly(VM&, Yarr::YarrCharSize);
 
+#if ENABLE(YARR_JIT)
+    void noteJITFallBack();
+#endif
+
 #if ENABLE(YARR_JIT_DEBUG)
     void matchCompareWithInterpreter(const String&, int startOffset, int* offsetVector, int jitResult);
 #endif
@@ -134,6 +142,7 @@ private:
     RegExpFlags m_flags;
     const char* m_constructionError;
     unsigned m_numSubpatterns;
+    bool m_containsBackreferences;
 #if ENABLE(REGEXP_TRACING)
     double m_rtMatchOnlyTotalSubjectStringLen;
     double m_rtMatchTotalSubjectStringLen;
@@ -167,6 +167,8 @@ ALWAYS_INLINE bool RegExp::hasMatchOnlyCodeFor(Yarr::YarrCharSize charSize)
 #if ENABLE(YARR_JIT)
         if (m_state != JITCode)
             return true;
+        if (m_containsBackreferences)
+            return hasCodeFor(charSize);
         if ((charSize == Yarr::Char8) && (m_regExpJITCode.has8BitCodeMatchOnly()))
             return true;
         if ((charSize == Yarr::Char16) && (m_regExpJITCode.has16BitCodeMatchOnly()))
@@ -199,6 +201,18 @@ ALWAYS_INLINE MatchResult RegExp::matchInline(VM& vm, const String& s, unsigned
     compileIfNecessaryMatchOnly(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
 
 #if ENABLE(YARR_JIT)
+    if (m_state == JITCode && m_containsBackreferences) {
+        // See compileMatchOnly(); we run the full code and ignore the subpatterns.
+        Vector<int, 32> subpatterns((m_numSubpatterns + 1) * 2);
+        MatchResult result = s.is8Bit() ?
+            m_regExpJITCode.execute(s.characters8(), startOffset, s.length(), subpatterns.data()) :
+            m_regExpJITCode.execute(s.characters16(), startOffset, s.length(), subpatterns.data());
+#if ENABLE(REGEXP_TRACING)
+        if (!result)
+            m_rtMatchOnlyFoundCount++;
+#endif
+        return result;
+    }
     if (m_state == JITCode) {
         MatchResult result = s.is8Bit() ?
             m_regExpJITCode.execute(s.characters8(), startOffset, s.length()) :
@@ -1069,6 +1069,75 @@ void SamplingProfiler::reportTopBytecodes(PrintStream& out)
     }
 }
 
+void SamplingProfiler::reportCollapsedStackTraces(PrintStream& out)
+{
+    LockHolder locker(m_lock);
+
+    {
+        HeapIterationScope heapIterationScope(m_vm.heap);
+        processUnverifiedStackTraces();
+    }
+
+    // ';' separates frames and a newline separates stacks, so neither may appear in a frame name.
+    auto sanitize = [] (String name) -> String {
+        name.replace(';', ':');
+        name.replace('\n', ' ');
+        return name;
+    };
+
+    auto descriptionForFrame = [&] (StackFrame& frame) -> String {
+        if (frame.frameType != FrameType::Executable || frame.executable->isHostFunction())
+            return makeString(sanitize(frame.displayName(m_vm)), " [native]");
+
+        StringBuilder description;
+        description.append(sanitize(frame.displayName(m_vm)));
+        if (description.isEmpty())
+            description.appendLiteral("(anonymous function)");
+        String url = frame.url();
+        if (!url.isEmpty()) {
+            description.appendLiteral(" (");
+            description.append(sanitize(url));
+            description.append(':');
+            description.appendNumber(frame.functionStartLine());
+            description.append(')');
+        }
+        if (frame.machineLocation)
+            description.appendLiteral(" [inlined]");
+        return description.toString();
+    };
+
+    HashMap<String, size_t> stackCounts;
+    Vector<String> stackOrder;
+    for (StackTrace& stackTrace : m_stackTraces) {
+        if (!stackTrace.frames.size())
+            continue;
+
+        // Frames are stored innermost first, but the collapsed format lists the root first.
+        StringBuilder stack;
+        for (size_t i = stackTrace.frames.size(); i--;) {
+            if (!stack.isEmpty())
+                stack.append(';');
+            stack.append(descriptionForFrame(stackTrace.frames[i]));
+        }
+        auto addResult = stackCounts.add(stack.toString(), 0);
+        if (addResult.isNewEntry)
+            stackOrder.append(addResult.iterator->key);
+        addResult.iterator->value++;
+    }
+
+    for (const String& stack : stackOrder)
+        out.print(stack, " ", stackCounts.get(stack), "\n");
+}
+
+bool SamplingProfiler::reportCollapsedStackTracesToFile(const char* path)
+{
+    auto out = FilePrintStream::open(path, "w");
+    if (!out)
+        return false;
+    reportCollapsedStackTraces(*out);
+    return true;
+}
+
 } // namespace JSC
 
 namespace WTF {
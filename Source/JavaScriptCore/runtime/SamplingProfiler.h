@@ -184,6 +184,12 @@ public:
     JS_EXPORT_PRIVATE void reportTopBytecodes();
     JS_EXPORT_PRIVATE void reportTopBytecodes(PrintStream&);
 
+    // Writes one "outermost;...;innermost count" line per distinct stack, the "collapsed stack"
+    // format understood by flamegraph.pl and speedscope. Native frames are
+    // tagged with " [native]" and frames inlined by the DFG or FTL with " [inlined]".
+    JS_EXPORT_PRIVATE void reportCollapsedStackTraces(PrintStream&);
+    JS_EXPORT_PRIVATE bool reportCollapsedStackTracesToFile(const char* path);
+
 private:
     void createThreadIfNecessary(const LockHolder&);
     void timerLoop();
@@ -925,11 +925,15 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(*exec);
-    RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
+    JSString* string = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
     JSValue a0 = exec->argument(0);
+    UChar character;
+    if (a0.isUInt32() && string->tryGetCharacterWithoutResolving(a0.asUInt32(), character))
+        return JSValue::encode(jsSingleCharacterString(exec, character));
+    auto viewWithString = string->viewWithUnderlyingString(*exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    StringView view = viewWithString.view;
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < view.length())
@@ -950,10 +954,15 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
-    auto viewWithString = thisValue.toString(exec)->viewWithUnderlyingString(*exec);
+    JSString* string = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
-    StringView view = viewWithString.view;
     JSValue a0 = exec->argument(0);
+    UChar character;
+    if (a0.isUInt32() && string->tryGetCharacterWithoutResolving(a0.asUInt32(), character))
+        return JSValue::encode(jsNumber(character));
+    auto viewWithString = string->viewWithUnderlyingString(*exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    StringView view = viewWithString.view;
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < view.length())
@@ -1901,7 +1910,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncStartsWith(ExecState* exec)
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->argument(0);
@@ -1918,12 +1927,19 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncStartsWith(ExecState* exec)
     if (positionArg.isInt32())
         start = std::max(0, positionArg.asInt32());
     else {
-        unsigned length = stringToSearchIn.length();
+        unsigned length = stringToSearchIn->length();
         start = clampAndTruncateToUnsigned(positionArg.toInteger(exec), 0, length);
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.hasInfixStartingAt(searchString, start)));
+    // Checking the start of a string that was built up with += should not resolve all of it.
+    StringView infix;
+    if (stringToSearchIn->tryGetViewWithoutResolving(start, searchString.length(), infix))
+        return JSValue::encode(jsBoolean(infix == StringView(searchString)));
+
+    String string = stringToSearchIn->value(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    return JSValue::encode(jsBoolean(string.hasInfixStartingAt(searchString, start)));
 }
 
 EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
@@ -1935,7 +1951,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec, scope);
 
-    String stringToSearchIn = thisValue.toWTFString(exec);
+    JSString* stringToSearchIn = thisValue.toString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
     JSValue a0 = exec->argument(0);
@@ -1947,7 +1963,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
     String searchString = a0.toWTFString(exec);
     RETURN_IF_EXCEPTION(scope, encodedJSValue());
 
-    unsigned length = stringToSearchIn.length();
+    unsigned length = stringToSearchIn->length();
 
     JSValue endPositionArg = exec->argument(1);
     unsigned end = length;
@@ -1958,7 +1974,15 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncEndsWith(ExecState* exec)
         RETURN_IF_EXCEPTION(scope, encodedJSValue());
     }
 
-    return JSValue::encode(jsBoolean(stringToSearchIn.hasInfixEndingAt(searchString, std::min(end, length))));
+    end = std::min(end, length);
+
+    StringView infix;
+    if (searchString.length() <= end && stringToSearchIn->tryGetViewWithoutResolving(end - searchString.length(), searchString.length(), infix))
+        return JSValue::encode(jsBoolean(infix == StringView(searchString)));
+
+    String string = stringToSearchIn->value(exec);
+    RETURN_IF_EXCEPTION(scope, encodedJSValue());
+    return JSValue::encode(jsBoolean(string.hasInfixEndingAt(searchString, end)));
 }
 
 static EncodedJSValue JSC_HOST_CALL stringIncludesImpl(VM& vm, ExecState* exec, String stringToSearchIn, String searchString, JSValue positionArg)
@@ -32,6 +32,7 @@
 #include "ArgList.h"
 #include "ArrayBufferNeuteringWatchpoint.h"
 #include "BuiltinExecutables.h"
+#include "BytecodeCache.h"
 #include "BytecodeIntrinsicRegistry.h"
 #include "CodeBlock.h"
 #include "CodeCache.h"
@@ -103,6 +104,7 @@
 #include "UnlinkedCodeBlock.h"
 #include "VMEntryScope.h"
 #include "VMInspector.h"
+#include "WasmWorklist.h"
 #include "Watchdog.h"
 #include "WeakGCMapInlines.h"
 #include "WeakMapData.h"
@@ -383,8 +385,15 @@ VM::~VM()
         }
     }
 #endif // ENABLE(DFG_JIT)
+
+#if ENABLE(WEBASSEMBLY)
+    if (Wasm::Worklist* worklist = Wasm::existingWorklistOrNull())
+        worklist->stopAllJobsForVM(*this);
+#endif
     
     waitForAsynchronousDisassembly();
+
+    flushBytecodeCache();
     
     // Clear this first to ensure that nobody tries to remove themselves from it.
     m_perBytecodeProfiler = nullptr;
@@ -586,6 +595,7 @@ void VM::deleteAllLinkedCode(DeleteAllCodeEffort effort)
 void VM::deleteAllCode(DeleteAllCodeEffort effort)
 {
     whenIdle([=] () {
+        m_codeCache->write(*this);
         m_codeCache->clear();
         m_regExpCache->deleteAllCode();
         heap.deleteAllCodeBlocks(effort);
@@ -594,6 +604,14 @@ void VM::deleteAllCode(DeleteAllCodeEffort effort)
     });
 }
 
+void VM::flushBytecodeCache()
+{
+    if (!isBytecodeCacheEnabled(*this))
+        return;
+    m_codeCache->write(*this);
+    waitForBytecodeCacheWrites();
+}
+
 SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
 {
     auto addResult = sourceProviderCacheMap.add(sourceProvider, nullptr);
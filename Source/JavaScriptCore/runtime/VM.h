@@ -637,6 +637,8 @@ public:
     JS_EXPORT_PRIVATE void whenIdle(std::function<void()>);
 
     JS_EXPORT_PRIVATE void deleteAllCode(DeleteAllCodeEffort);
+    // Writes the program code compiled so far to the bytecode cache and waits until it is on disk.
+    JS_EXPORT_PRIVATE void flushBytecodeCache();
     JS_EXPORT_PRIVATE void deleteAllLinkedCode(DeleteAllCodeEffort);
 
     WatchpointSet* ensureWatchpointSetForImpureProperty(const Identifier&);
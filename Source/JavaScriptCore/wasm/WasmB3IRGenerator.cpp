@@ -28,6 +28,7 @@
 
 #if ENABLE(WEBASSEMBLY)
 
+#include "AirCode.h"
 #include "B3BasicBlockInlines.h"
 #include "B3CCallValue.h"
 #include "B3Compile.h"
@@ -51,6 +52,7 @@
 #include "WasmExceptionType.h"
 #include "WasmFunctionParser.h"
 #include "WasmMemory.h"
+#include "WasmOMGPlan.h"
 #include <wtf/Optional.h>
 
 void dumpProcedure(void* ptr)
@@ -155,7 +157,7 @@ public:
             return fail(__VA_ARGS__);             \
     } while (0)
 
-    B3IRGenerator(VM&, const ModuleInformation&, Procedure&, WasmInternalFunction*, Vector<UnlinkedWasmToWasmCall>&);
+    B3IRGenerator(VM&, const ModuleInformation&, Procedure&, WasmInternalFunction*, Vector<UnlinkedWasmToWasmCall>&, Memory::Mode, uint32_t functionIndex, OMGPlan* tierUp);
 
     PartialResult WARN_UNUSED_RETURN addArguments(const Signature*);
     PartialResult WARN_UNUSED_RETURN addLocal(Type, uint32_t);
@@ -207,6 +209,7 @@ public:
 
 private:
     ExpressionType emitCheckAndPreparePointer(ExpressionType pointer, uint32_t offset, uint32_t sizeOfOp);
+    B3::Kind memoryKind(B3::Opcode memoryOp);
     ExpressionType emitLoadOp(LoadOpType, Origin, ExpressionType pointer, uint32_t offset);
     void emitStoreOp(StoreOpType, Origin, ExpressionType pointer, ExpressionType value, uint32_t offset);
 
@@ -216,6 +219,8 @@ private:
 
     void emitChecksForModOrDiv(B3::Opcode, ExpressionType left, ExpressionType right);
 
+    void emitTierUpCheck(int32_t decrement);
+
     VM& m_vm;
     const ModuleInformation& m_info;
     Procedure& m_proc;
@@ -224,15 +229,21 @@ private:
     Vector<UnlinkedWasmToWasmCall>& m_unlinkedWasmToWasmCalls; // List each call site and the function index whose address it should be patched with.
     GPRReg m_memoryBaseGPR;
     GPRReg m_memorySizeGPR;
+    Memory::Mode m_mode;
+    uint32_t m_functionIndex;
+    OMGPlan* m_tierUp;
     Value* m_zeroValues[numTypes];
     Value* m_instanceValue;
 };
 
-B3IRGenerator::B3IRGenerator(VM& vm, const ModuleInformation& info, Procedure& procedure, WasmInternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls)
+B3IRGenerator::B3IRGenerator(VM& vm, const ModuleInformation& info, Procedure& procedure, WasmInternalFunction* compilation, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, Memory::Mode mode, uint32_t functionIndex, OMGPlan* tierUp)
     : m_vm(vm)
     , m_info(info)
     , m_proc(procedure)
     , m_unlinkedWasmToWasmCalls(unlinkedWasmToWasmCalls)
+    , m_mode(mode)
+    , m_functionIndex(functionIndex)
+    , m_tierUp(tierUp)
 {
     m_currentBlock = m_proc.addBlock();
 
@@ -271,6 +282,35 @@ B3IRGenerator::B3IRGenerator(VM& vm, const ModuleInformation& info, Procedure& p
 
     m_instanceValue = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, pointerType(), Origin(),
         m_currentBlock->appendNew<ConstPtrValue>(m_proc, Origin(), &m_vm.topJSWebAssemblyInstance));
+
+    emitTierUpCheck(TierUpCount::functionEntryDecrement());
+}
+
+void B3IRGenerator::emitTierUpCheck(int32_t decrement)
+{
+    if (!m_tierUp)
+        return;
+
+    Origin origin;
+    Value* countAddress = m_currentBlock->appendNew<ConstPtrValue>(m_proc, origin, m_tierUp->tierUpCount(m_functionIndex).counterAddress());
+    Value* oldCount = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, countAddress);
+    Value* newCount = m_currentBlock->appendNew<Value>(m_proc, Sub, origin, oldCount, m_currentBlock->appendNew<Const32Value>(m_proc, origin, decrement));
+    m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin, newCount, countAddress);
+
+    BasicBlock* tierUp = m_proc.addBlock();
+    BasicBlock* continuation = m_proc.addBlock();
+    Value* shouldTierUp = m_currentBlock->appendNew<Value>(m_proc, LessThan, origin, newCount, m_currentBlock->appendNew<Const32Value>(m_proc, origin, 0));
+    m_currentBlock->appendNewControlValue(m_proc, B3::Branch, origin, shouldTierUp, FrequentedBlock(tierUp, FrequencyClass::Rare), FrequentedBlock(continuation));
+
+    void (*triggerTierUp)(ExecState*, OMGPlan*, uint32_t) = OMGPlan::triggerTierUp;
+    tierUp->appendNew<CCallValue>(m_proc, B3::Void, origin, Effects::forCall(),
+        tierUp->appendNew<ConstPtrValue>(m_proc, origin, bitwise_cast<void*>(triggerTierUp)),
+        tierUp->appendNew<B3::Value>(m_proc, B3::FramePointer, origin),
+        tierUp->appendNew<ConstPtrValue>(m_proc, origin, m_tierUp),
+        tierUp->appendNew<Const32Value>(m_proc, origin, m_functionIndex));
+    tierUp->appendNewControlValue(m_proc, Jump, origin, continuation);
+
+    m_currentBlock = continuation;
 }
 
 struct MemoryBaseAndSize {
@@ -456,11 +496,30 @@ inline Value* B3IRGenerator::emitCheckAndPreparePointer(ExpressionType pointer,
 {
     ASSERT(m_memoryBaseGPR && m_memorySizeGPR);
     ASSERT(sizeOfOperation + offset > offset);
-    m_currentBlock->appendNew<WasmBoundsCheckValue>(m_proc, Origin(), pointer, m_memorySizeGPR, sizeOfOperation + offset - 1);
+    switch (m_mode) {
+    case Memory::Mode::BoundsChecking:
+        m_currentBlock->appendNew<WasmBoundsCheckValue>(m_proc, Origin(), pointer, m_memorySizeGPR, sizeOfOperation + offset - 1);
+        break;
+    case Memory::Mode::Signaling:
+        // The pointer is zero extended, so only a large constant offset can reach past the
+        // redzone. Everything else faults on a PROT_NONE page if it is out of bounds.
+        if (static_cast<uint64_t>(offset) + sizeOfOperation > Memory::fastMemoryRedzoneBytes())
+            m_currentBlock->appendNew<WasmBoundsCheckValue>(m_proc, Origin(), pointer, m_memorySizeGPR, sizeOfOperation + offset - 1);
+        break;
+    }
     pointer = m_currentBlock->appendNew<Value>(m_proc, ZExt32, Origin(), pointer);
     return m_currentBlock->appendNew<WasmAddressValue>(m_proc, Origin(), pointer, m_memoryBaseGPR);
 }
 
+inline B3::Kind B3IRGenerator::memoryKind(B3::Opcode memoryOp)
+{
+    // Without an explicit check, the access itself is how we find out about out of bounds
+    // indices, so B3 must neither drop nor move it.
+    if (m_mode == Memory::Mode::Signaling)
+        return trapping(memoryOp);
+    return memoryOp;
+}
+
 inline uint32_t sizeOfLoadOp(LoadOpType op)
 {
     switch (op) {
@@ -490,66 +549,66 @@ inline Value* B3IRGenerator::emitLoadOp(LoadOpType op, Origin origin, Expression
 {
     switch (op) {
     case LoadOpType::I32Load8S: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load8S, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load8S), origin, pointer, offset);
     }
 
     case LoadOpType::I64Load8S: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load8S, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load8S), origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, SExt32, origin, value);
     }
 
     case LoadOpType::I32Load8U: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load8Z, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load8Z), origin, pointer, offset);
     }
 
     case LoadOpType::I64Load8U: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load8Z, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load8Z), origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin, value);
     }
 
     case LoadOpType::I32Load16S: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load16S, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load16S), origin, pointer, offset);
     }
     case LoadOpType::I64Load16S: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load16S, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load16S), origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, SExt32, origin, value);
     }
 
     case LoadOpType::I32Load: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int32, origin, pointer, offset);
     }
 
     case LoadOpType::I64Load32U: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int32, origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, ZExt32, origin, value);
     }
 
     case LoadOpType::I64Load32S: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int32, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int32, origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, SExt32, origin, value);
     }
 
     case LoadOpType::I64Load: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Int64, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Int64, origin, pointer, offset);
     }
 
     case LoadOpType::F32Load: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Float, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Float, origin, pointer, offset);
     }
 
     case LoadOpType::F64Load: {
-        return m_currentBlock->appendNew<MemoryValue>(m_proc, Load, Double, origin, pointer, offset);
+        return m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load), Double, origin, pointer, offset);
     }
 
     // FIXME: B3 doesn't support Load16Z yet. We should lower to that value when
     // it's added. https://bugs.webkit.org/show_bug.cgi?id=165884
     case LoadOpType::I32Load16U: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load16S, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load16S), origin, pointer, offset);
         return m_currentBlock->appendNew<Value>(m_proc, BitAnd, Origin(), value,
                 m_currentBlock->appendNew<Const32Value>(m_proc, Origin(), 0x0000ffff));
     }
     case LoadOpType::I64Load16U: {
-        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, Load16S, origin, pointer, offset);
+        Value* value = m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Load16S), origin, pointer, offset);
         Value* partialResult = m_currentBlock->appendNew<Value>(m_proc, BitAnd, Origin(), value,
                 m_currentBlock->appendNew<Const32Value>(m_proc, Origin(), 0x0000ffff));
 
@@ -631,7 +690,7 @@ inline void B3IRGenerator::emitStoreOp(StoreOpType op, Origin origin, Expression
         FALLTHROUGH;
 
     case StoreOpType::I32Store8:
-        m_currentBlock->appendNew<MemoryValue>(m_proc, Store8, origin, value, pointer, offset);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Store8), origin, value, pointer, offset);
         return;
 
     case StoreOpType::I64Store16:
@@ -639,7 +698,7 @@ inline void B3IRGenerator::emitStoreOp(StoreOpType op, Origin origin, Expression
         FALLTHROUGH;
 
     case StoreOpType::I32Store16:
-        m_currentBlock->appendNew<MemoryValue>(m_proc, Store16, origin, value, pointer, offset);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Store16), origin, value, pointer, offset);
         return;
 
     case StoreOpType::I64Store32:
@@ -650,7 +709,7 @@ inline void B3IRGenerator::emitStoreOp(StoreOpType op, Origin origin, Expression
     case StoreOpType::I32Store:
     case StoreOpType::F32Store:
     case StoreOpType::F64Store:
-        m_currentBlock->appendNew<MemoryValue>(m_proc, Store, origin, value, pointer, offset);
+        m_currentBlock->appendNew<MemoryValue>(m_proc, memoryKind(Store), origin, value, pointer, offset);
         return;
     }
     RELEASE_ASSERT_NOT_REACHED();
@@ -716,6 +775,7 @@ B3IRGenerator::ControlData B3IRGenerator::addLoop(Type signature)
     m_currentBlock->appendNewControlValue(m_proc, Jump, Origin(), body);
     body->addPredecessor(m_currentBlock);
     m_currentBlock = body;
+    emitTierUpCheck(TierUpCount::loopDecrement());
     return ControlData(m_proc, signature, BlockType::Loop, continuation, body);
 }
 
@@ -1107,15 +1167,16 @@ static void createJSToWasmWrapper(VM& vm, CompilationContext& compilationContext
     function.jsToWasmEntrypoint.calleeSaveRegisters = proc.calleeSaveRegisters();
 }
 
-Expected<std::unique_ptr<WasmInternalFunction>, String> parseAndCompile(VM& vm, CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature* signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, const Vector<SignatureIndex>& moduleSignatureIndicesToUniquedSignatureIndices, unsigned optLevel)
+Expected<std::unique_ptr<WasmInternalFunction>, String> parseAndCompile(VM& vm, CompilationContext& compilationContext, const uint8_t* functionStart, size_t functionLength, const Signature* signature, Vector<UnlinkedWasmToWasmCall>& unlinkedWasmToWasmCalls, const ModuleInformation& info, const Vector<SignatureIndex>& moduleSignatureIndicesToUniquedSignatureIndices, Memory::Mode mode, CompilationMode compilationMode, unsigned optLevel, uint32_t functionIndex, OMGPlan* tierUp)
 {
     auto result = std::make_unique<WasmInternalFunction>();
 
-    compilationContext.jsEntrypointJIT = std::make_unique<CCallHelpers>(&vm);
+    if (compilationMode == CompilationMode::BBQMode)
+        compilationContext.jsEntrypointJIT = std::make_unique<CCallHelpers>(&vm);
     compilationContext.wasmEntrypointJIT = std::make_unique<CCallHelpers>(&vm);
 
     Procedure procedure;
-    B3IRGenerator context(vm, info, procedure, result.get(), unlinkedWasmToWasmCalls);
+    B3IRGenerator context(vm, info, procedure, result.get(), unlinkedWasmToWasmCalls, mode, functionIndex, compilationMode == CompilationMode::BBQMode ? tierUp : nullptr);
     FunctionParser<B3IRGenerator> parser(&vm, context, functionStart, functionLength, signature, info, moduleSignatureIndicesToUniquedSignatureIndices);
     WASM_FAIL_IF_HELPER_FAILS(parser.parse());
 
@@ -1129,13 +1190,18 @@ Expected<std::unique_ptr<WasmInternalFunction>, String> parseAndCompile(VM& vm,
         dataLog("Post SSA: ", procedure);
 
     {
+        // Baseline code that will tier up is compiled for compile time, not for code quality.
+        if (compilationMode == CompilationMode::BBQMode && tierUp)
+            procedure.code().setShouldSpillEverything(true);
         B3::prepareForGeneration(procedure, optLevel);
         B3::generate(procedure, *compilationContext.wasmEntrypointJIT);
         compilationContext.wasmEntrypointByproducts = procedure.releaseByproducts();
         result->wasmEntrypoint.calleeSaveRegisters = procedure.calleeSaveRegisters();
     }
 
-    createJSToWasmWrapper(vm, compilationContext, *result, signature, info);
+    // Code compiled by an OMGPlan is reached through the JS entrypoint of the code it replaces.
+    if (compilationMode == CompilationMode::BBQMode)
+        createJSToWasmWrapper(vm, compilationContext, *result, signature, info);
     return WTFMove(result);
 }
 
@@ -31,6 +31,7 @@
 #include "CCallHelpers.h"
 #include "VM.h"
 #include "WasmFormat.h"
+#include "WasmMemory.h"
 #include <wtf/Expected.h>
 
 extern "C" void dumpProcedure(void*);
@@ -38,6 +39,12 @@ extern "C" void dumpProcedure(void*);
 namespace JSC { namespace Wasm {
 
 class MemoryInformation;
+class OMGPlan;
+
+enum class CompilationMode {
+    BBQMode,
+    OMGMode,
+};
 
 struct CompilationContext {
     std::unique_ptr<CCallHelpers> jsEntrypointJIT;
@@ -47,7 +54,9 @@ struct CompilationContext {
     CCallHelpers::Call jsEntrypointToWasmEntrypointCall;
 };
 
-Expected<std::unique_ptr<WasmInternalFunction>, String> parseAndCompile(VM&, CompilationContext&, const uint8_t*, size_t, const Signature*, Vector<UnlinkedWasmToWasmCall>&, const ModuleInformation&, const Vector<SignatureIndex>&, unsigned optLevel = 1);
+// BBQMode is used by Plan and also generates the JS entrypoint. If given an OMGPlan, the code
+// counts its executions so that hot functions can be re-compiled in OMGMode.
+Expected<std::unique_ptr<WasmInternalFunction>, String> parseAndCompile(VM&, CompilationContext&, const uint8_t*, size_t, const Signature*, Vector<UnlinkedWasmToWasmCall>&, const ModuleInformation&, const Vector<SignatureIndex>&, Memory::Mode, CompilationMode, unsigned optLevel, uint32_t functionIndex, OMGPlan* tierUp = nullptr);
 
 } } // namespace JSC::Wasm
 
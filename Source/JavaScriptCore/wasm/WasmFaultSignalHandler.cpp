@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "WasmFaultSignalHandler.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "WasmExceptionType.h"
+#include <mutex>
+#include <wtf/DataLog.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+
+#if HAVE(SIGNAL_H)
+#include <signal.h>
+#endif
+
+#if (OS(DARWIN) || OS(LINUX)) && (CPU(X86_64) || CPU(ARM64)) && HAVE(SIGNAL_H)
+#define WASM_FAULT_HANDLER_SUPPORTED 1
+#else
+#define WASM_FAULT_HANDLER_SUPPORTED 0
+#endif
+
+namespace JSC { namespace Wasm {
+
+namespace {
+const bool verbose = false;
+}
+
+struct FastMemoryRange {
+    uintptr_t start;
+    uintptr_t end;
+};
+
+struct CodeRange {
+    uintptr_t start;
+    uintptr_t end;
+    void* exceptionStub;
+};
+
+// The handler reads these while holding the lock. It only runs on a thread that faulted in
+// WebAssembly code, which never holds the lock itself, so it cannot deadlock.
+static StaticLock registryLock;
+static LazyNeverDestroyed<Vector<FastMemoryRange>> fastMemoryRanges;
+static LazyNeverDestroyed<Vector<CodeRange>> codeRanges;
+static bool fastMemoryIsEnabled;
+
+#if WASM_FAULT_HANDLER_SUPPORTED
+
+static struct sigaction originalSigSegvAction;
+static struct sigaction originalSigBusAction;
+
+static void*& instructionPointer(mcontext_t& context)
+{
+#if OS(DARWIN) && CPU(X86_64)
+    return reinterpret_cast<void*&>(context->__ss.__rip);
+#elif OS(DARWIN) && CPU(ARM64)
+    return reinterpret_cast<void*&>(context->__ss.__pc);
+#elif OS(LINUX) && CPU(X86_64)
+    return reinterpret_cast<void*&>(context.gregs[REG_RIP]);
+#elif OS(LINUX) && CPU(ARM64)
+    return reinterpret_cast<void*&>(context.pc);
+#endif
+}
+
+// This must be GPRInfo::argumentGPR1, which is where throwExceptionFromWasmThunkGenerator()
+// expects the ExceptionType.
+static void setExceptionTypeArgument(mcontext_t& context, ExceptionType type)
+{
+#if OS(DARWIN) && CPU(X86_64)
+    context->__ss.__rsi = static_cast<uint64_t>(type);
+#elif OS(DARWIN) && CPU(ARM64)
+    context->__ss.__x[1] = static_cast<uint64_t>(type);
+#elif OS(LINUX) && CPU(X86_64)
+    context.gregs[REG_RSI] = static_cast<greg_t>(type);
+#elif OS(LINUX) && CPU(ARM64)
+    context.regs[1] = static_cast<uint64_t>(type);
+#endif
+}
+
+static void* exceptionStubForFault(void* faultingInstruction, void* faultingAddress)
+{
+    uintptr_t pc = reinterpret_cast<uintptr_t>(faultingInstruction);
+    uintptr_t address = reinterpret_cast<uintptr_t>(faultingAddress);
+
+    auto locker = holdLock(registryLock);
+    bool isInFastMemory = false;
+    for (const FastMemoryRange& range : fastMemoryRanges.get()) {
+        if (range.start <= address && address < range.end) {
+            isInFastMemory = true;
+            break;
+        }
+    }
+    if (!isInFastMemory)
+        return nullptr;
+
+    for (const CodeRange& range : codeRanges.get()) {
+        if (range.start <= pc && pc < range.end)
+            return range.exceptionStub;
+    }
+    return nullptr;
+}
+
+static void forwardToOriginalHandler(int signal, siginfo_t* info, void* ucontext)
+{
+    struct sigaction& originalAction = signal == SIGBUS ? originalSigBusAction : originalSigSegvAction;
+    if (originalAction.sa_flags & SA_SIGINFO) {
+        originalAction.sa_sigaction(signal, info, ucontext);
+        return;
+    }
+    if (originalAction.sa_handler == SIG_IGN)
+        return;
+    if (originalAction.sa_handler != SIG_DFL) {
+        originalAction.sa_handler(signal);
+        return;
+    }
+
+    // Returning re-executes the faulting instruction, which now takes the default action.
+    struct sigaction defaultAction;
+    defaultAction.sa_handler = SIG_DFL;
+    sigfillset(&defaultAction.sa_mask);
+    defaultAction.sa_flags = 0;
+    sigaction(signal, &defaultAction, nullptr);
+}
+
+static void handleFault(int signal, siginfo_t* info, void* ucontext)
+{
+    mcontext_t& context = static_cast<ucontext_t*>(ucontext)->uc_mcontext;
+    void*& pc = instructionPointer(context);
+    if (void* exceptionStub = exceptionStubForFault(pc, info->si_addr)) {
+        if (verbose)
+            dataLogLn("Wasm fault handler: out of bounds access to ", RawPointer(info->si_addr), " at ", RawPointer(pc));
+        setExceptionTypeArgument(context, ExceptionType::OutOfBoundsMemoryAccess);
+        pc = exceptionStub;
+        return;
+    }
+
+    forwardToOriginalHandler(signal, info, ucontext);
+}
+
+static bool installFaultHandler()
+{
+    struct sigaction action;
+    action.sa_sigaction = handleFault;
+    sigfillset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO;
+    if (sigaction(SIGSEGV, &action, &originalSigSegvAction))
+        return false;
+    // Darwin reports accesses to PROT_NONE pages as SIGBUS.
+    if (sigaction(SIGBUS, &action, &originalSigBusAction)) {
+        sigaction(SIGSEGV, &originalSigSegvAction, nullptr);
+        return false;
+    }
+    return true;
+}
+
+#else // WASM_FAULT_HANDLER_SUPPORTED
+
+static bool installFaultHandler()
+{
+    return false;
+}
+
+#endif // WASM_FAULT_HANDLER_SUPPORTED
+
+void enableFastMemory()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        fastMemoryRanges.construct();
+        codeRanges.construct();
+        fastMemoryIsEnabled = installFaultHandler();
+    });
+}
+
+bool fastMemoryEnabled()
+{
+    return fastMemoryIsEnabled;
+}
+
+void registerFastMemory(void* base, size_t mappedCapacity)
+{
+    ASSERT(fastMemoryEnabled());
+    uintptr_t start = reinterpret_cast<uintptr_t>(base);
+    auto locker = holdLock(registryLock);
+    fastMemoryRanges->append(FastMemoryRange { start, start + mappedCapacity });
+}
+
+void unregisterFastMemory(void* base)
+{
+    uintptr_t start = reinterpret_cast<uintptr_t>(base);
+    auto locker = holdLock(registryLock);
+    fastMemoryRanges->removeFirstMatching([&] (const FastMemoryRange& range) {
+        return range.start == start;
+    });
+}
+
+void registerCodeForFaultHandling(void* start, size_t size, void* exceptionStub)
+{
+    ASSERT(fastMemoryEnabled());
+    uintptr_t begin = reinterpret_cast<uintptr_t>(start);
+    auto locker = holdLock(registryLock);
+    codeRanges->append(CodeRange { begin, begin + size, exceptionStub });
+}
+
+void unregisterCodeForFaultHandling(void* start)
+{
+    uintptr_t begin = reinterpret_cast<uintptr_t>(start);
+    auto locker = holdLock(registryLock);
+    codeRanges->removeFirstMatching([&] (const CodeRange& range) {
+        return range.start == begin;
+    });
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+namespace JSC { namespace Wasm {
+
+// Fast memories reserve the whole 32-bit index space plus a redzone, so that any access of
+// the form base + zext(index) + offset, with a small enough offset, lands either in the
+// accessible part of the memory or in a PROT_NONE page. Code compiled for such memories
+// skips explicit bounds checks and relies on this handler to turn the resulting fault into
+// an OutOfBoundsMemoryAccess trap.
+
+// Installs the handler. Must be called before any WebAssembly code is compiled, which is
+// why Options::initialize() does it.
+void enableFastMemory();
+bool fastMemoryEnabled();
+
+void registerFastMemory(void* base, size_t mappedCapacity);
+void unregisterFastMemory(void* base);
+
+void registerCodeForFaultHandling(void* start, size_t size, void* exceptionStub);
+void unregisterCodeForFaultHandling(void* start);
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -28,6 +28,7 @@
 
 #if ENABLE(WEBASSEMBLY)
 
+#include "WasmFaultSignalHandler.h"
 #include <wtf/HexNumber.h>
 #include <wtf/PrintStream.h>
 #include <wtf/text/WTFString.h>
@@ -49,6 +50,7 @@ const char* Memory::makeString(Mode mode) const
 {
     switch (mode) {
     case Mode::BoundsChecking: return "BoundsChecking";
+    case Mode::Signaling: return "Signaling";
     }
     RELEASE_ASSERT_NOT_REACHED();
     return "";
@@ -56,16 +58,54 @@ const char* Memory::makeString(Mode mode) const
 
 static_assert(sizeof(uint64_t) == sizeof(size_t), "We rely on allowing the maximum size of Memory we map to be 2^32 which is larger than fits in a 32-bit integer that we'd pass to mprotect if this didn't hold.");
 
+Memory::Mode Memory::defaultMode()
+{
+    return fastMemoryEnabled() ? Mode::Signaling : Mode::BoundsChecking;
+}
+
+size_t Memory::fastMemoryRedzoneBytes()
+{
+    return static_cast<size_t>(PageCount::pageSize) * 128;
+}
+
+size_t Memory::fastMemoryMappedBytes()
+{
+    return static_cast<size_t>(PageCount::max().bytes()) + fastMemoryRedzoneBytes();
+}
+
 Memory::Memory(PageCount initial, PageCount maximum, bool& failed)
     : m_size(initial.bytes())
     , m_initial(initial)
     , m_maximum(maximum)
-    , m_mode(Mode::BoundsChecking)
-    // FIXME: If we add signal based bounds checking then we need extra space for overflow on load.
-    // see: https://bugs.webkit.org/show_bug.cgi?id=162693
+    , m_mode(defaultMode())
 {
     RELEASE_ASSERT(!maximum || maximum >= initial); // This should be guaranteed by our caller.
 
+    if (m_mode == Mode::Signaling) {
+        // Code compiled for this mode assumes the full reservation, so there is no fallback.
+        m_mappedCapacity = fastMemoryMappedBytes();
+        void* result = Options::simulateWebAssemblyLowMemory() ? MAP_FAILED : mmap(nullptr, m_mappedCapacity, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (result == MAP_FAILED) {
+            if (verbose)
+                dataLogLn("Memory::Memory mmap failed for fast memory ", *this);
+            m_mappedCapacity = 0;
+            failed = true;
+            return;
+        }
+
+        if (m_size) {
+            bool success = !mprotect(result, static_cast<size_t>(m_size), PROT_READ | PROT_WRITE);
+            RELEASE_ASSERT(success);
+        }
+
+        m_memory = result;
+        registerFastMemory(m_memory, m_mappedCapacity);
+        failed = false;
+        if (verbose)
+            dataLogLn("Memory::Memory mmap succeeded for fast memory ", *this);
+        return;
+    }
+
     m_mappedCapacity = maximum ? maximum.bytes() : PageCount::max().bytes();
     if (!m_mappedCapacity) {
         // This means we specified a zero as maximum (which means we also have zero as initial size).
@@ -119,6 +159,8 @@ Memory::~Memory()
     if (verbose)
         dataLogLn("Memory::~Memory ", *this);
     if (m_memory) {
+        if (m_mode == Mode::Signaling)
+            unregisterFastMemory(m_memory);
         if (munmap(m_memory, m_mappedCapacity))
             CRASH();
     }
@@ -145,6 +187,9 @@ bool Memory::grow(PageCount newSize)
         return true;
     }
 
+    // Fast memories reserve the maximum size up front and are never moved.
+    RELEASE_ASSERT(m_mode == Mode::BoundsChecking);
+
     // Otherwise, let's try to make some new memory.
     void* newMemory = mmap(nullptr, desiredSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
     if (newMemory == MAP_FAILED)
@@ -42,12 +42,22 @@ class Memory {
 public:
     void dump(WTF::PrintStream&) const;
 
-    // FIXME: We should support other modes. see: https://bugs.webkit.org/show_bug.cgi?id=162693
     enum class Mode {
-        BoundsChecking
+        BoundsChecking,
+        // The whole 32-bit index space plus a redzone is reserved, so out of bounds accesses
+        // fault instead of needing an explicit check. See WasmFaultSignalHandler.h.
+        Signaling
     };
     const char* makeString(Mode) const;
 
+    // The mode all memories and all code are created with in this process.
+    static Mode defaultMode();
+
+    // Accesses whose constant offset plus size stay below this need no explicit bounds
+    // check in Signaling mode.
+    static size_t fastMemoryRedzoneBytes();
+    static size_t fastMemoryMappedBytes();
+
     Memory() = default;
     JS_EXPORT_PRIVATE Memory(PageCount initial, PageCount maximum, bool& failed);
     Memory(Memory&& other)
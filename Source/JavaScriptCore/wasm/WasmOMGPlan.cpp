@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "WasmOMGPlan.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "B3Compilation.h"
+#include "JSCInlines.h"
+#include "JSWebAssemblyCallee.h"
+#include "JSWebAssemblyInstance.h"
+#include "JSWebAssemblyModule.h"
+#include "LinkBuffer.h"
+#include "WasmB3IRGenerator.h"
+#include "WasmWorklist.h"
+#include <wtf/DataLog.h>
+#include <wtf/MonotonicTime.h>
+
+namespace JSC { namespace Wasm {
+
+static const bool verbose = false;
+
+OMGPlan::OMGPlan(VM& vm, Memory::Mode mode, size_t functionCount)
+    : m_vm(vm)
+    , m_mode(mode)
+    , m_tierUpCounts(functionCount)
+    , m_optimizedFunctions(functionCount)
+    , m_optimizedCallSites(functionCount)
+{
+}
+
+OMGPlan::~OMGPlan()
+{
+    if (Worklist* worklist = existingWorklistOrNull())
+        worklist->dequeue(*this);
+}
+
+void OMGPlan::didLinkBaselineCode(const uint8_t* source, size_t sourceLength, const ModuleInformation& moduleInformation, const Vector<FunctionLocationInBinary>& functionLocationInBinary, const Vector<SignatureIndex>& moduleSignatureIndicesToUniquedSignatureIndices, Vector<Vector<UnlinkedWasmToWasmCall>>&& callSites, Vector<CodeLocationCall>&& jsToWasmCalls, Vector<void*>&& wasmEntrypoints, const Vector<WasmExitStubs>& exitStubs)
+{
+    ASSERT(functionLocationInBinary.size() == m_tierUpCounts.size());
+    ASSERT(callSites.size() == m_tierUpCounts.size());
+    ASSERT(jsToWasmCalls.size() == m_tierUpCounts.size());
+    ASSERT(wasmEntrypoints.size() == m_tierUpCounts.size());
+
+    // The buffer the module was compiled from may be detached or modified once compilation is done.
+    m_source.append(source, sourceLength);
+    m_moduleInformation = &moduleInformation;
+    m_functionLocationInBinary = functionLocationInBinary;
+    m_moduleSignatureIndicesToUniquedSignatureIndices = moduleSignatureIndicesToUniquedSignatureIndices;
+    m_callSites = WTFMove(callSites);
+    m_jsToWasmCalls = WTFMove(jsToWasmCalls);
+    m_wasmEntrypoints = WTFMove(wasmEntrypoints);
+    m_exitStubs = exitStubs;
+
+    ensureWorklist().enqueue(*this, Worklist::Priority::TierUp);
+}
+
+void OMGPlan::cancel()
+{
+    if (Worklist* worklist = existingWorklistOrNull())
+        worklist->dequeue(*this);
+
+    LockHolder locker(m_lock);
+    m_moduleInformation = nullptr;
+    m_pendingFunctions.clear();
+    for (TierUpCount& count : m_tierUpCounts) {
+        count.state = TierUpCount::State::Disabled;
+        count.disableTierUp();
+    }
+}
+
+bool OMGPlan::hasWork()
+{
+    LockHolder locker(m_lock);
+    return !m_pendingFunctions.isEmpty();
+}
+
+void OMGPlan::work()
+{
+    uint32_t functionIndex;
+    {
+        LockHolder locker(m_lock);
+        if (m_pendingFunctions.isEmpty())
+            return;
+        functionIndex = m_pendingFunctions.takeFirst();
+    }
+    compileFunction(functionIndex);
+}
+
+void OMGPlan::compileFunction(uint32_t functionIndex)
+{
+    MonotonicTime startTime;
+    if (verbose || Options::reportCompileTimes())
+        startTime = MonotonicTime::now();
+
+    const uint8_t* functionStart = m_source.data() + m_functionLocationInBinary[functionIndex].start;
+    size_t functionLength = m_functionLocationInBinary[functionIndex].end - m_functionLocationInBinary[functionIndex].start;
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
+    const Signature* signature = SignatureInformation::get(&m_vm, signatureIndex);
+
+    CompilationContext context;
+    Vector<UnlinkedWasmToWasmCall> callSites;
+    auto parseAndCompileResult = parseAndCompile(m_vm, context, functionStart, functionLength, signature, callSites, *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices, m_mode, CompilationMode::OMGMode, Options::webAssemblyOMGOptimizationLevel(), functionIndex);
+
+    if (UNLIKELY(!parseAndCompileResult)) {
+        // The baseline tier already compiled this function, so this can only be a resource failure.
+        // Keep running the baseline code.
+        if (verbose)
+            dataLogLn("Failed to tier up WebAssembly function[", functionIndex, "]: ", parseAndCompileResult.error());
+        LockHolder locker(m_lock);
+        m_tierUpCounts[functionIndex].state = TierUpCount::State::Disabled;
+        return;
+    }
+
+    std::unique_ptr<WasmInternalFunction> function = WTFMove(*parseAndCompileResult);
+    {
+        LinkBuffer linkBuffer(m_vm, *context.wasmEntrypointJIT, nullptr, JITCompilationCanFail);
+        if (UNLIKELY(linkBuffer.didFailToAllocate())) {
+            LockHolder locker(m_lock);
+            m_tierUpCounts[functionIndex].state = TierUpCount::State::Disabled;
+            return;
+        }
+
+        String signatureDescription = signature->toString();
+        function->wasmEntrypoint.compilation = std::make_unique<B3::Compilation>(
+            FINALIZE_CODE(linkBuffer, ("WebAssembly OMG function[%i] %s", functionIndex, signatureDescription.ascii().data())),
+            WTFMove(context.wasmEntrypointByproducts));
+    }
+
+    if (verbose || Options::reportCompileTimes())
+        dataLogLn("Took ", (MonotonicTime::now() - startTime).microseconds(), " us to tier up WebAssembly function[", functionIndex, "]");
+
+    LockHolder locker(m_lock);
+    if (m_tierUpCounts[functionIndex].state != TierUpCount::State::Compiling)
+        return;
+    m_optimizedFunctions[functionIndex] = WTFMove(function);
+    m_optimizedCallSites[functionIndex] = WTFMove(callSites);
+    m_tierUpCounts[functionIndex].state = TierUpCount::State::Compiled;
+}
+
+void* OMGPlan::callTarget(const UnlinkedWasmToWasmCall& call) const
+{
+    if (m_moduleInformation->isImportedFunctionFromFunctionIndexSpace(call.functionIndex)) {
+        return call.target == UnlinkedWasmToWasmCall::Target::ToJs
+            ? m_exitStubs.at(call.functionIndex).wasmToJs.code().executableAddress()
+            : m_exitStubs.at(call.functionIndex).wasmToWasm.code().executableAddress();
+    }
+    ASSERT(call.target != UnlinkedWasmToWasmCall::Target::ToJs);
+    return m_wasmEntrypoints.at(call.functionIndex - m_exitStubs.size());
+}
+
+void OMGPlan::install(VM& vm, uint32_t functionIndex)
+{
+    std::unique_ptr<WasmInternalFunction> function;
+    Vector<UnlinkedWasmToWasmCall> callSites;
+    {
+        LockHolder locker(m_lock);
+        function = WTFMove(m_optimizedFunctions[functionIndex]);
+        callSites = WTFMove(m_optimizedCallSites[functionIndex]);
+        m_tierUpCounts[functionIndex].state = TierUpCount::State::Installed;
+    }
+
+    JSWebAssemblyCallee* callee = JSWebAssemblyCallee::create(vm, WTFMove(function->wasmEntrypoint));
+    MacroAssembler::repatchPointer(function->wasmCalleeMoveLocation, callee);
+    vm.topJSWebAssemblyInstance->module()->setOptimizedWasmEntrypointCallee(vm, functionIndex, callee);
+
+    void* entrypoint = callee->entrypoint();
+    m_wasmEntrypoints[functionIndex] = entrypoint;
+
+    for (const UnlinkedWasmToWasmCall& call : callSites)
+        MacroAssembler::repatchCall(call.callLocation, CodeLocationLabel(callTarget(call)));
+    m_callSites[functionIndex].appendVector(callSites);
+
+    // Point every caller we know about at the new code. Baseline code that was copied elsewhere,
+    // such as into tables, keeps running until it returns.
+    size_t functionIndexSpace = m_exitStubs.size() + functionIndex;
+    for (const Vector<UnlinkedWasmToWasmCall>& calls : m_callSites) {
+        for (const UnlinkedWasmToWasmCall& call : calls) {
+            if (call.functionIndex == functionIndexSpace)
+                MacroAssembler::repatchCall(call.callLocation, CodeLocationLabel(entrypoint));
+        }
+    }
+    MacroAssembler::repatchCall(m_jsToWasmCalls[functionIndex], CodeLocationLabel(entrypoint));
+
+    if (verbose)
+        dataLogLn("Installed OMG code for WebAssembly function[", functionIndex, "] at ", RawPointer(entrypoint));
+}
+
+void OMGPlan::triggerTierUp(ExecState* exec, OMGPlan* plan, uint32_t functionIndex)
+{
+    VM& vm = exec->vm();
+    TierUpCount& count = plan->m_tierUpCounts[functionIndex];
+
+    // Code from the jsc shell's test harness runs without an instance. Only the module that owns
+    // this plan knows how to keep the optimized code alive.
+    JSWebAssemblyInstance* instance = vm.topJSWebAssemblyInstance;
+    if (!instance || instance->module()->omgPlan() != plan) {
+        count.disableTierUp();
+        return;
+    }
+
+    Worklist& worklist = ensureWorklist();
+    TierUpCount::State state;
+    {
+        LockHolder locker(plan->m_lock);
+        state = count.state;
+        if (state == TierUpCount::State::NotCompiled) {
+            count.state = TierUpCount::State::Compiling;
+            if (worklist.numberOfThreads())
+                plan->m_pendingFunctions.append(functionIndex);
+        }
+    }
+
+    switch (state) {
+    case TierUpCount::State::NotCompiled:
+        if (!worklist.numberOfThreads()) {
+            // Without compiler threads, compile right away and install on the next check.
+            plan->compileFunction(functionIndex);
+            count.deferTierUp();
+            return;
+        }
+        if (verbose)
+            dataLogLn("Enqueueing WebAssembly function[", functionIndex, "] for tier up");
+        worklist.notifyWorkAvailable();
+        count.deferTierUp();
+        return;
+    case TierUpCount::State::Compiling:
+        count.deferTierUp();
+        return;
+    case TierUpCount::State::Compiled:
+        plan->install(vm, functionIndex);
+        count.disableTierUp();
+        return;
+    case TierUpCount::State::Installed:
+    case TierUpCount::State::Disabled:
+        count.disableTierUp();
+        return;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "CodeLocation.h"
+#include "WasmFormat.h"
+#include "WasmMemory.h"
+#include "WasmTierUpCount.h"
+#include "WasmWorklist.h"
+#include <wtf/Deque.h>
+#include <wtf/Lock.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class ExecState;
+class VM;
+
+namespace Wasm {
+
+// Plan::run() compiles every function of a module with the baseline (BBQ) tier so that the
+// module can start running right away. The OMGPlan outlives it: it keeps a copy of the module
+// bytes and of every direct call site, and re-compiles functions with the optimizing (OMG) tier
+// on the Wasm::Worklist once their TierUpCount fires. The optimized code is installed on the
+// main thread, the next time the baseline code of that function checks in, by repatching its
+// callers.
+class OMGPlan : public ThreadSafeRefCounted<OMGPlan>, public Worklist::Job {
+public:
+    static Ref<OMGPlan> create(VM& vm, Memory::Mode mode, size_t functionCount)
+    {
+        return adoptRef(*new OMGPlan(vm, mode, functionCount));
+    }
+
+    ~OMGPlan() override;
+
+    TierUpCount& tierUpCount(unsigned functionIndex) { return m_tierUpCounts[functionIndex]; }
+
+    // Called by Plan once the baseline code is linked and the whole module has been parsed. Takes
+    // over the direct call sites, which the OMGPlan repatches whenever it installs a new entrypoint.
+    void didLinkBaselineCode(const uint8_t* source, size_t sourceLength, const ModuleInformation&, const Vector<FunctionLocationInBinary>&, const Vector<SignatureIndex>& moduleSignatureIndicesToUniquedSignatureIndices, Vector<Vector<UnlinkedWasmToWasmCall>>&& callSites, Vector<CodeLocationCall>&& jsToWasmCalls, Vector<void*>&& wasmEntrypoints, const Vector<WasmExitStubs>&);
+
+    // Must be called on the main thread before the module information goes away.
+    // Waits for a compilation of this plan that is already running.
+    void cancel();
+
+    static void triggerTierUp(ExecState*, OMGPlan*, uint32_t functionIndex);
+
+    VM& vm() const override { return m_vm; }
+    bool hasWork() override;
+    void work() override;
+
+private:
+    OMGPlan(VM&, Memory::Mode, size_t functionCount);
+
+    void compileFunction(uint32_t functionIndex);
+    void install(VM&, uint32_t functionIndex);
+    void* callTarget(const UnlinkedWasmToWasmCall&) const;
+
+    VM& m_vm;
+    Vector<uint8_t> m_source;
+    const ModuleInformation* m_moduleInformation { nullptr };
+    Vector<FunctionLocationInBinary> m_functionLocationInBinary;
+    Vector<SignatureIndex> m_moduleSignatureIndicesToUniquedSignatureIndices;
+    Memory::Mode m_mode;
+    Vector<TierUpCount> m_tierUpCounts;
+
+    // Only touched on the main thread.
+    Vector<Vector<UnlinkedWasmToWasmCall>> m_callSites;
+    Vector<CodeLocationCall> m_jsToWasmCalls;
+    Vector<void*> m_wasmEntrypoints;
+    Vector<WasmExitStubs> m_exitStubs;
+
+    // Compiled by the background thread, waiting to be installed.
+    Lock m_lock;
+    Deque<uint32_t> m_pendingFunctions;
+    Vector<std::unique_ptr<WasmInternalFunction>> m_optimizedFunctions;
+    Vector<Vector<UnlinkedWasmToWasmCall>> m_optimizedCallSites;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
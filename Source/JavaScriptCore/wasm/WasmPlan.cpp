@@ -38,10 +38,10 @@
 #include "WasmMemory.h"
 #include "WasmModuleParser.h"
 #include "WasmValidate.h"
+#include "WasmWorklist.h"
 #include <wtf/DataLog.h>
 #include <wtf/Locker.h>
 #include <wtf/MonotonicTime.h>
-#include <wtf/NumberOfCores.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/text/StringBuilder.h>
 
@@ -58,26 +58,41 @@ Plan::Plan(VM* vm, const uint8_t* source, size_t sourceLength)
     : m_vm(vm)
     , m_source(source)
     , m_sourceLength(sourceLength)
+    , m_mode(Memory::defaultMode())
 {
 }
 
+Plan::Plan(VM* vm)
+    : m_vm(vm)
+    , m_source(nullptr)
+    , m_sourceLength(0)
+    , m_mode(Memory::defaultMode())
+    , m_isStreaming(true)
+{
+}
+
+bool Plan::parseModule(const uint8_t* source, size_t sourceLength)
+{
+    ModuleParser moduleParser(m_vm, source, sourceLength);
+    auto parseResult = moduleParser.parse();
+    if (!parseResult) {
+        m_errorMessage = parseResult.error();
+        return false;
+    }
+    m_moduleInformation = WTFMove(parseResult->module);
+    m_functionLocationInBinary = WTFMove(parseResult->functionLocationInBinary);
+    m_moduleSignatureIndicesToUniquedSignatureIndices = WTFMove(parseResult->moduleSignatureIndicesToUniquedSignatureIndices);
+    return true;
+}
+
 bool Plan::parseAndValidateModule()
 {
     MonotonicTime startTime;
     if (verbose || Options::reportCompileTimes())
         startTime = MonotonicTime::now();
 
-    {
-        ModuleParser moduleParser(m_vm, m_source, m_sourceLength);
-        auto parseResult = moduleParser.parse();
-        if (!parseResult) {
-            m_errorMessage = parseResult.error();
-            return false;
-        }
-        m_moduleInformation = WTFMove(parseResult->module);
-        m_functionLocationInBinary = WTFMove(parseResult->functionLocationInBinary);
-        m_moduleSignatureIndicesToUniquedSignatureIndices = WTFMove(parseResult->moduleSignatureIndicesToUniquedSignatureIndices);
-    }
+    if (!parseModule(m_source, m_sourceLength))
+        return false;
 
     for (unsigned functionIndex = 0; functionIndex < m_functionLocationInBinary.size(); ++functionIndex) {
         if (verbose)
@@ -85,19 +100,8 @@ bool Plan::parseAndValidateModule()
         const uint8_t* functionStart = m_source + m_functionLocationInBinary[functionIndex].start;
         size_t functionLength = m_functionLocationInBinary[functionIndex].end - m_functionLocationInBinary[functionIndex].start;
         ASSERT(functionLength <= m_sourceLength);
-        SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
-        const Signature* signature = SignatureInformation::get(m_vm, signatureIndex);
-
-        auto validationResult = validateFunction(m_vm, functionStart, functionLength, signature, *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices);
-        if (!validationResult) {
-            if (verbose) {
-                for (unsigned i = 0; i < functionLength; ++i)
-                    dataLog(RawPointer(reinterpret_cast<void*>(functionStart[i])), ", ");
-                dataLogLn();
-            }
-            m_errorMessage = makeString(validationResult.error(), ", in function at index ", String::number(functionIndex)); // FIXME make this an Expected.
+        if (!validateFunction(functionIndex, functionStart, functionLength))
             return false;
-        }
     }
 
     if (verbose || Options::reportCompileTimes())
@@ -105,15 +109,28 @@ bool Plan::parseAndValidateModule()
     return true;
 }
 
-// We are creating a bunch of threads that touch the main thread's stack. This will make ASAN unhappy.
-// The reason this is OK is that we guarantee that the main thread doesn't continue until all threads
-// that could touch its stack are done executing.
-SUPPRESS_ASAN 
-void Plan::run()
+bool Plan::validateFunction(uint32_t functionIndex, const uint8_t* functionStart, size_t functionLength)
 {
-    if (!parseAndValidateModule())
-        return;
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
+    const Signature* signature = SignatureInformation::get(m_vm, signatureIndex);
+
+    auto validationResult = Wasm::validateFunction(m_vm, functionStart, functionLength, signature, *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices);
+    if (!validationResult) {
+        if (verbose) {
+            for (unsigned i = 0; i < functionLength; ++i)
+                dataLog(RawPointer(reinterpret_cast<void*>(functionStart[i])), ", ");
+            dataLogLn();
+        }
+        auto locker = holdLock(m_lock);
+        if (m_errorMessage.isNull())
+            m_errorMessage = makeString(validationResult.error(), ", in function at index ", String::number(functionIndex)); // FIXME make this an Expected.
+        return false;
+    }
+    return true;
+}
 
+bool Plan::prepare()
+{
     auto tryReserveCapacity = [this] (auto& vector, size_t size, const char* what) {
         if (UNLIKELY(!vector.tryReserveCapacity(size))) {
             StringBuilder builder;
@@ -130,7 +147,11 @@ void Plan::run()
         || !tryReserveCapacity(m_unlinkedWasmToWasmCalls, m_functionLocationInBinary.size(), " unlinked WebAssembly to WebAssembly calls")
         || !tryReserveCapacity(m_wasmInternalFunctions, m_functionLocationInBinary.size(), " WebAssembly functions")
         || !tryReserveCapacity(m_compilationContexts, m_functionLocationInBinary.size(), " compilation contexts"))
-        return;
+        return false;
+
+    if (Options::useWebAssemblyTierUp())
+        m_omgPlan = OMGPlan::create(*m_vm, m_mode, m_functionLocationInBinary.size());
+    m_optLevel = m_omgPlan ? Options::webAssemblyBBQOptimizationLevel() : Options::webAssemblyOMGOptimizationLevel();
 
     m_unlinkedWasmToWasmCalls.resize(m_functionLocationInBinary.size());
     m_wasmInternalFunctions.resize(m_functionLocationInBinary.size());
@@ -147,63 +168,301 @@ void Plan::run()
         m_wasmExitStubs.uncheckedAppend(exitStubGenerator(m_vm, m_callLinkInfos, signatureIndex, importFunctionIndex));
     }
 
+    return true;
+}
+
+void Plan::compileFunction(uint32_t functionIndex, const uint8_t* functionStart, size_t functionLength)
+{
+    SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
+    const Signature* signature = SignatureInformation::get(m_vm, signatureIndex);
+    unsigned functionIndexSpace = m_wasmExitStubs.size() + functionIndex;
+    ASSERT_UNUSED(functionIndexSpace, m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace) == signatureIndex);
+    ASSERT(Wasm::validateFunction(m_vm, functionStart, functionLength, signature, *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices));
+
+    m_unlinkedWasmToWasmCalls[functionIndex] = Vector<UnlinkedWasmToWasmCall>();
+    auto parseAndCompileResult = parseAndCompile(*m_vm, m_compilationContexts[functionIndex], functionStart, functionLength, signature, m_unlinkedWasmToWasmCalls[functionIndex], *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices, m_mode, CompilationMode::BBQMode, m_optLevel, functionIndex, m_omgPlan.get());
+
+    if (UNLIKELY(!parseAndCompileResult)) {
+        auto locker = holdLock(m_lock);
+        if (m_errorMessage.isNull()) {
+            // Multiple compiles could fail simultaneously. We arbitrarily choose the first.
+            m_errorMessage = makeString(parseAndCompileResult.error(), ", in function at index ", String::number(functionIndex)); // FIXME make this an Expected.
+        }
+        m_currentIndex = m_functionLocationInBinary.size();
+        return;
+    }
+
+    m_wasmInternalFunctions[functionIndex] = WTFMove(*parseAndCompileResult);
+}
+
+bool Plan::compileNextFunction()
+{
+    if (m_isStreaming) {
+        StreamingTask task;
+        {
+            auto locker = holdLock(m_lock);
+            if (m_streamingTasks.isEmpty())
+                return false;
+            task = m_streamingTasks.takeFirst();
+            if (!m_errorMessage.isNull())
+                return true;
+        }
+
+        if (validateFunction(task.functionIndex, task.body.data(), task.body.size()))
+            compileFunction(task.functionIndex, task.body.data(), task.body.size());
+        return true;
+    }
+
+    uint32_t functionIndex;
+    {
+        auto locker = holdLock(m_lock);
+        if (m_currentIndex >= m_functionLocationInBinary.size())
+            return false;
+        functionIndex = m_currentIndex;
+        ++m_currentIndex;
+    }
+
+    const uint8_t* functionStart = m_source + m_functionLocationInBinary[functionIndex].start;
+    size_t functionLength = m_functionLocationInBinary[functionIndex].end - m_functionLocationInBinary[functionIndex].start;
+    ASSERT(functionLength <= m_sourceLength);
+    compileFunction(functionIndex, functionStart, functionLength);
+    return true;
+}
+
+bool Plan::hasWork()
+{
+    auto locker = holdLock(m_lock);
+    if (m_isStreaming)
+        return !m_streamingTasks.isEmpty();
+    return m_currentIndex < m_functionLocationInBinary.size();
+}
+
+void Plan::work()
+{
+    compileNextFunction();
+}
+
+// The compiler threads touch the main thread's stack. This will make ASAN unhappy.
+// The reason this is OK is that we guarantee that the main thread doesn't continue until all threads
+// that could touch its stack are done executing.
+SUPPRESS_ASAN 
+void Plan::run()
+{
+    ASSERT(!m_isStreaming);
+    if (!parseAndValidateModule())
+        return;
+
+    if (!prepare())
+        return;
+
     m_currentIndex = 0;
 
-    auto doWork = [this] {
-        while (true) {
-            uint32_t functionIndex;
-            {
-                auto locker = holdLock(m_lock);
-                if (m_currentIndex >= m_functionLocationInBinary.size())
-                    return;
-                functionIndex = m_currentIndex;
-                ++m_currentIndex;
+    MonotonicTime startTime;
+    if (verbose || Options::reportCompileTimes())
+        startTime = MonotonicTime::now();
+
+    Worklist& worklist = ensureWorklist();
+    worklist.enqueue(*this, Worklist::Priority::Synchronous);
+    while (compileNextFunction()) { } // Let the main thread do some work too.
+    worklist.dequeue(*this);
+
+    if (m_errorMessage.isNull())
+        complete();
+
+    if (verbose || Options::reportCompileTimes()) {
+        dataLogLn("Took ", (MonotonicTime::now() - startTime).microseconds(),
+            " us to compile and link the module");
+    }
+}
+
+void Plan::appendBytes(const uint8_t* bytes, size_t length)
+{
+    ASSERT(m_isStreaming);
+    if (m_streamingState == StreamingState::Failed)
+        return;
+
+    m_streamingBuffer.append(bytes, length);
+    parseStreamingBuffer();
+}
+
+// Decodes a varuint32 at m_streamingOffset. Returns false if more bytes are needed, and moves
+// to the Failed state if the bytes can't be a varuint32.
+bool Plan::decodeStreamingVarUInt32(uint32_t& result, const char* what)
+{
+    size_t offset = m_streamingOffset;
+    if (WTF::LEBDecoder::decodeUInt32(m_streamingBuffer.data(), m_streamingBuffer.size(), offset, result)) {
+        m_streamingOffset = offset;
+        return true;
+    }
+    static const size_t maxVarUInt32Bytes = 5;
+    if (m_streamingBuffer.size() - m_streamingOffset >= maxVarUInt32Bytes)
+        failStreaming(makeString("WebAssembly.Module doesn't parse at byte ", String::number(m_streamingOffset), ": can't get ", what));
+    return false;
+}
+
+void Plan::failStreaming(const String& message)
+{
+    {
+        auto locker = holdLock(m_lock);
+        if (m_errorMessage.isNull())
+            m_errorMessage = message;
+    }
+    m_streamingState = StreamingState::Failed;
+}
+
+void Plan::parseStreamingBuffer()
+{
+    while (true) {
+        switch (m_streamingState) {
+        case StreamingState::ModuleHeader: {
+            // The magic number and version are checked by the ModuleParser.
+            static const size_t headerSize = 8;
+            if (m_streamingBuffer.size() < headerSize)
+                return;
+            m_streamingOffset = headerSize;
+            m_streamingState = StreamingState::SectionHeader;
+            break;
+        }
+
+        case StreamingState::SectionHeader: {
+            if (m_streamingOffset == m_streamingBuffer.size())
+                return;
+            size_t sectionStart = m_streamingOffset;
+            uint8_t sectionByte = m_streamingBuffer[m_streamingOffset++];
+            uint32_t sectionLength;
+            if (!decodeStreamingVarUInt32(sectionLength, "section length")) {
+                if (m_streamingState != StreamingState::Failed)
+                    m_streamingOffset = sectionStart;
+                return;
             }
+            m_streamingSectionEnd = m_streamingOffset + sectionLength;
 
-            const uint8_t* functionStart = m_source + m_functionLocationInBinary[functionIndex].start;
-            size_t functionLength = m_functionLocationInBinary[functionIndex].end - m_functionLocationInBinary[functionIndex].start;
-            ASSERT(functionLength <= m_sourceLength);
-            SignatureIndex signatureIndex = m_moduleInformation->internalFunctionSignatureIndices[functionIndex];
-            const Signature* signature = SignatureInformation::get(m_vm, signatureIndex);
-            unsigned functionIndexSpace = m_wasmExitStubs.size() + functionIndex;
-            ASSERT_UNUSED(functionIndexSpace, m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace) == signatureIndex);
-            ASSERT(validateFunction(m_vm, functionStart, functionLength, signature, *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices));
+            if (sectionByte != static_cast<uint8_t>(Section::Code)) {
+                m_streamingState = StreamingState::SkipSection;
+                break;
+            }
+
+            // Everything the function bodies depend on precedes the Code section, so we can parse it
+            // now and start compiling while the rest of the module is still arriving.
+            if (!parseModule(m_streamingBuffer.data(), sectionStart) || !prepare()) {
+                m_streamingState = StreamingState::Failed;
+                return;
+            }
+            m_streamingCodeSectionParsed = true;
+            ensureWorklist().enqueue(*this, Worklist::Priority::Compilation);
+            m_streamingState = StreamingState::CodeSectionCount;
+            break;
+        }
+
+        case StreamingState::SkipSection:
+            if (m_streamingBuffer.size() < m_streamingSectionEnd)
+                return;
+            m_streamingOffset = m_streamingSectionEnd;
+            m_streamingState = StreamingState::SectionHeader;
+            break;
+
+        case StreamingState::CodeSectionCount: {
+            uint32_t count;
+            if (!decodeStreamingVarUInt32(count, "Code section's count"))
+                return;
+            if (count != m_functionLocationInBinary.size()) {
+                failStreaming(makeString("Code section count ", String::number(count), " exceeds the declared number of functions ", String::number(m_functionLocationInBinary.size())));
+                return;
+            }
+            m_streamingState = count ? StreamingState::FunctionSize : StreamingState::SkipSection;
+            break;
+        }
+
+        case StreamingState::FunctionSize: {
+            uint32_t functionSize;
+            if (!decodeStreamingVarUInt32(functionSize, "Code function's size"))
+                return;
+            if (m_streamingOffset > m_streamingSectionEnd || functionSize > m_streamingSectionEnd - m_streamingOffset) {
+                failStreaming(makeString("Code function's size ", String::number(functionSize), " exceeds the Code section's remaining size"));
+                return;
+            }
+            FunctionLocationInBinary& location = m_functionLocationInBinary[m_streamingFunctionCount];
+            location.start = m_streamingOffset;
+            location.end = m_streamingOffset + functionSize;
+            m_streamingState = StreamingState::FunctionBody;
+            break;
+        }
 
-            m_unlinkedWasmToWasmCalls[functionIndex] = Vector<UnlinkedWasmToWasmCall>();
-            auto parseAndCompileResult = parseAndCompile(*m_vm, m_compilationContexts[functionIndex], functionStart, functionLength, signature, m_unlinkedWasmToWasmCalls[functionIndex], *m_moduleInformation, m_moduleSignatureIndicesToUniquedSignatureIndices);
+        case StreamingState::FunctionBody: {
+            const FunctionLocationInBinary& location = m_functionLocationInBinary[m_streamingFunctionCount];
+            if (m_streamingBuffer.size() < location.end)
+                return;
 
-            if (UNLIKELY(!parseAndCompileResult)) {
+            // m_streamingBuffer may be reallocated by the next append, so the compiler threads get
+            // their own copy of the body.
+            StreamingTask task;
+            task.functionIndex = m_streamingFunctionCount;
+            task.body.append(m_streamingBuffer.data() + location.start, location.end - location.start);
+            {
                 auto locker = holdLock(m_lock);
-                if (!m_errorMessage) {
-                    // Multiple compiles could fail simultaneously. We arbitrarily choose the first.
-                    m_errorMessage = makeString(parseAndCompileResult.error(), ", in function at index ", String::number(functionIndex)); // FIXME make this an Expected.
-                }
-                m_currentIndex = m_functionLocationInBinary.size();
-
-                // We will terminate on the next execution.
-                continue; 
+                m_streamingTasks.append(WTFMove(task));
             }
+            ensureWorklist().notifyWorkAvailable();
 
-            m_wasmInternalFunctions[functionIndex] = WTFMove(*parseAndCompileResult);
+            m_streamingOffset = location.end;
+            ++m_streamingFunctionCount;
+            m_streamingState = m_streamingFunctionCount < m_functionLocationInBinary.size() ? StreamingState::FunctionSize : StreamingState::SkipSection;
+            break;
         }
-    };
 
-    MonotonicTime startTime;
-    if (verbose || Options::reportCompileTimes())
-        startTime = MonotonicTime::now();
+        case StreamingState::Failed:
+            return;
+        }
+    }
+}
 
-    uint32_t threadCount = Options::useConcurrentJIT() ? WTF::numberOfProcessorCores() : 1;
-    uint32_t numWorkerThreads = threadCount - 1;
-    Vector<ThreadIdentifier> threads;
-    threads.reserveCapacity(numWorkerThreads);
-    for (uint32_t i = 0; i < numWorkerThreads; i++)
-        threads.uncheckedAppend(createThread("jsc.wasm-b3-compilation.thread", doWork));
+void Plan::finishStreaming()
+{
+    ASSERT(m_isStreaming);
 
-    doWork(); // Let the main thread do some work too.
+    // Any functions that are still queued are compiled with the help of the main thread.
+    while (compileNextFunction()) { }
+    if (m_streamingCodeSectionParsed)
+        ensureWorklist().dequeue(*this);
 
-    for (uint32_t i = 0; i < numWorkerThreads; i++)
-        waitForThreadCompletion(threads[i]);
+    if (!m_errorMessage.isNull())
+        return;
+
+    m_source = m_streamingBuffer.data();
+    m_sourceLength = m_streamingBuffer.size();
+
+    if (m_streamingState != StreamingState::SectionHeader || m_streamingOffset != m_sourceLength) {
+        m_errorMessage = makeString("WebAssembly.Module doesn't parse at byte ", String::number(m_streamingOffset), ": unexpected end of module");
+        return;
+    }
 
+    Vector<FunctionLocationInBinary> streamedFunctionLocations = WTFMove(m_functionLocationInBinary);
+
+    // Parse the whole module again to pick up the sections that follow the Code section. This
+    // skips over the function bodies, so it is cheap compared to compiling them.
+    if (!parseModule(m_source, m_sourceLength))
+        return;
+
+    if (!m_streamingCodeSectionParsed) {
+        // A module without code still needs its import stubs.
+        if (!prepare())
+            return;
+    } else if (streamedFunctionLocations.size() != m_functionLocationInBinary.size()) {
+        m_errorMessage = ASCIILiteral("WebAssembly.Module's function and code sections changed while streaming");
+        return;
+    }
+
+    if (m_streamingFunctionCount != m_functionLocationInBinary.size()) {
+        m_errorMessage = makeString("Code section declared ", String::number(m_functionLocationInBinary.size()), " functions but only ", String::number(m_streamingFunctionCount), " were received");
+        return;
+    }
+
+    complete();
+}
+
+void Plan::complete()
+{
+    Vector<CodeLocationCall> jsToWasmCalls(m_functionLocationInBinary.size());
     for (uint32_t functionIndex = 0; functionIndex < m_functionLocationInBinary.size(); functionIndex++) {
         {
             CompilationContext& context = m_compilationContexts[functionIndex];
@@ -218,6 +477,7 @@ void Plan::run()
             {
                 LinkBuffer linkBuffer(*m_vm, *context.jsEntrypointJIT, nullptr);
                 linkBuffer.link(context.jsEntrypointToWasmEntrypointCall, FunctionPtr(m_wasmInternalFunctions[functionIndex]->wasmEntrypoint.compilation->code().executableAddress()));
+                jsToWasmCalls[functionIndex] = linkBuffer.locationOf(context.jsEntrypointToWasmEntrypointCall);
 
                 m_wasmInternalFunctions[functionIndex]->jsToWasmEntrypoint.compilation =
                     std::make_unique<B3::Compilation>(FINALIZE_CODE(linkBuffer, ("JavaScript->WebAssembly entrypoint[%i] %s", functionIndex, signatureDescription.ascii().data())), WTFMove(context.jsEntrypointByproducts));
@@ -225,11 +485,6 @@ void Plan::run()
         }
     }
 
-    if (verbose || Options::reportCompileTimes()) {
-        dataLogLn("Took ", (MonotonicTime::now() - startTime).microseconds(),
-            " us to compile and link the module");
-    }
-
     // Patch the call sites for each WebAssembly function.
     for (auto& unlinked : m_unlinkedWasmToWasmCalls) {
         for (auto& call : unlinked) {
@@ -247,6 +502,13 @@ void Plan::run()
         }
     }
 
+    if (m_omgPlan) {
+        Vector<void*> wasmEntrypoints(m_wasmInternalFunctions.size());
+        for (unsigned functionIndex = 0; functionIndex < m_wasmInternalFunctions.size(); ++functionIndex)
+            wasmEntrypoints[functionIndex] = m_wasmInternalFunctions[functionIndex]->wasmEntrypoint.compilation->code().executableAddress();
+        m_omgPlan->didLinkBaselineCode(m_source, m_sourceLength, *m_moduleInformation, m_functionLocationInBinary, m_moduleSignatureIndicesToUniquedSignatureIndices, WTFMove(m_unlinkedWasmToWasmCalls), WTFMove(jsToWasmCalls), WTFMove(wasmEntrypoints), m_wasmExitStubs);
+    }
+
     m_failed = false;
 }
 
@@ -266,7 +528,14 @@ void Plan::initializeCallees(JSGlobalObject* globalObject, std::function<void(un
     }
 }
 
-Plan::~Plan() { }
+Plan::~Plan()
+{
+    // A streaming plan can be abandoned before the module has fully arrived.
+    if (m_isStreaming) {
+        if (Worklist* worklist = existingWorklistOrNull())
+            worklist->dequeue(*this);
+    }
+}
 
 } } // namespace JSC::Wasm
 
@@ -31,7 +31,10 @@
 #include "VM.h"
 #include "WasmB3IRGenerator.h"
 #include "WasmFormat.h"
+#include "WasmOMGPlan.h"
+#include "WasmWorklist.h"
 #include <wtf/Bag.h>
+#include <wtf/Deque.h>
 #include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Vector.h>
 
@@ -43,16 +46,23 @@ class JSWebAssemblyCallee;
 
 namespace Wasm {
 
-class Plan {
+class Plan : public Worklist::Job {
 public:
     JS_EXPORT_PRIVATE Plan(VM*, Vector<uint8_t>);
     JS_EXPORT_PRIVATE Plan(VM*, const uint8_t*, size_t);
-    JS_EXPORT_PRIVATE ~Plan();
+    // Creates a plan that is fed with appendBytes() as the module arrives, and completed with
+    // finishStreaming() instead of run(). Function bodies are compiled on the Wasm::Worklist as
+    // soon as they are complete, so most of the compile overlaps with the download.
+    JS_EXPORT_PRIVATE explicit Plan(VM*);
+    JS_EXPORT_PRIVATE ~Plan() override;
 
     bool parseAndValidateModule();
 
     JS_EXPORT_PRIVATE void run();
 
+    JS_EXPORT_PRIVATE void appendBytes(const uint8_t*, size_t);
+    JS_EXPORT_PRIVATE void finishStreaming();
+
     JS_EXPORT_PRIVATE void initializeCallees(JSGlobalObject*, std::function<void(unsigned, JSWebAssemblyCallee*, JSWebAssemblyCallee*)>);
 
     bool WARN_UNUSED_RETURN failed() const { return m_failed; }
@@ -92,7 +102,47 @@ public:
         return WTFMove(m_wasmExitStubs);
     }
 
+    // The Memory::Mode the code was compiled for. Instances must use a Memory of this mode.
+    Memory::Mode mode() const { return m_mode; }
+
+    // Null unless the functions were compiled by the baseline tier.
+    RefPtr<OMGPlan> takeOMGPlan()
+    {
+        RELEASE_ASSERT(!failed());
+        return WTFMove(m_omgPlan);
+    }
+
+    VM& vm() const override { return *m_vm; }
+    bool hasWork() override;
+    void work() override;
+
 private:
+    bool parseModule(const uint8_t*, size_t);
+    bool validateFunction(uint32_t functionIndex, const uint8_t*, size_t);
+    bool prepare();
+    void compileFunction(uint32_t functionIndex, const uint8_t*, size_t);
+    bool compileNextFunction();
+    void complete();
+
+    enum class StreamingState : uint8_t {
+        ModuleHeader,
+        SectionHeader,
+        SkipSection,
+        CodeSectionCount,
+        FunctionSize,
+        FunctionBody,
+        Failed
+    };
+
+    struct StreamingTask {
+        uint32_t functionIndex;
+        Vector<uint8_t> body;
+    };
+
+    void parseStreamingBuffer();
+    bool decodeStreamingVarUInt32(uint32_t&, const char* what);
+    void failStreaming(const String&);
+
     std::unique_ptr<ModuleInformation> m_moduleInformation;
     Vector<FunctionLocationInBinary> m_functionLocationInBinary;
     Vector<SignatureIndex> m_moduleSignatureIndicesToUniquedSignatureIndices;
@@ -100,15 +150,27 @@ private:
     Vector<WasmExitStubs> m_wasmExitStubs;
     Vector<std::unique_ptr<WasmInternalFunction>> m_wasmInternalFunctions;
     Vector<CompilationContext> m_compilationContexts;
+    RefPtr<OMGPlan> m_omgPlan;
 
     VM* m_vm;
     Vector<Vector<UnlinkedWasmToWasmCall>> m_unlinkedWasmToWasmCalls;
     const uint8_t* m_source;
-    const size_t m_sourceLength;
+    size_t m_sourceLength;
+    Memory::Mode m_mode;
+    unsigned m_optLevel { 0 };
     bool m_failed { true };
     String m_errorMessage;
     uint32_t m_currentIndex;
     Lock m_lock;
+
+    bool m_isStreaming { false };
+    bool m_streamingCodeSectionParsed { false };
+    StreamingState m_streamingState { StreamingState::ModuleHeader };
+    Vector<uint8_t> m_streamingBuffer;
+    size_t m_streamingOffset { 0 };
+    size_t m_streamingSectionEnd { 0 };
+    uint32_t m_streamingFunctionCount { 0 };
+    Deque<StreamingTask> m_streamingTasks;
 };
 
 } } // namespace JSC::Wasm
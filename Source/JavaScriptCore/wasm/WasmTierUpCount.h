@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "Options.h"
+
+namespace JSC { namespace Wasm {
+
+// Every function compiled by the baseline tier owns one of these. The baseline code subtracts
+// from the count on entry and on each loop back edge, and calls OMGPlan::triggerTierUp() once
+// it drops below zero.
+class TierUpCount {
+public:
+    enum class State : uint8_t {
+        NotCompiled,
+        Compiling,
+        Compiled,
+        Installed,
+        Disabled,
+    };
+
+    TierUpCount()
+        : m_count(Options::webAssemblyOMGTierUpCount())
+    {
+    }
+
+    static int32_t loopDecrement() { return Options::webAssemblyLoopDecrement(); }
+    static int32_t functionEntryDecrement() { return Options::webAssemblyFunctionEntryDecrement(); }
+
+    int32_t* counterAddress() { return &m_count; }
+
+    // Called when the counter fires but there is nothing to do yet. We keep checking back in
+    // until the optimized code is installed.
+    void deferTierUp() { m_count = Options::webAssemblyOMGTierUpCount(); }
+    void disableTierUp() { m_count = std::numeric_limits<int32_t>::max(); }
+
+    // Guarded by the owning OMGPlan's lock.
+    State state { State::NotCompiled };
+
+private:
+    int32_t m_count;
+};
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
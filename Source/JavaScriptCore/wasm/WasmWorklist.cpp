@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.h"
+#include "WasmWorklist.h"
+
+#if ENABLE(WEBASSEMBLY)
+
+#include "Options.h"
+#include <mutex>
+#include <wtf/Threading.h>
+
+namespace JSC { namespace Wasm {
+
+class Worklist::Thread : public AutomaticThread {
+public:
+    Thread(const AbstractLocker& locker, Worklist& worklist)
+        : AutomaticThread(locker, worklist.m_lock, worklist.m_workAvailable)
+        , m_worklist(worklist)
+    {
+    }
+
+protected:
+    PollResult poll(const AbstractLocker& locker) override
+    {
+        Entry* entry = m_worklist.mostUrgentEntryWithWork(locker);
+        if (!entry)
+            return PollResult::Wait;
+        entry->numberOfActiveThreads++;
+        m_job = entry->job;
+        return PollResult::Work;
+    }
+
+    WorkResult work() override
+    {
+        m_job->work();
+
+        LockHolder locker(*m_worklist.m_lock);
+        size_t index = m_worklist.findEntry(locker, *m_job);
+        RELEASE_ASSERT(index != notFound);
+        m_worklist.m_entries[index].numberOfActiveThreads--;
+        m_job = nullptr;
+        m_worklist.m_threadFinishedWork.notifyAll();
+        return WorkResult::Continue;
+    }
+
+    void threadDidStart() override
+    {
+        if (int32_t relativePriority = Options::priorityDeltaOfWebAssemblyCompilerThreads())
+            changeThreadPriority(currentThread(), relativePriority);
+    }
+
+private:
+    Worklist& m_worklist;
+    Job* m_job { nullptr };
+};
+
+Worklist::Worklist(unsigned numberOfThreads)
+    : m_lock(Box<Lock>::create())
+    , m_workAvailable(AutomaticThreadCondition::create())
+{
+    LockHolder locker(*m_lock);
+    for (unsigned i = numberOfThreads; i--;)
+        m_threads.append(adoptRef(new Thread(locker, *this)));
+}
+
+auto Worklist::mostUrgentEntryWithWork(const AbstractLocker&) -> Entry*
+{
+    Entry* result = nullptr;
+    for (Entry& entry : m_entries) {
+        if (entry.isBeingRemoved)
+            continue;
+        if (result && std::tie(result->priority, result->ticket) < std::tie(entry.priority, entry.ticket))
+            continue;
+        if (entry.job->hasWork())
+            result = &entry;
+    }
+    return result;
+}
+
+void Worklist::enqueue(Job& job, Priority priority)
+{
+    LockHolder locker(*m_lock);
+    ASSERT(findEntry(locker, job) == notFound);
+    m_entries.append(Entry { &job, priority, m_nextTicket++, 0, false });
+    m_workAvailable->notifyAll(locker);
+}
+
+void Worklist::notifyWorkAvailable()
+{
+    LockHolder locker(*m_lock);
+    m_workAvailable->notifyAll(locker);
+}
+
+size_t Worklist::findEntry(const AbstractLocker&, Job& job)
+{
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].job == &job)
+            return i;
+    }
+    return notFound;
+}
+
+void Worklist::removeEntry(const AbstractLocker& locker, size_t index)
+{
+    Job* job = m_entries[index].job;
+    m_entries[index].isBeingRemoved = true;
+    while (true) {
+        // Other entries may have been added or removed while we waited.
+        index = findEntry(locker, *job);
+        if (index == notFound)
+            return;
+        if (!m_entries[index].numberOfActiveThreads)
+            break;
+        m_threadFinishedWork.wait(*m_lock);
+    }
+    m_entries.remove(index);
+    m_threadFinishedWork.notifyAll();
+}
+
+void Worklist::dequeue(Job& job)
+{
+    LockHolder locker(*m_lock);
+    size_t index = findEntry(locker, job);
+    if (index == notFound)
+        return;
+    removeEntry(locker, index);
+}
+
+void Worklist::stopAllJobsForVM(VM& vm)
+{
+    LockHolder locker(*m_lock);
+    for (size_t i = 0; i < m_entries.size();) {
+        if (&m_entries[i].job->vm() != &vm || m_entries[i].isBeingRemoved) {
+            ++i;
+            continue;
+        }
+        // Waiting drops the lock, so start over afterwards.
+        removeEntry(locker, i);
+        i = 0;
+    }
+}
+
+static Worklist* theWorklist;
+
+Worklist& ensureWorklist()
+{
+    static std::once_flag initializeWorklistOnceFlag;
+    std::call_once(initializeWorklistOnceFlag, [] {
+        unsigned numberOfThreads = Options::useConcurrentJIT() ? Options::numberOfWebAssemblyCompilerThreads() : 0;
+        theWorklist = new Worklist(numberOfThreads);
+    });
+    return *theWorklist;
+}
+
+Worklist* existingWorklistOrNull()
+{
+    return theWorklist;
+}
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
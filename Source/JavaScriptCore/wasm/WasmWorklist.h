@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#if ENABLE(WEBASSEMBLY)
+
+#include <wtf/AutomaticThread.h>
+#include <wtf/Condition.h>
+#include <wtf/Lock.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class VM;
+
+namespace Wasm {
+
+// A process-wide pool of compiler threads shared by every Wasm::Plan and OMGPlan. Jobs are
+// not compiled whole by one thread: each idle thread takes one unit of work (typically one
+// function) from the most urgent job that has some, so that threads move between jobs as they
+// drain and a single large module can use the whole pool.
+class Worklist {
+    WTF_MAKE_NONCOPYABLE(Worklist);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Lower values are more urgent. Jobs of equal priority are served in enqueue order.
+    enum class Priority : uint8_t {
+        // The main thread is blocked on the job.
+        Synchronous,
+        // The job is being compiled in the background, e.g. while its module is streamed in.
+        Compilation,
+        // Optimizing code that already runs.
+        TierUp
+    };
+
+    class Job {
+    public:
+        virtual ~Job() { }
+
+        virtual VM& vm() const = 0;
+
+        // Called with the worklist lock held, so it must not take any lock that its owner holds
+        // while calling into the worklist.
+        virtual bool hasWork() = 0;
+
+        // Does one unit of work if there is any left. Called on the compiler threads, concurrently
+        // with other calls to work() for the same job.
+        virtual void work() = 0;
+    };
+
+    // The job must stay alive until it has been dequeued.
+    void enqueue(Job&, Priority);
+    // Removes the job and waits for the threads that are working on it. Does nothing if the job
+    // is not enqueued, e.g. because stopAllJobsForVM() already removed it.
+    void dequeue(Job&);
+    // Must be called, without holding any lock the job's hasWork() needs, whenever an enqueued
+    // job gains work.
+    void notifyWorkAvailable();
+
+    // Used on VM teardown. The jobs' owners are left to finish or discard whatever remains.
+    void stopAllJobsForVM(VM&);
+
+    unsigned numberOfThreads() const { return m_threads.size(); }
+
+private:
+    friend Worklist& ensureWorklist();
+
+    explicit Worklist(unsigned numberOfThreads);
+
+    class Thread;
+    friend class Thread;
+
+    struct Entry {
+        Job* job;
+        Priority priority;
+        uint64_t ticket;
+        unsigned numberOfActiveThreads;
+        bool isBeingRemoved;
+    };
+
+    Entry* mostUrgentEntryWithWork(const AbstractLocker&);
+    size_t findEntry(const AbstractLocker&, Job&);
+    void removeEntry(const AbstractLocker&, size_t index);
+
+    Box<Lock> m_lock;
+    RefPtr<AutomaticThreadCondition> m_workAvailable;
+    Condition m_threadFinishedWork;
+    Vector<Entry> m_entries;
+    uint64_t m_nextTicket { 0 };
+    Vector<RefPtr<Thread>> m_threads;
+};
+
+Worklist& ensureWorklist();
+Worklist* existingWorklistOrNull();
+
+} } // namespace JSC::Wasm
+
+#endif // ENABLE(WEBASSEMBLY)
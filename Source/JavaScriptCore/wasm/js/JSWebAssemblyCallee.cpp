@@ -29,6 +29,8 @@
 #if ENABLE(WEBASSEMBLY)
 
 #include "JSCInlines.h"
+#include "ThunkGenerators.h"
+#include "WasmFaultSignalHandler.h"
 
 namespace JSC {
 
@@ -43,11 +45,20 @@ void JSWebAssemblyCallee::finishCreation(VM& vm, Wasm::Entrypoint&& entrypoint)
     Base::finishCreation(vm);
 
     m_entrypoint = WTFMove(entrypoint);
+
+    // Loads and stores from fast memories are not bounds checked, so their faults have to be
+    // routed to the exception thunk.
+    if (Wasm::fastMemoryEnabled()) {
+        MacroAssemblerCodeRef codeRef = m_entrypoint.compilation->codeRef();
+        Wasm::registerCodeForFaultHandling(codeRef.code().executableAddress(), codeRef.size(), vm.getCTIStub(throwExceptionFromWasmThunkGenerator).code().executableAddress());
+    }
 }
 
 void JSWebAssemblyCallee::destroy(JSCell* cell)
 {
     JSWebAssemblyCallee* thisObject = static_cast<JSWebAssemblyCallee*>(cell);
+    if (Wasm::fastMemoryEnabled())
+        Wasm::unregisterCodeForFaultHandling(thisObject->entrypoint());
     thisObject->JSWebAssemblyCallee::~JSWebAssemblyCallee();
 }
 
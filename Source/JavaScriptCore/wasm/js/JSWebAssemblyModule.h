@@ -32,6 +32,7 @@
 #include "JSWebAssemblyCallee.h"
 #include "UnconditionalFinalizer.h"
 #include "WasmFormat.h"
+#include "WasmOMGPlan.h"
 #include <wtf/Bag.h>
 #include <wtf/Vector.h>
 
@@ -43,7 +44,7 @@ class JSWebAssemblyModule : public JSDestructibleObject {
 public:
     typedef JSDestructibleObject Base;
 
-    static JSWebAssemblyModule* create(VM&, Structure*, std::unique_ptr<Wasm::ModuleInformation>&&, Bag<CallLinkInfo>&&, Vector<Wasm::WasmExitStubs>&&, SymbolTable*, unsigned);
+    static JSWebAssemblyModule* create(VM&, Structure*, std::unique_ptr<Wasm::ModuleInformation>&&, Bag<CallLinkInfo>&&, Vector<Wasm::WasmExitStubs>&&, RefPtr<Wasm::OMGPlan>&&, SymbolTable*, unsigned);
     static Structure* createStructure(VM&, JSGlobalObject*, JSValue);
 
     DECLARE_INFO;
@@ -55,6 +56,7 @@ public:
         return m_moduleInformation->signatureIndexFromFunctionIndexSpace(functionIndexSpace);
     }
     unsigned functionImportCount() const { return m_wasmExitStubs.size(); }
+    Wasm::OMGPlan* omgPlan() const { return m_omgPlan.get(); }
 
     JSWebAssemblyCallee* jsEntrypointCalleeFromFunctionIndexSpace(unsigned functionIndexSpace)
     {
@@ -69,6 +71,8 @@ public:
         RELEASE_ASSERT(functionIndexSpace >= functionImportCount());
         unsigned calleeIndex = functionIndexSpace - functionImportCount();
         RELEASE_ASSERT(calleeIndex < m_calleeCount);
+        if (JSWebAssemblyCallee* optimized = callees()[calleeIndex + m_calleeCount * 2].get())
+            return optimized;
         return callees()[calleeIndex + m_calleeCount].get();
     }
 
@@ -84,13 +88,21 @@ public:
         callees()[calleeIndex + m_calleeCount].set(vm, this, callee);
     }
 
+    // The baseline callee stays alive alongside the optimized one: the OMGPlan keeps repatching
+    // the call sites in its code.
+    void setOptimizedWasmEntrypointCallee(VM& vm, unsigned calleeIndex, JSWebAssemblyCallee* callee)
+    {
+        RELEASE_ASSERT(calleeIndex < m_calleeCount);
+        callees()[calleeIndex + m_calleeCount * 2].set(vm, this, callee);
+    }
+
     WriteBarrier<JSWebAssemblyCallee>* callees()
     {
         return bitwise_cast<WriteBarrier<JSWebAssemblyCallee>*>(bitwise_cast<char*>(this) + offsetOfCallees());
     }
 
 protected:
-    JSWebAssemblyModule(VM&, Structure*, std::unique_ptr<Wasm::ModuleInformation>&&, Bag<CallLinkInfo>&&, Vector<Wasm::WasmExitStubs>&&, unsigned calleeCount);
+    JSWebAssemblyModule(VM&, Structure*, std::unique_ptr<Wasm::ModuleInformation>&&, Bag<CallLinkInfo>&&, Vector<Wasm::WasmExitStubs>&&, RefPtr<Wasm::OMGPlan>&&, unsigned calleeCount);
     void finishCreation(VM&, SymbolTable*);
     static void destroy(JSCell*);
     static void visitChildren(JSCell*, SlotVisitor&);
@@ -103,7 +115,7 @@ private:
 
     static size_t allocationSize(unsigned numCallees)
     {
-        return offsetOfCallees() + sizeof(WriteBarrier<JSWebAssemblyCallee>) * numCallees * 2;
+        return offsetOfCallees() + sizeof(WriteBarrier<JSWebAssemblyCallee>) * numCallees * 3;
     }
 
     class UnconditionalFinalizer : public JSC::UnconditionalFinalizer { 
@@ -115,6 +127,7 @@ private:
     Bag<CallLinkInfo> m_callLinkInfos;
     WriteBarrier<SymbolTable> m_exportSymbolTable;
     Vector<Wasm::WasmExitStubs> m_wasmExitStubs;
+    RefPtr<Wasm::OMGPlan> m_omgPlan;
     unsigned m_calleeCount;
 };
 
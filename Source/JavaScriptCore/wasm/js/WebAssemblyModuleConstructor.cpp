@@ -81,8 +81,17 @@ JSValue WebAssemblyModuleConstructor::createModule(ExecState* state, Structure*
     RETURN_IF_EXCEPTION(scope, { });
 
     Wasm::Plan plan(&vm, base + byteOffset, byteSize);
-    // On failure, a new WebAssembly.CompileError is thrown.
     plan.run();
+    scope.release();
+    return createModule(state, structure, plan);
+}
+
+JSValue WebAssemblyModuleConstructor::createModule(ExecState* state, Structure* structure, Wasm::Plan& plan)
+{
+    VM& vm = state->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    // On failure, a new WebAssembly.CompileError is thrown.
     if (plan.failed())
         return throwException(state, scope, createJSWebAssemblyCompileError(state, vm, plan.errorMessage()));
 
@@ -97,7 +106,7 @@ JSValue WebAssemblyModuleConstructor::createModule(ExecState* state, Structure*
 
     // Only wasm-internal functions have a callee, stubs to JS do not.
     unsigned calleeCount = plan.internalFunctionCount();
-    JSWebAssemblyModule* result = JSWebAssemblyModule::create(vm, structure, plan.takeModuleInformation(), plan.takeCallLinkInfos(), plan.takeWasmExitStubs(), exportSymbolTable, calleeCount);
+    JSWebAssemblyModule* result = JSWebAssemblyModule::create(vm, structure, plan.takeModuleInformation(), plan.takeCallLinkInfos(), plan.takeWasmExitStubs(), plan.takeOMGPlan(), exportSymbolTable, calleeCount);
     plan.initializeCallees(state->jsCallee()->globalObject(), 
         [&] (unsigned calleeIndex, JSWebAssemblyCallee* jsEntrypointCallee, JSWebAssemblyCallee* wasmEntrypointCallee) {
             result->setJSEntrypointCallee(vm, calleeIndex, jsEntrypointCallee);
@@ -34,6 +34,10 @@ namespace JSC {
 
 class WebAssemblyModulePrototype;
 
+namespace Wasm {
+class Plan;
+}
+
 class WebAssemblyModuleConstructor : public InternalFunction {
 public:
     typedef InternalFunction Base;
@@ -45,6 +49,9 @@ public:
     DECLARE_INFO;
 
     static JSValue createModule(ExecState*, Structure*);
+    // Creates the module from a plan that has already been run, or fed with the whole module in
+    // streaming mode.
+    JS_EXPORT_PRIVATE static JSValue createModule(ExecState*, Structure*, Wasm::Plan&);
 
 protected:
     void finishCreation(VM&, WebAssemblyModulePrototype*);
@@ -31,6 +31,11 @@
 #include "Options.h"
 #include "Yarr.h"
 #include "YarrCanonicalize.h"
+#include <wtf/MathExtras.h>
+
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#endif
 
 #if ENABLE(YARR_JIT)
 
@@ -38,6 +43,47 @@ using namespace WTF;
 
 namespace JSC { namespace Yarr {
 
+// Called from JIT code to find the next position, at or after start, at which a
+// literal prefix of the given length with the given first and last characters
+// could begin. Returns UINT_MAX if there is none.
+template<typename CharType>
+static unsigned findLiteralPrefixCandidate(const CharType* input, unsigned start, unsigned length, unsigned firstAndLastCharacters, unsigned prefixLength)
+{
+    UChar first = firstAndLastCharacters & 0xffff;
+    UChar last = firstAndLastCharacters >> 16;
+    if (sizeof(CharType) == 1 && (first > 0xff || last > 0xff))
+        return UINT_MAX;
+    if (prefixLength > length)
+        return UINT_MAX;
+
+    unsigned end = length - prefixLength + 1;
+    unsigned lastOffset = prefixLength - 1;
+    unsigned position = start;
+
+#if CPU(X86_SSE2)
+    // Compare 16 bytes of candidate first characters and of the corresponding last
+    // characters at a time; only positions where both match are worth trying.
+    const unsigned charactersPerVector = sizeof(__m128i) / sizeof(CharType);
+    __m128i firstVector = sizeof(CharType) == 1 ? _mm_set1_epi8(first) : _mm_set1_epi16(first);
+    __m128i lastVector = sizeof(CharType) == 1 ? _mm_set1_epi8(last) : _mm_set1_epi16(last);
+    for (; position + charactersPerVector <= end; position += charactersPerVector) {
+        __m128i firstCharacters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + position));
+        __m128i lastCharacters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + position + lastOffset));
+        __m128i matches = sizeof(CharType) == 1
+            ? _mm_and_si128(_mm_cmpeq_epi8(firstCharacters, firstVector), _mm_cmpeq_epi8(lastCharacters, lastVector))
+            : _mm_and_si128(_mm_cmpeq_epi16(firstCharacters, firstVector), _mm_cmpeq_epi16(lastCharacters, lastVector));
+        if (unsigned mask = _mm_movemask_epi8(matches))
+            return position + countTrailingZeros(mask) / sizeof(CharType);
+    }
+#endif
+
+    for (; position < end; ++position) {
+        if (input[position] == first && input[position + lastOffset] == last)
+            return position;
+    }
+    return UINT_MAX;
+}
+
 template<YarrJITCompileMode compileMode>
 class YarrGenerator : private MacroAssembler {
     friend void jitCompile(VM*, YarrCodeBlock& jitObject, const String& pattern, unsigned& numSubpatterns, const char*& error, bool ignoreCase, bool multiline);
@@ -404,6 +450,12 @@ class YarrGenerator : private MacroAssembler {
         // FIXME: should be able to ASSERT(compileMode == IncludeSubpatterns), but then this function is conditionally NORETURN. :-(
         store32(TrustedImm32(-1), Address(output, (subpattern << 1) * sizeof(int)));
     }
+    void clearSubpatternEnd(unsigned subpattern)
+    {
+        ASSERT(subpattern);
+        // FIXME: should be able to ASSERT(compileMode == IncludeSubpatterns), but then this function is conditionally NORETURN. :-(
+        store32(TrustedImm32(-1), Address(output, ((subpattern << 1) + 1) * sizeof(int)));
+    }
 
     // We use one of three different strategies to track the start of the current match,
     // while matching.
@@ -1241,6 +1293,90 @@ class YarrGenerator : private MacroAssembler {
     {
         backtrackTermDefault(opIndex);
     }
+
+    // Back references are matched against the subpattern's entry in the output
+    // vector, so they are only supported when compiling IncludeSubpatterns. We
+    // handle a single, case sensitive occurrence of the referenced text; other
+    // forms fall back to the interpreter.
+    bool canCompileBackReference(PatternTerm* term)
+    {
+        return compileMode == IncludeSubpatterns
+            && !m_pattern.ignoreCase()
+            && term->quantityType == QuantifierFixedCount
+            && term->quantityMaxCount == 1;
+    }
+
+    void generateBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+        unsigned subpatternId = term->backReferenceSubpatternId;
+        unsigned frameLocation = term->frameLocation;
+        ASSERT(canCompileBackReference(term));
+
+        const RegisterID character = regT0;
+        const RegisterID patternIndex = regT1;
+        // There are only two temporaries, so while comparing characters we spill
+        // the input length to the frame and use its register for the second one.
+        const RegisterID patternCharacter = length;
+
+        Address subpatternStart(output, (subpatternId << 1) * sizeof(int));
+        Address subpatternEnd(output, ((subpatternId << 1) + 1) * sizeof(int));
+
+        // Remember where we started, so that we can rewind on failure and backtracking.
+        storeToFrame(index, frameLocation);
+
+        // A subpattern that has not matched (or that we are still inside of) has
+        // its end set to -1, and is treated like an empty match.
+        JumpList matchedEmpty;
+        load32(subpatternStart, patternIndex);
+        matchedEmpty.append(branch32(Equal, patternIndex, TrustedImm32(-1)));
+        load32(subpatternEnd, character);
+        matchedEmpty.append(branch32(Equal, character, TrustedImm32(-1)));
+        matchedEmpty.append(branch32(Equal, character, patternIndex));
+
+        // Check that there is enough input left for the referenced text.
+        sub32(patternIndex, character);
+        add32(index, character);
+        op.m_jumps.append(branch32(Above, character, length));
+
+        storeToFrame(length, frameLocation + 1);
+        BaseIndex patternAddress(input, patternIndex, m_charSize == Char8 ? TimesOne : TimesTwo);
+
+        Label loop(this);
+        if (m_charSize == Char8)
+            load8(patternAddress, patternCharacter);
+        else
+            load16Unaligned(patternAddress, patternCharacter);
+        readCharacter(m_checkedOffset - term->inputPosition, character);
+        Jump characterMismatch = branch32(NotEqual, character, patternCharacter);
+        add32(TrustedImm32(1), index);
+        add32(TrustedImm32(1), patternIndex);
+        branch32(NotEqual, patternIndex, subpatternEnd).linkTo(loop, this);
+
+        loadFromFrame(frameLocation + 1, length);
+        Jump matched = jump();
+
+        characterMismatch.link(this);
+        loadFromFrame(frameLocation + 1, length);
+        loadFromFrame(frameLocation, index);
+        op.m_jumps.append(jump());
+
+        matchedEmpty.link(this);
+        matched.link(this);
+    }
+    void backtrackBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        // A back reference only matches one way, so backtracking into it rewinds
+        // the input position and continues backtracking.
+        m_backtrackingState.link(this);
+        loadFromFrame(term->frameLocation, index);
+        m_backtrackingState.fallthrough();
+        m_backtrackingState.append(op.m_jumps);
+    }
     
     // Code generation/backtracking for simple terms
     // (pattern characters, character classes, and assertions).
@@ -1304,7 +1440,7 @@ class YarrGenerator : private MacroAssembler {
         case PatternTerm::TypeParentheticalAssertion:
             RELEASE_ASSERT_NOT_REACHED();
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            generateBackReference(opIndex);
             break;
         case PatternTerm::TypeDotStarEnclosure:
             generateDotStarEnclosure(opIndex);
@@ -1375,11 +1511,73 @@ class YarrGenerator : private MacroAssembler {
             break;
 
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            backtrackBackReference(opIndex);
             break;
         }
     }
 
+    // Every repeating alternative of the body starts with m_pattern.m_literalPrefix, so
+    // before each attempt we can skip straight to the next place where it could occur.
+    // We call out to a vectorized search, which we only know how to do on x86-64.
+    bool canSkipToLiteralPrefix(PatternAlternative* alternative)
+    {
+#if CPU(X86_64) && !OS(WINDOWS)
+        return !m_pattern.m_literalPrefix.isEmpty()
+            && !m_pattern.sticky()
+            && !alternative->onceThrough();
+#else
+        UNUSED_PARAM(alternative);
+        return false;
+#endif
+    }
+
+    void generateSkipToLiteralPrefix(YarrOp& op, PatternAlternative* alternative)
+    {
+#if CPU(X86_64) && !OS(WINDOWS)
+        const Vector<UChar>& prefix = m_pattern.m_literalPrefix;
+        unsigned minimumSize = alternative->m_minimumSize;
+        ASSERT(minimumSize >= prefix.size());
+
+        // The index is minimumSize ahead of the start of this attempt. If that is already
+        // a candidate, don't bother with the call.
+        readCharacter(minimumSize, regT0);
+        Jump atCandidate = branch32(Equal, regT0, Imm32(prefix.first()));
+
+        // Our registers are the callee's first three arguments, and the frame keeps the
+        // stack 16 byte aligned once we have saved the three of them that we need.
+        sub32(Imm32(minimumSize), index);
+        push(input);
+        push(length);
+        push(output);
+        move(TrustedImm32(static_cast<unsigned>(prefix.first()) | (static_cast<unsigned>(prefix.last()) << 16)), X86Registers::ecx);
+        move(TrustedImm32(prefix.size()), X86Registers::r8);
+        if (m_charSize == Char8)
+            move(TrustedImmPtr(reinterpret_cast<void*>(&findLiteralPrefixCandidate<LChar>)), regT0);
+        else
+            move(TrustedImmPtr(reinterpret_cast<void*>(&findLiteralPrefixCandidate<UChar>)), regT0);
+        call(regT0);
+        pop(output);
+        pop(length);
+        pop(input);
+
+        // No candidate means no match anywhere in the rest of the input.
+        Jump foundCandidate = branch32(NotEqual, regT0, TrustedImm32(-1));
+        removeCallFrame();
+        generateFailReturn();
+        foundCandidate.link(this);
+
+        zeroExtend32ToPtr(regT0, index);
+        if (!m_pattern.m_body->m_hasFixedSize)
+            setMatchStart(index);
+        op.m_jumps.append(jumpIfNoAvailableInput(minimumSize));
+
+        atCandidate.link(this);
+#else
+        UNUSED_PARAM(op);
+        UNUSED_PARAM(alternative);
+#endif
+    }
+
     void generate()
     {
         // Forwards generate the matching code.
@@ -1426,6 +1624,9 @@ class YarrGenerator : private MacroAssembler {
                 // set as appropriate to this alternative.
                 op.m_reentry = label();
 
+                if (canSkipToLiteralPrefix(alternative))
+                    generateSkipToLiteralPrefix(op, alternative);
+
                 m_checkedOffset += alternative->m_minimumSize;
                 break;
             }
@@ -1647,6 +1848,11 @@ class YarrGenerator : private MacroAssembler {
                         setSubpatternStart(indexTemporary, term->parentheses.subpatternId);
                     } else
                         setSubpatternStart(index, term->parentheses.subpatternId);
+
+                    // A back reference from within these parentheses must not see the
+                    // end of a previous match of them.
+                    if (m_pattern.m_containsBackreferences)
+                        clearSubpatternEnd(term->parentheses.subpatternId);
                 }
                 break;
             }
@@ -2474,6 +2680,14 @@ class YarrGenerator : private MacroAssembler {
                 opCompileParentheticalAssertion(term);
                 break;
 
+            case PatternTerm::TypeBackReference:
+                if (!canCompileBackReference(term)) {
+                    m_shouldFallBack = true;
+                    return;
+                }
+                m_ops.append(term);
+                break;
+
             default:
                 m_ops.append(term);
             }
@@ -2655,8 +2869,12 @@ public:
         hasInput.link(this);
 
         if (compileMode == IncludeSubpatterns) {
-            for (unsigned i = 0; i < m_pattern.m_numSubpatterns + 1; ++i)
+            for (unsigned i = 0; i < m_pattern.m_numSubpatterns + 1; ++i) {
                 store32(TrustedImm32(-1), Address(output, (i << 1) * sizeof(int)));
+                // Back references look at the end index to tell whether a subpattern has matched.
+                if (i && m_pattern.m_containsBackreferences)
+                    clearSubpatternEnd(i);
+            }
         }
 
         if (!m_pattern.m_body->m_hasFixedSize)
@@ -30,6 +30,7 @@
 #include "Yarr.h"
 #include "YarrCanonicalize.h"
 #include "YarrParser.h"
+#include <wtf/ASCIICType.h>
 #include <wtf/Vector.h>
 #include <wtf/WTFThreadData.h>
 
@@ -790,6 +791,52 @@ public:
         }
     }
 
+    // Find the run of literal characters that every repeating alternative of the body
+    // starts with, e.g. "ERROR: " for /ERROR: (\w+)/ or "f" for /foo|far/. A match can
+    // only start where this prefix occurs, which lets the JIT skip ahead to candidates.
+    void extractLiteralPrefix()
+    {
+        static const unsigned maximumLiteralPrefixLength = 64;
+        Vector<UChar>& prefix = m_pattern.m_literalPrefix;
+        ASSERT(prefix.isEmpty());
+
+        if (m_pattern.sticky() || m_pattern.unicode())
+            return;
+
+        bool isFirstAlternative = true;
+        for (auto& alternative : m_pattern.m_body->m_alternatives) {
+            if (alternative->onceThrough())
+                continue;
+
+            Vector<UChar, 16> alternativePrefix;
+            for (PatternTerm& term : alternative->m_terms) {
+                if (term.type != PatternTerm::TypePatternCharacter
+                    || term.quantityType != QuantifierFixedCount
+                    || term.inputPosition != alternativePrefix.size()
+                    || term.patternCharacter > 0xffff
+                    || (m_pattern.ignoreCase() && isASCIIAlpha(term.patternCharacter)))
+                    break;
+                if (alternativePrefix.size() + term.quantityMaxCount.unsafeGet() > maximumLiteralPrefixLength)
+                    break;
+                for (unsigned i = 0; i < term.quantityMaxCount.unsafeGet(); ++i)
+                    alternativePrefix.append(term.patternCharacter);
+            }
+
+            if (isFirstAlternative) {
+                prefix.appendVector(alternativePrefix);
+                isFirstAlternative = false;
+            } else {
+                unsigned commonLength = 0;
+                while (commonLength < prefix.size() && commonLength < alternativePrefix.size() && prefix[commonLength] == alternativePrefix[commonLength])
+                    ++commonLength;
+                prefix.shrink(commonLength);
+            }
+
+            if (prefix.isEmpty())
+                return;
+        }
+    }
+
     bool containsCapturingTerms(PatternAlternative* alternative, size_t firstTermIndex, size_t endIndex)
     {
         Vector<PatternTerm>& terms = alternative->m_terms;
@@ -950,6 +997,8 @@ const char* YarrPattern::compile(const String& patternString, void* stackLimit)
     if (const char* error = constructor.setupOffsets())
         return error;
 
+    constructor.extractLiteralPrefix();
+
     return nullptr;
 }
 
@@ -360,6 +360,7 @@ struct YarrPattern {
 
         m_disjunctions.clear();
         m_userCharacterClasses.clear();
+        m_literalPrefix.clear();
     }
 
     bool containsIllegalBackReference()
@@ -460,6 +461,8 @@ struct YarrPattern {
     PatternDisjunction* m_body;
     Vector<std::unique_ptr<PatternDisjunction>, 4> m_disjunctions;
     Vector<std::unique_ptr<CharacterClass>> m_userCharacterClasses;
+    // Characters that any match of the repeating body alternatives must start with.
+    Vector<UChar> m_literalPrefix;
 
 private:
     const char* compile(const String& patternString, void* stackLimit);
@@ -43,6 +43,10 @@
 #include <machine/ieee.h>
 #endif
 
+#if COMPILER(MSVC)
+#include <intrin.h>
+#endif
+
 #ifndef M_PI
 const double piDouble = 3.14159265358979323846;
 const float piFloat = 3.14159265358979323846f;
@@ -476,6 +480,26 @@ inline bool rangesOverlap(T leftMin, T leftMax, T rightMin, T rightMax)
     return nonEmptyRangesOverlap(leftMin, leftMax, rightMin, rightMax);
 }
 
+// Returns the index of the lowest set bit. The value must not be zero.
+inline unsigned countTrailingZeros(uint32_t value)
+{
+    ASSERT(value);
+#if COMPILER(GCC_OR_CLANG)
+    return __builtin_ctz(value);
+#elif COMPILER(MSVC)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+#else
+    unsigned index = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
 } // namespace WTF
 
 #endif // #ifndef WTF_MathExtras_h
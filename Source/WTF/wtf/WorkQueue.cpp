@@ -33,6 +33,7 @@
 #include <wtf/NeverDestroyed.h>
 #include <wtf/NumberOfCores.h>
 #include <wtf/Ref.h>
+#include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Threading.h>
 #include <wtf/text/WTFString.h>
 #include <wtf/threads/BinarySemaphore.h>
@@ -82,11 +83,11 @@ void WorkQueue::concurrentApply(size_t iterations, const std::function<void (siz
 
         size_t workerCount() const { return m_workers.size(); }
 
-        void dispatch(const std::function<void ()>* function)
+        void dispatch(Function<void ()>&& function)
         {
             LockHolder holder(m_lock);
 
-            m_queue.append(function);
+            m_queue.append(WTFMove(function));
             m_condition.notifyOne();
         }
 
@@ -94,7 +95,7 @@ void WorkQueue::concurrentApply(size_t iterations, const std::function<void (siz
         NO_RETURN void threadBody()
         {
             while (true) {
-                const std::function<void ()>* function;
+                Function<void ()> function;
 
                 {
                     LockHolder holder(m_lock);
@@ -106,13 +107,13 @@ void WorkQueue::concurrentApply(size_t iterations, const std::function<void (siz
                     function = m_queue.takeFirst();
                 }
 
-                (*function)();
+                function();
             }
         }
 
         Lock m_lock;
         Condition m_condition;
-        Deque<const std::function<void ()>*> m_queue;
+        Deque<Function<void ()>> m_queue;
 
         Vector<ThreadIdentifier> m_workers;
     };
@@ -123,35 +124,62 @@ void WorkQueue::concurrentApply(size_t iterations, const std::function<void (siz
         threadPool.construct();
     });
 
-    // Cap the worker count to the number of iterations (excluding this thread)
-    const size_t workerCount = std::min(iterations - 1, threadPool->workerCount());
+    // Iterations are handed out one at a time to whichever thread asks next, so threads that finish
+    // early keep taking work from the slower ones. The caller only waits for the iterations that have
+    // been taken, not for every worker to wake up: a worker that gets to the state after all the
+    // iterations are gone returns without touching the function. This also makes it safe to call
+    // concurrentApply() from a function that is itself being applied, even when every worker is busy.
+    class ApplyState : public ThreadSafeRefCounted<ApplyState> {
+    public:
+        ApplyState(size_t iterations, const std::function<void (size_t index)>& function)
+            : m_iterations(iterations)
+            , m_remainingIterations(iterations)
+            , m_function(function)
+        {
+        }
 
-    std::atomic<size_t> currentIndex(0);
-    std::atomic<size_t> activeThreads(workerCount + 1);
+        void run()
+        {
+            size_t index;
+            while ((index = m_currentIndex++) < m_iterations) {
+                m_function(index);
 
-    Condition condition;
-    Lock lock;
+                // If this was the last iteration to complete, signal the caller.
+                if (!--m_remainingIterations) {
+                    LockHolder holder(m_lock);
+                    m_condition.notifyOne();
+                }
+            }
+        }
 
-    std::function<void ()> applier = [&] {
-        size_t index;
+        void waitForCompletion()
+        {
+            LockHolder holder(m_lock);
+            m_condition.wait(m_lock, [this] { return !m_remainingIterations; });
+        }
 
-        // Call the function for as long as there are iterations left.
-        while ((index = currentIndex++) < iterations)
-            function(index);
+    private:
+        const size_t m_iterations;
+        std::atomic<size_t> m_currentIndex { 0 };
+        std::atomic<size_t> m_remainingIterations;
+        const std::function<void (size_t index)>& m_function;
 
-        // If there are no active threads left, signal the caller.
-        if (!--activeThreads) {
-            LockHolder holder(lock);
-            condition.notifyOne();
-        }
+        Lock m_lock;
+        Condition m_condition;
     };
 
-    for (size_t i = 0; i < workerCount; ++i)
-        threadPool->dispatch(&applier);
-    applier();
+    // Cap the worker count to the number of iterations (excluding this thread)
+    const size_t workerCount = std::min(iterations - 1, threadPool->workerCount());
+
+    Ref<ApplyState> state = adoptRef(*new ApplyState(iterations, function));
+    for (size_t i = 0; i < workerCount; ++i) {
+        threadPool->dispatch([state = state.copyRef()] {
+            state->run();
+        });
+    }
 
-    LockHolder holder(lock);
-    condition.wait(lock, [&] { return !activeThreads; });
+    state->run();
+    state->waitForCompletion();
 }
 #endif
 
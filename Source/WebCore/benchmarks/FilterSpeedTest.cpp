@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares the SSE2 filter kernels against the scalar loops of the generic filter code paths, checking
+// that both produce the same pixels and reporting how long each one takes.
+//
+// On Linux, you can build this like so:
+// g++ -o FilterSpeedTest Source/WebCore/benchmarks/FilterSpeedTest.cpp -O2 -W -ISource/WTF -ISource/WebCore/platform/graphics/cpu/x86/filters -LWebKitBuild/Release/lib -lWTF -lpthread -std=c++14
+
+#include "config.h"
+
+#include "FEColorMatrixSSE2.h"
+#include "FECompositeArithmeticSSE2.h"
+#include "FEGaussianBlurSSE2.h"
+#include "FEMorphologySSE2.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/DataLog.h>
+#include <wtf/Vector.h>
+
+#if CPU(X86_SSE2)
+
+using namespace WebCore;
+
+namespace {
+
+const int width = 1024;
+const int height = 768;
+const unsigned pixelArrayLength = width * height * 4;
+unsigned iterations;
+bool allMatched = true;
+
+NO_RETURN void usage()
+{
+    printf("Usage: FilterSpeedTest <iterations>\n");
+    exit(1);
+}
+
+// The scalar references below follow boxBlur(), FEMorphology::platformApplyGeneric(),
+// computeArithmeticPixels() and effectType() in platform/graphics/filters.
+
+void boxBlurScalar(const unsigned char* srcData, unsigned char* dstData, unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight)
+{
+    const int maxKernelSize = std::min(dxRight, effectWidth);
+    for (int y = 0; y < effectHeight; ++y) {
+        int line = y * strideLine;
+        int sum[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < maxKernelSize; ++i) {
+            for (int channel = 0; channel < 4; ++channel)
+                sum[channel] += srcData[line + i * stride + channel];
+        }
+        for (int x = 0; x < effectWidth; ++x) {
+            int pixelByteOffset = line + x * stride;
+            for (int channel = 0; channel < 4; ++channel)
+                dstData[pixelByteOffset + channel] = static_cast<unsigned char>(sum[channel] / dx);
+            if (x >= dxLeft) {
+                for (int channel = 0; channel < 4; ++channel)
+                    sum[channel] -= srcData[pixelByteOffset - dxLeft * stride + channel];
+            }
+            if (x + dxRight < effectWidth) {
+                for (int channel = 0; channel < 4; ++channel)
+                    sum[channel] += srcData[pixelByteOffset + dxRight * stride + channel];
+            }
+        }
+    }
+}
+
+unsigned char columnExtremum(const unsigned char* srcData, bool isErode, int x, int yStart, int yEnd, int channel)
+{
+    unsigned char extremum = srcData[(yStart * width + x) * 4 + channel];
+    for (int y = yStart + 1; y < yEnd; ++y) {
+        unsigned char pixel = srcData[(y * width + x) * 4 + channel];
+        extremum = isErode ? std::min(extremum, pixel) : std::max(extremum, pixel);
+    }
+    return extremum;
+}
+
+void morphologyScalar(const unsigned char* srcData, unsigned char* dstData, bool isErode, int radiusX, int radiusY)
+{
+    Vector<unsigned char> extrema;
+    for (int y = 0; y < height; ++y) {
+        int yStartExtrema = std::max(0, y - radiusY);
+        int yEndExtrema = std::min(height - 1, y + radiusY);
+        for (int channel = 0; channel < 4; ++channel) {
+            extrema.clear();
+            for (int x = 0; x < radiusX; ++x)
+                extrema.append(columnExtremum(srcData, isErode, x, yStartExtrema, yEndExtrema, channel));
+            for (int x = 0; x < width; ++x) {
+                if (x < width - radiusX)
+                    extrema.append(columnExtremum(srcData, isErode, std::min(x + radiusX, width - 1), yStartExtrema, yEndExtrema + 1, channel));
+                if (x > radiusX)
+                    extrema.remove(0);
+                unsigned char extremum = extrema[0];
+                for (unsigned char value : extrema)
+                    extremum = isErode ? std::min(extremum, value) : std::max(extremum, value);
+                dstData[(y * width + x) * 4 + channel] = extremum;
+            }
+        }
+    }
+}
+
+unsigned char clampByte(int c)
+{
+    unsigned char buff[] = { static_cast<unsigned char>(c), 255, 0 };
+    unsigned uc = static_cast<unsigned>(c);
+    return buff[!!(uc & ~0xff) + !!(uc & ~(~0u >> 1))];
+}
+
+void arithmeticScalar(const unsigned char* source, unsigned char* destination, unsigned length, float k1, float k2, float k3, float k4)
+{
+    float scaledK1 = k1 / 255.0f;
+    float scaledK4 = k4 * 255.0f;
+    for (unsigned i = 0; i < length; ++i) {
+        unsigned char i1 = source[i];
+        unsigned char i2 = destination[i];
+        float result = k2 * i1 + k3 * i2;
+        result += scaledK1 * i1 * i2;
+        result += scaledK4;
+        destination[i] = clampByte(result);
+    }
+}
+
+unsigned char toClampedByte(double value)
+{
+    if (std::isnan(value) || value < 0)
+        return 0;
+    if (value > 255)
+        return 255;
+    return static_cast<unsigned char>(lrint(value));
+}
+
+void colorMatrixScalar(unsigned char* pixels, unsigned length, const float* values)
+{
+    for (unsigned offset = 0; offset < length; offset += 4) {
+        float red = pixels[offset];
+        float green = pixels[offset + 1];
+        float blue = pixels[offset + 2];
+        float alpha = pixels[offset + 3];
+        for (int row = 0; row < 4; ++row) {
+            const float* v = values + row * 5;
+            pixels[offset + row] = toClampedByte(v[0] * red + v[1] * green + v[2] * blue + v[3] * alpha + v[4] * 255);
+        }
+    }
+}
+
+void saturateScalar(unsigned char* pixels, unsigned length, const float* components)
+{
+    for (unsigned offset = 0; offset < length; offset += 4) {
+        float red = pixels[offset];
+        float green = pixels[offset + 1];
+        float blue = pixels[offset + 2];
+        for (int row = 0; row < 3; ++row) {
+            const float* c = components + row * 3;
+            pixels[offset + row] = toClampedByte(red * c[0] + green * c[1] + blue * c[2]);
+        }
+    }
+}
+
+template<typename Functor>
+double measure(const Functor& functor)
+{
+    double before = monotonicallyIncreasingTime();
+    for (unsigned i = iterations; i--;)
+        functor();
+    return (monotonicallyIncreasingTime() - before) * 1000 / iterations;
+}
+
+// Both functors read from input and write their result into the buffer they are given, which starts
+// out as a copy of destination.
+template<typename ScalarFunctor, typename SSE2Functor>
+void run(const char* name, const Vector<unsigned char>& destination, const ScalarFunctor& scalar, const SSE2Functor& sse2)
+{
+    Vector<unsigned char> scalarResult = destination;
+    Vector<unsigned char> sse2Result = destination;
+    scalar(scalarResult.data());
+    sse2(sse2Result.data());
+    bool matched = scalarResult == sse2Result;
+    allMatched &= matched;
+
+    double scalarTime = measure([&] { scalar(scalarResult.data()); });
+    double sse2Time = measure([&] { sse2(sse2Result.data()); });
+    dataLogF("%-24s scalar: %8.3lf ms  SSE2: %8.3lf ms  speedup: %5.2lfx%s\n", name, scalarTime, sse2Time, scalarTime / sse2Time, matched ? "" : "  MISMATCH");
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 2 || sscanf(argv[1], "%u", &iterations) != 1 || !iterations)
+        usage();
+
+    Vector<unsigned char> input(pixelArrayLength);
+    Vector<unsigned char> destination(pixelArrayLength);
+    srand(42);
+    for (unsigned i = 0; i < pixelArrayLength; ++i) {
+        input[i] = rand();
+        destination[i] = rand();
+    }
+    const unsigned char* source = input.data();
+
+    for (unsigned kernelSize : { 3, 12, 41 }) {
+        int dxLeft = kernelSize / 2;
+        int dxRight = kernelSize - dxLeft;
+        char name[64];
+        snprintf(name, sizeof(name), "box blur %u horizontal", kernelSize);
+        run(name, destination,
+            [&] (unsigned char* result) { boxBlurScalar(source, result, kernelSize, dxLeft, dxRight, 4, width * 4, width, height); },
+            [&] (unsigned char* result) { boxBlurSSE2(source, result, kernelSize, dxLeft, dxRight, 4, width * 4, width, height); });
+        snprintf(name, sizeof(name), "box blur %u vertical", kernelSize);
+        run(name, destination,
+            [&] (unsigned char* result) { boxBlurScalar(source, result, kernelSize, dxLeft, dxRight, width * 4, 4, height, width); },
+            [&] (unsigned char* result) { boxBlurSSE2(source, result, kernelSize, dxLeft, dxRight, width * 4, 4, height, width); });
+    }
+
+    for (int radius : { 1, 5 }) {
+        char name[64];
+        snprintf(name, sizeof(name), "erode %d", radius);
+        run(name, destination,
+            [&] (unsigned char* result) { morphologyScalar(source, result, true, radius, radius); },
+            [&] (unsigned char* result) { morphologySSE2<true>(source, result, width, height, radius, radius, 0, height); });
+        snprintf(name, sizeof(name), "dilate %d", radius);
+        run(name, destination,
+            [&] (unsigned char* result) { morphologyScalar(source, result, false, radius, radius); },
+            [&] (unsigned char* result) { morphologySSE2<false>(source, result, width, height, radius, radius, 0, height); });
+    }
+
+    run("arithmetic composite", destination,
+        [&] (unsigned char* result) { arithmeticScalar(source, result, pixelArrayLength, 0.5, 0.7, -0.3, 0.1); },
+        [&] (unsigned char* result) { platformArithmeticSSE2(source, result, pixelArrayLength, 0.5, 0.7, -0.3, 0.1); });
+
+    const float matrix[20] = { 0.393, 0.769, 0.189, 0, 0, 0.349, 0.686, 0.168, 0, 0, 0.272, 0.534, 0.131, 0, 0, 0, 0, 0, 1, 0 };
+    run("color matrix", input,
+        [&] (unsigned char* result) { colorMatrixScalar(result, pixelArrayLength, matrix); },
+        [&] (unsigned char* result) { colorMatrixSSE2(result, pixelArrayLength, matrix); });
+
+    const float saturate[9] = { 0.2848, 0.7152, 0.0722, 0.2126, 0.7872, 0.0722, 0.2126, 0.7152, 0.1440 };
+    run("saturate", input,
+        [&] (unsigned char* result) { saturateScalar(result, pixelArrayLength, saturate); },
+        [&] (unsigned char* result) { saturateAndHueRotateSSE2(result, pixelArrayLength, saturate); });
+
+    return allMatched ? 0 : 1;
+}
+
+#else
+
+int main()
+{
+    printf("FilterSpeedTest requires SSE2.\n");
+    return 1;
+}
+
+#endif // CPU(X86_SSE2)
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Compares the SSE2 pixel conversions used by the Cairo ImageBuffer for getImageData() and putImageData()
+// against its scalar loops, checking that both produce the same bytes and reporting how long each one takes.
+//
+// On Linux, you can build this like so:
+// g++ -o PixelConversionSpeedTest Source/WebCore/benchmarks/PixelConversionSpeedTest.cpp -O2 -W -ISource/WTF -ISource/WebCore/platform/graphics/cpu/x86 -LWebKitBuild/Release/lib -lWTF -lpthread -std=c++14
+
+#include "config.h"
+
+#include "PixelConversionSSE2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/DataLog.h>
+#include <wtf/Vector.h>
+
+#if CPU(X86_SSE2)
+
+using namespace WebCore;
+
+namespace {
+
+unsigned iterations;
+bool allMatched = true;
+
+NO_RETURN void usage()
+{
+    printf("Usage: PixelConversionSpeedTest <iterations>\n");
+    exit(1);
+}
+
+// The scalar references below follow the loops of getImageData() and ImageBuffer::putByteArray()
+// in platform/graphics/cairo/ImageBufferCairo.cpp.
+
+void convertARGB32ToRGBA8Pixel(bool unpremultiply, uint32_t pixel, unsigned char* destination)
+{
+    unsigned alpha = (pixel & 0xFF000000) >> 24;
+    unsigned red = (pixel & 0x00FF0000) >> 16;
+    unsigned green = (pixel & 0x0000FF00) >> 8;
+    unsigned blue = (pixel & 0x000000FF);
+
+    if (unpremultiply) {
+        if (alpha && alpha != 255) {
+            red = red * 255 / alpha;
+            green = green * 255 / alpha;
+            blue = blue * 255 / alpha;
+        }
+    }
+
+    destination[0] = red;
+    destination[1] = green;
+    destination[2] = blue;
+    destination[3] = alpha;
+}
+
+uint32_t convertRGBA8ToARGB32Pixel(bool premultiply, const unsigned char* source)
+{
+    unsigned red = source[0];
+    unsigned green = source[1];
+    unsigned blue = source[2];
+    unsigned alpha = source[3];
+
+    if (premultiply) {
+        if (alpha != 255) {
+            red = (red * alpha + 254) / 255;
+            green = (green * alpha + 254) / 255;
+            blue = (blue * alpha + 254) / 255;
+        }
+    }
+
+    return (alpha << 24) | red  << 16 | green  << 8 | blue;
+}
+
+template<bool unpremultiply>
+void convertARGB32ToRGBA8(const uint32_t* source, unsigned char* destination, unsigned width, unsigned height, bool useSSE2)
+{
+    for (unsigned y = 0; y < height; ++y) {
+        const uint32_t* row = source + y * width;
+        unsigned char* destinationRow = destination + y * width * 4;
+        unsigned x = useSSE2 ? convertARGB32ToRGBA8SSE2<unpremultiply>(row, destinationRow, width) : 0;
+        for (; x < width; ++x)
+            convertARGB32ToRGBA8Pixel(unpremultiply, row[x], destinationRow + x * 4);
+    }
+}
+
+template<bool premultiply>
+void convertRGBA8ToARGB32(const unsigned char* source, uint32_t* destination, unsigned width, unsigned height, bool useSSE2)
+{
+    for (unsigned y = 0; y < height; ++y) {
+        const unsigned char* row = source + y * width * 4;
+        uint32_t* destinationRow = destination + y * width;
+        unsigned x = useSSE2 ? convertRGBA8ToARGB32SSE2<premultiply>(row, destinationRow, width) : 0;
+        for (; x < width; ++x)
+            destinationRow[x] = convertRGBA8ToARGB32Pixel(premultiply, row + x * 4);
+    }
+}
+
+template<typename Functor>
+double measure(const Functor& functor)
+{
+    double before = monotonicallyIncreasingTime();
+    for (unsigned i = iterations; i--;)
+        functor();
+    return (monotonicallyIncreasingTime() - before) * 1000 / iterations;
+}
+
+// The functor writes the converted pixels into the buffer it is given, using the SSE2 kernel when its
+// second argument is true.
+template<typename Functor>
+void run(const char* name, size_t resultSize, const Functor& convert)
+{
+    Vector<unsigned char> scalarResult(resultSize, 0);
+    Vector<unsigned char> sse2Result(resultSize, 0);
+    convert(scalarResult.data(), false);
+    convert(sse2Result.data(), true);
+    bool matched = scalarResult == sse2Result;
+    allMatched &= matched;
+
+    double scalarTime = measure([&] { convert(scalarResult.data(), false); });
+    double sse2Time = measure([&] { convert(sse2Result.data(), true); });
+    dataLogF("%-32s scalar: %8.3lf ms  SSE2: %8.3lf ms  speedup: %5.2lfx%s\n", name, scalarTime, sse2Time, scalarTime / sse2Time, matched ? "" : "  MISMATCH");
+}
+
+void runAll(const char* description, const Vector<uint32_t>& argb, const Vector<unsigned char>& rgba, unsigned width, unsigned height)
+{
+    size_t byteCount = width * height * 4;
+    char name[64];
+
+    snprintf(name, sizeof(name), "unpremultiply %s", description);
+    run(name, byteCount, [&] (unsigned char* result, bool useSSE2) {
+        convertARGB32ToRGBA8<true>(argb.data(), result, width, height, useSSE2);
+    });
+    snprintf(name, sizeof(name), "copy to RGBA %s", description);
+    run(name, byteCount, [&] (unsigned char* result, bool useSSE2) {
+        convertARGB32ToRGBA8<false>(argb.data(), result, width, height, useSSE2);
+    });
+    snprintf(name, sizeof(name), "premultiply %s", description);
+    run(name, byteCount, [&] (unsigned char* result, bool useSSE2) {
+        convertRGBA8ToARGB32<true>(rgba.data(), reinterpret_cast<uint32_t*>(result), width, height, useSSE2);
+    });
+    snprintf(name, sizeof(name), "copy to ARGB %s", description);
+    run(name, byteCount, [&] (unsigned char* result, bool useSSE2) {
+        convertRGBA8ToARGB32<false>(rgba.data(), reinterpret_cast<uint32_t*>(result), width, height, useSSE2);
+    });
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 2 || sscanf(argv[1], "%u", &iterations) != 1 || !iterations)
+        usage();
+
+    // Every combination of alpha and channel value, including premultiplied colors larger than alpha.
+    // The odd width leaves pixels for the scalar loop at the end of each row.
+    Vector<uint32_t> allARGB;
+    Vector<unsigned char> allRGBA;
+    for (unsigned alpha = 0; alpha < 256; ++alpha) {
+        for (unsigned value = 0; value < 256; ++value) {
+            allARGB.append(alpha << 24 | value << 16 | (255 - value) << 8 | (value * 7 & 255));
+            allRGBA.append(value);
+            allRGBA.append(255 - value);
+            allRGBA.append(value * 7);
+            allRGBA.append(alpha);
+        }
+    }
+    runAll("exhaustive", allARGB, allRGBA, 257, 255);
+
+    // A 4K canvas of valid premultiplied pixels, a quarter of them opaque.
+    const unsigned width = 3840;
+    const unsigned height = 2160;
+    Vector<uint32_t> canvasARGB(width * height);
+    Vector<unsigned char> canvasRGBA(width * height * 4);
+    srand(42);
+    for (unsigned i = 0; i < width * height; ++i) {
+        unsigned alpha = rand() % 4 ? rand() & 255 : 255;
+        unsigned red = rand() % (alpha + 1);
+        unsigned green = rand() % (alpha + 1);
+        unsigned blue = rand() % (alpha + 1);
+        canvasARGB[i] = alpha << 24 | red << 16 | green << 8 | blue;
+        for (unsigned channel = 0; channel < 4; ++channel)
+            canvasRGBA[i * 4 + channel] = channel == 3 ? alpha : rand();
+    }
+    runAll("4K canvas", canvasARGB, canvasRGBA, width, height);
+
+    return allMatched ? 0 : 1;
+}
+
+#else
+
+int main()
+{
+    printf("PixelConversionSpeedTest requires SSE2.\n");
+    return 1;
+}
+
+#endif // CPU(X86_SSE2)
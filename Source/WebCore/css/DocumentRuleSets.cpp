@@ -145,6 +145,7 @@ const DocumentRuleSets::AttributeRules* DocumentRuleSets::ancestorAttributeRules
             for (auto* selector : rules->selectors.values())
                 value->attributeSelectors.uncheckedAppend(selector);
             value->ruleSet = makeRuleSet(rules->features);
+            value->invalidationSet = rules->invalidationSet;
         }
     }
     return value.get();
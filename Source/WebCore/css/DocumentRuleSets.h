@@ -50,12 +50,14 @@ public:
     RuleSet* sibling() const { return m_siblingRuleSet.get(); }
     RuleSet* uncommonAttribute() const { return m_uncommonAttributeRuleSet.get(); }
     RuleSet* ancestorClassRules(const AtomicString& className) const;
+    const DescendantInvalidationSet* ancestorClassInvalidationSet(const AtomicString& className) const { return m_features.ancestorClassInvalidationSets.get(className); }
 
     struct AttributeRules {
         WTF_MAKE_FAST_ALLOCATED;
     public:
         Vector<const CSSSelector*> attributeSelectors;
         std::unique_ptr<RuleSet> ruleSet;
+        DescendantInvalidationSet invalidationSet;
     };
     const AttributeRules* ancestorAttributeRulesForHTML(const AtomicString&) const;
 
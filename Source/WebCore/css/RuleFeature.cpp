@@ -31,6 +31,8 @@
 
 #include "CSSSelector.h"
 #include "CSSSelectorList.h"
+#include "Document.h"
+#include "Element.h"
 #include "RuleSet.h"
 
 namespace WebCore {
@@ -84,6 +86,70 @@ void RuleFeatureSet::recursivelyCollectFeaturesFromSelector(SelectorFeatures& se
     } while (selector);
 }
 
+void DescendantInvalidationSet::addSubject(const CSSSelector& subject)
+{
+    bool hasIdentifier = false;
+    for (const CSSSelector* selector = &subject; selector; selector = selector->tagHistory()) {
+        switch (selector->match()) {
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            subjectIdentifiers.add(selector->value());
+            hasIdentifier = true;
+            break;
+        case CSSSelector::Tag:
+            if (selector->tagQName().localName() != starAtom) {
+                subjectIdentifiers.add(selector->tagQName().localName());
+                subjectIdentifiers.add(selector->tagLowercaseLocalName());
+                hasIdentifier = true;
+            }
+            break;
+        case CSSSelector::PseudoElement:
+            // Pseudo-elements such as ::slotted() and ::cue style elements other than the one carrying the identifiers.
+            affectsAllDescendants = true;
+            return;
+        case CSSSelector::PseudoClass:
+            if (selector->pseudoClassType() == CSSSelector::PseudoClassHost) {
+                affectsAllDescendants = true;
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        if (selector->relation() != CSSSelector::Subselector)
+            break;
+    }
+    if (!hasIdentifier)
+        affectsAllDescendants = true;
+}
+
+void DescendantInvalidationSet::add(const DescendantInvalidationSet& other)
+{
+    affectsAllDescendants = affectsAllDescendants || other.affectsAllDescendants;
+    subjectIdentifiers.add(other.subjectIdentifiers);
+}
+
+bool DescendantInvalidationSet::mayAffect(const Element& element) const
+{
+    if (affectsAllDescendants)
+        return true;
+    // Ids and classes match case-insensitively in quirks mode.
+    if (element.document().inQuirksMode())
+        return true;
+    if (subjectIdentifiers.mayContain(element.localName()))
+        return true;
+    if (element.hasID() && subjectIdentifiers.mayContain(element.idForStyleResolution()))
+        return true;
+    if (element.hasClass()) {
+        auto& classNames = element.classNames();
+        for (unsigned i = 0; i < classNames.size(); ++i) {
+            if (subjectIdentifiers.mayContain(classNames[i]))
+                return true;
+        }
+    }
+    return false;
+}
+
 static RuleFeatureSet::AttributeRules::SelectorKey makeAttributeSelectorKey(const CSSSelector& selector)
 {
     bool caseInsensitive = selector.attributeValueMatchingIsCaseInsensitive();
@@ -104,6 +170,10 @@ void RuleFeatureSet::collectFeatures(const RuleData& ruleData)
             return std::make_unique<Vector<RuleFeature>>();
         });
         addResult.iterator->value->append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
+        auto invalidationSetResult = ancestorClassInvalidationSets.ensure(className, [] {
+            return std::make_unique<DescendantInvalidationSet>();
+        });
+        invalidationSetResult.iterator->value->addSubject(*ruleData.selector());
     }
     for (auto* selector : selectorFeatures.attributeSelectorsMatchingAncestors) {
         // Hashing by attributeCanonicalLocalName makes this HTML specific.
@@ -112,6 +182,7 @@ void RuleFeatureSet::collectFeatures(const RuleData& ruleData)
         });
         auto& rules = *addResult.iterator->value;
         rules.features.append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
+        rules.invalidationSet.addSubject(*ruleData.selector());
         // Deduplicate selectors.
         rules.selectors.add(makeAttributeSelectorKey(*selector), selector);
     }
@@ -132,12 +203,19 @@ void RuleFeatureSet::add(const RuleFeatureSet& other)
         });
         addResult.iterator->value->appendVector(*keyValuePair.value);
     }
+    for (auto& keyValuePair : other.ancestorClassInvalidationSets) {
+        auto addResult = ancestorClassInvalidationSets.ensure(keyValuePair.key, [] {
+            return std::make_unique<DescendantInvalidationSet>();
+        });
+        addResult.iterator->value->add(*keyValuePair.value);
+    }
     for (auto& keyValuePair : other.ancestorAttributeRulesForHTML) {
         auto addResult = ancestorAttributeRulesForHTML.ensure(keyValuePair.key, [] {
             return std::make_unique<AttributeRules>();
         });
         auto& rules = *addResult.iterator->value;
         rules.features.appendVector(keyValuePair.value->features);
+        rules.invalidationSet.add(keyValuePair.value->invalidationSet);
         for (auto& selectorPair : keyValuePair.value->selectors)
             rules.selectors.add(selectorPair.key, selectorPair.value);
     }
@@ -155,6 +233,7 @@ void RuleFeatureSet::clear()
     siblingRules.clear();
     uncommonAttributeRules.clear();
     ancestorClassRules.clear();
+    ancestorClassInvalidationSets.clear();
     ancestorAttributeRulesForHTML.clear();
     usesFirstLineRules = false;
     usesFirstLetterRules = false;
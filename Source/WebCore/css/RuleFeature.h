@@ -22,6 +22,7 @@
 #pragma once
 
 #include "CSSSelector.h"
+#include <wtf/BloomFilter.h>
 #include <wtf/Forward.h>
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
@@ -30,6 +31,7 @@
 
 namespace WebCore {
 
+class Element;
 class RuleData;
 class StyleRule;
 
@@ -45,6 +47,17 @@ struct RuleFeature {
     bool hasDocumentSecurityOrigin;
 };
 
+// Identifiers required by the subject compound selectors of the rules that depend on an ancestor class or attribute.
+// When that ancestor changes, a descendant carrying none of them can't start or stop matching any of those rules.
+struct DescendantInvalidationSet {
+    void addSubject(const CSSSelector& subject);
+    void add(const DescendantInvalidationSet&);
+    bool mayAffect(const Element&) const;
+
+    bool affectsAllDescendants { false };
+    BloomFilter<10> subjectIdentifiers;
+};
+
 struct RuleFeatureSet {
     void add(const RuleFeatureSet&);
     void clear();
@@ -59,6 +72,7 @@ struct RuleFeatureSet {
     Vector<RuleFeature> siblingRules;
     Vector<RuleFeature> uncommonAttributeRules;
     HashMap<AtomicString, std::unique_ptr<Vector<RuleFeature>>> ancestorClassRules;
+    HashMap<AtomicString, std::unique_ptr<DescendantInvalidationSet>> ancestorClassInvalidationSets;
 
     struct AttributeRules {
         WTF_MAKE_FAST_ALLOCATED;
@@ -66,6 +80,7 @@ struct RuleFeatureSet {
         using SelectorKey = std::pair<AtomicStringImpl*, std::pair<AtomicStringImpl*, unsigned>>;
         HashMap<SelectorKey, const CSSSelector*> selectors;
         Vector<RuleFeature> features;
+        DescendantInvalidationSet invalidationSet;
     };
     HashMap<AtomicString, std::unique_ptr<AttributeRules>> ancestorAttributeRulesForHTML;
     bool usesFirstLineRules { false };
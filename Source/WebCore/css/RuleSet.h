@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "CompiledSelectorCache.h"
 #include "RuleFeature.h"
 #include "SelectorCompiler.h"
 #include "StyleRule.h"
@@ -87,16 +88,16 @@ public:
 
 #if ENABLE(CSS_SELECTOR_JIT)
     SelectorCompilationStatus compilationStatus() const { return m_compilationStatus; }
-    JSC::MacroAssemblerCodeRef compiledSelectorCodeRef() const { return m_compiledSelectorCodeRef; }
-    void setCompiledSelector(SelectorCompilationStatus status, JSC::MacroAssemblerCodeRef codeRef) const
+    void* compiledSelectorCode() const { return m_compiledSelector ? m_compiledSelector->code() : nullptr; }
+    void setCompiledSelector(Ref<CompiledSelector>&& compiledSelector) const
     {
-        m_compilationStatus = status;
-        m_compiledSelectorCodeRef = codeRef;
+        m_compilationStatus = compiledSelector->status();
+        m_compiledSelector = WTFMove(compiledSelector);
     }
 #if CSS_SELECTOR_JIT_PROFILING
     ~RuleData()
     {
-        if (m_compiledSelectorCodeRef.code().executableAddress())
+        if (compiledSelectorCode())
             dataLogF("RuleData compiled selector %d \"%s\"\n", m_compiledSelectorUseCount, selector()->selectorText().utf8().data());
     }
     void compiledSelectorUsed() const { m_compiledSelectorUseCount++; }
@@ -119,7 +120,7 @@ private:
     unsigned m_descendantSelectorIdentifierHashes[maximumIdentifierCount];
 #if ENABLE(CSS_SELECTOR_JIT)
     mutable SelectorCompilationStatus m_compilationStatus;
-    mutable JSC::MacroAssemblerCodeRef m_compiledSelectorCodeRef;
+    mutable RefPtr<CompiledSelector> m_compiledSelector;
 #if CSS_SELECTOR_JIT_PROFILING
     mutable unsigned m_compiledSelectorUseCount;
 #endif
@@ -130,7 +131,6 @@ struct SameSizeAsRuleData {
 #if ENABLE(CSS_SELECTOR_JIT)
     unsigned compilationStatus;
     void* compiledSelectorPointer;
-    void* codeRefPtr;
 #if CSS_SELECTOR_JIT_PROFILING
     unsigned compiledSelectorUseCount;
 #endif
@@ -31,6 +31,7 @@
 #include "ElementIterator.h"
 #include "ElementRuleCollector.h"
 #include "HTMLSlotElement.h"
+#include "RuleFeature.h"
 #include "SelectorFilter.h"
 #include "ShadowRoot.h"
 #include "StyleRuleImport.h"
@@ -91,8 +92,9 @@ StyleInvalidationAnalysis::StyleInvalidationAnalysis(const Vector<StyleSheetCont
     m_hasShadowPseudoElementRulesInAuthorSheet = m_ruleSet.hasShadowPseudoElementRules();
 }
 
-StyleInvalidationAnalysis::StyleInvalidationAnalysis(const RuleSet& ruleSet)
+StyleInvalidationAnalysis::StyleInvalidationAnalysis(const RuleSet& ruleSet, const DescendantInvalidationSet* descendantInvalidationSet)
     : m_ruleSet(ruleSet)
+    , m_descendantInvalidationSet(descendantInvalidationSet)
     , m_hasShadowPseudoElementRulesInAuthorSheet(ruleSet.hasShadowPseudoElementRules())
 {
 }
@@ -118,6 +120,9 @@ StyleInvalidationAnalysis::CheckDescendants StyleInvalidationAnalysis::invalidat
 
     switch (element.styleValidity()) {
     case Style::Validity::Valid: {
+        if (m_descendantInvalidationSet && !m_descendantInvalidationSet->mayAffect(element))
+            return CheckDescendants::Yes;
+
         ElementRuleCollector ruleCollector(element, m_ruleSet, filter);
         ruleCollector.setMode(SelectorChecker::Mode::CollectingRulesIgnoringVirtualPseudoElements);
         ruleCollector.matchAuthorRules(false);
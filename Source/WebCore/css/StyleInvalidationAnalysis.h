@@ -31,6 +31,7 @@ namespace WebCore {
 
 class Document;
 class Element;
+struct DescendantInvalidationSet;
 class MediaQueryEvaluator;
 class RuleSet;
 class SelectorFilter;
@@ -40,7 +41,7 @@ class StyleSheetContents;
 class StyleInvalidationAnalysis {
 public:
     StyleInvalidationAnalysis(const Vector<StyleSheetContents*>&, const MediaQueryEvaluator&);
-    StyleInvalidationAnalysis(const RuleSet&);
+    StyleInvalidationAnalysis(const RuleSet&, const DescendantInvalidationSet* = nullptr);
 
     bool dirtiesAllStyle() const { return m_dirtiesAllStyle; }
     bool hasShadowPseudoElementRulesInAuthorSheet() const { return m_hasShadowPseudoElementRulesInAuthorSheet; }
@@ -55,6 +56,7 @@ private:
 
     std::unique_ptr<RuleSet> m_ownedRuleSet;
     const RuleSet& m_ruleSet;
+    const DescendantInvalidationSet* m_descendantInvalidationSet { nullptr };
     bool m_dirtiesAllStyle { false };
     bool m_hasShadowPseudoElementRulesInAuthorSheet { false };
     bool m_didInvalidateHostChildren { false };
@@ -24,6 +24,7 @@
 #include "CSSImportRule.h"
 #include "CSSParser.h"
 #include "CSSStyleSheet.h"
+#include "CSSTokenizer.h"
 #include "CachedCSSStyleSheet.h"
 #include "Document.h"
 #include "MediaList.h"
@@ -310,15 +311,23 @@ const AtomicString& StyleSheetContents::namespaceURIFromPrefix(const AtomicStrin
 }
 
 void StyleSheetContents::parseAuthorStyleSheet(const CachedCSSStyleSheet* cachedStyleSheet, const SecurityOrigin* securityOrigin)
+{
+    String sheetText;
+    if (!authorStyleSheetText(cachedStyleSheet, securityOrigin, singleOwnerDocument(), sheetText))
+        return;
+    parseAuthorStyleSheetText(sheetText);
+}
+
+bool StyleSheetContents::authorStyleSheetText(const CachedCSSStyleSheet* cachedStyleSheet, const SecurityOrigin* securityOrigin, Document* document, String& sheetText)
 {
     bool isSameOriginRequest = securityOrigin && securityOrigin->canRequest(baseURL());
     CachedCSSStyleSheet::MIMETypeCheck mimeTypeCheck = isStrictParserMode(m_parserContext.mode) || !isSameOriginRequest ? CachedCSSStyleSheet::MIMETypeCheck::Strict : CachedCSSStyleSheet::MIMETypeCheck::Lax;
     bool hasValidMIMEType = true;
-    String sheetText = cachedStyleSheet->sheetText(mimeTypeCheck, &hasValidMIMEType);
+    sheetText = cachedStyleSheet->sheetText(mimeTypeCheck, &hasValidMIMEType);
 
     if (!hasValidMIMEType) {
         ASSERT(sheetText.isNull());
-        if (auto* document = singleOwnerDocument()) {
+        if (document) {
             if (auto* page = document->page()) {
                 if (isStrictParserMode(m_parserContext.mode))
                     page->console().addMessage(MessageSource::Security, MessageLevel::Error, "Did not parse stylesheet at '" + cachedStyleSheet->url().stringCenterEllipsizedToLength() + "' because non CSS MIME types are not allowed in strict mode.");
@@ -326,11 +335,18 @@ void StyleSheetContents::parseAuthorStyleSheet(const CachedCSSStyleSheet* cached
                     page->console().addMessage(MessageSource::Security, MessageLevel::Error, "Did not parse stylesheet at '" + cachedStyleSheet->url().stringCenterEllipsizedToLength() + "' because non CSS MIME types are not allowed for cross-origin stylesheets.");
             }
         }
-        return;
+        return false;
     }
+    return true;
+}
 
+void StyleSheetContents::parseAuthorStyleSheetText(const String& sheetText, std::unique_ptr<CSSTokenizer>&& tokenizer)
+{
     CSSParser p(parserContext());
-    p.parseSheet(this, sheetText, CSSParser::RuleParsing::Deferred);
+    if (tokenizer)
+        p.parseSheet(this, sheetText, WTFMove(tokenizer), CSSParser::RuleParsing::Deferred);
+    else
+        p.parseSheet(this, sheetText, CSSParser::RuleParsing::Deferred);
 
     if (m_parserContext.needsSiteSpecificQuirks && isStrictParserMode(m_parserContext.mode)) {
         // Work around <https://bugs.webkit.org/show_bug.cgi?id=28350>.
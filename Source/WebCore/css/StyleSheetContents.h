@@ -34,6 +34,7 @@
 namespace WebCore {
 
 class CSSStyleSheet;
+class CSSTokenizer;
 class CachedCSSStyleSheet;
 class CachedResource;
 class Document;
@@ -66,6 +67,9 @@ public:
     const AtomicString& namespaceURIFromPrefix(const AtomicString& prefix);
 
     void parseAuthorStyleSheet(const CachedCSSStyleSheet*, const SecurityOrigin*);
+    // Returns false, and logs why to the console of the document, if the sheet must not be parsed because of its MIME type.
+    bool authorStyleSheetText(const CachedCSSStyleSheet*, const SecurityOrigin*, Document*, String& sheetText);
+    void parseAuthorStyleSheetText(const String&, std::unique_ptr<CSSTokenizer>&& = nullptr);
     WEBCORE_EXPORT bool parseString(const String&);
 
     bool isCacheable() const;
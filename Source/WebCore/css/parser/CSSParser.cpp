@@ -125,6 +125,11 @@ void CSSParser::parseSheet(StyleSheetContents* sheet, const String& string, Rule
     return CSSParserImpl::parseStyleSheet(string, m_context, sheet, ruleParsing);
 }
 
+void CSSParser::parseSheet(StyleSheetContents* sheet, const String& string, std::unique_ptr<CSSTokenizer>&& tokenizer, RuleParsing ruleParsing)
+{
+    return CSSParserImpl::parseStyleSheet(string, WTFMove(tokenizer), m_context, sheet, ruleParsing);
+}
+
 void CSSParser::parseSheetForInspector(const CSSParserContext& context, StyleSheetContents* sheet, const String& string, CSSParserObserver& observer)
 {
     return CSSParserImpl::parseStyleSheetForInspector(string, context, sheet, observer);
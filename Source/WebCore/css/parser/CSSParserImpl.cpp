@@ -80,6 +80,16 @@ CSSParserImpl::CSSParserImpl(const CSSParserContext& context, const String& stri
         m_deferredParser = CSSDeferredParser::create(context, string, *styleSheet);
 }
 
+CSSParserImpl::CSSParserImpl(const CSSParserContext& context, const String& string, std::unique_ptr<CSSTokenizer>&& tokenizer, StyleSheetContents* styleSheet, CSSParser::RuleParsing ruleParsing)
+    : m_context(context)
+    , m_styleSheet(styleSheet)
+    , m_tokenizer(WTFMove(tokenizer))
+{
+    ASSERT(m_tokenizer);
+    if (context.deferredCSSParserEnabled && styleSheet && ruleParsing == CSSParser::RuleParsing::Deferred)
+        m_deferredParser = CSSDeferredParser::create(context, string, *styleSheet);
+}
+
 CSSParser::ParseResult CSSParserImpl::parseValue(MutableStyleProperties* declaration, CSSPropertyID propertyID, const String& string, bool important, const CSSParserContext& context)
 {
     CSSParserImpl parser(context, string);
@@ -241,13 +251,25 @@ RefPtr<StyleRuleBase> CSSParserImpl::parseRule(const String& string, const CSSPa
 void CSSParserImpl::parseStyleSheet(const String& string, const CSSParserContext& context, StyleSheetContents* styleSheet, CSSParser::RuleParsing ruleParsing)
 {
     CSSParserImpl parser(context, string, styleSheet, nullptr, ruleParsing);
-    bool firstRuleValid = parser.consumeRuleList(parser.tokenizer()->tokenRange(), TopLevelRuleList, [&styleSheet](RefPtr<StyleRuleBase> rule) {
+    parser.parseStyleSheetRules();
+}
+
+void CSSParserImpl::parseStyleSheet(const String& string, std::unique_ptr<CSSTokenizer>&& tokenizer, const CSSParserContext& context, StyleSheetContents* styleSheet, CSSParser::RuleParsing ruleParsing)
+{
+    CSSParserImpl parser(context, string, WTFMove(tokenizer), styleSheet, ruleParsing);
+    parser.parseStyleSheetRules();
+}
+
+void CSSParserImpl::parseStyleSheetRules()
+{
+    ASSERT(m_styleSheet);
+    bool firstRuleValid = consumeRuleList(m_tokenizer->tokenRange(), TopLevelRuleList, [this](RefPtr<StyleRuleBase> rule) {
         if (rule->isCharsetRule())
             return;
-        styleSheet->parserAppendRule(rule.releaseNonNull());
+        m_styleSheet->parserAppendRule(rule.releaseNonNull());
     });
-    styleSheet->setHasSyntacticallyValidCSSHeader(firstRuleValid);
-    parser.adoptTokenizerEscapedStrings();
+    m_styleSheet->setHasSyntacticallyValidCSSHeader(firstRuleValid);
+    adoptTokenizerEscapedStrings();
 }
 
 void CSSParserImpl::adoptTokenizerEscapedStrings()
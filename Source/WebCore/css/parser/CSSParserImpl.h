@@ -91,6 +91,8 @@ public:
     static bool parseDeclarationList(MutableStyleProperties*, const String&, const CSSParserContext&);
     static RefPtr<StyleRuleBase> parseRule(const String&, const CSSParserContext&, StyleSheetContents*, AllowedRulesType);
     static void parseStyleSheet(const String&, const CSSParserContext&, StyleSheetContents*, CSSParser::RuleParsing);
+    // For a string that was already tokenized by the given tokenizer, e.g. on a background thread.
+    static void parseStyleSheet(const String&, std::unique_ptr<CSSTokenizer>&&, const CSSParserContext&, StyleSheetContents*, CSSParser::RuleParsing);
     static CSSSelectorList parsePageSelector(CSSParserTokenRange, StyleSheetContents*);
 
     static std::unique_ptr<Vector<double>> parseKeyframeKeyList(const String&);
@@ -110,6 +112,9 @@ public:
 private:
     CSSParserImpl(const CSSParserContext&, StyleSheetContents*);
     CSSParserImpl(CSSDeferredParser&);
+    CSSParserImpl(const CSSParserContext&, const String&, std::unique_ptr<CSSTokenizer>&&, StyleSheetContents*, CSSParser::RuleParsing);
+
+    void parseStyleSheetRules();
 
     enum RuleListType {
         TopLevelRuleList,
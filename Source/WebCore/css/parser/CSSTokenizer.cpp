@@ -35,6 +35,9 @@
 #include "CSSParserTokenRange.h"
 #include "CSSTokenizerInputStream.h"
 #include "HTMLParserIdioms.h"
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
 #include <wtf/text/StringBuilder.h>
 #include <wtf/unicode/CharacterNames.h>
 
@@ -92,6 +95,26 @@ CSSTokenizer::CSSTokenizer(const String& string, CSSParserObserverWrapper& wrapp
     wrapper.finalizeConstruction(m_tokens.begin());
 }
 
+static WorkQueue& backgroundTokenizationQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("com.apple.WebCore.CSSTokenizer"));
+    return queue.get();
+}
+
+void CSSTokenizer::tokenizeInBackground(const String& string, Function<void(String&&, std::unique_ptr<CSSTokenizer>&&)>&& completionHandler)
+{
+    ASSERT(isMainThread());
+
+    // Nothing captured here is touched by the main thread until it is handed back, so strings created on
+    // the background queue (the copy and the tokenizer's escaped strings) never see concurrent ref counting.
+    backgroundTokenizationQueue().dispatch([string = string.isolatedCopy(), completionHandler = WTFMove(completionHandler)]() mutable {
+        auto tokenizer = std::make_unique<CSSTokenizer>(string);
+        callOnMainThread([string = WTFMove(string), tokenizer = WTFMove(tokenizer), completionHandler = WTFMove(completionHandler)]() mutable {
+            completionHandler(WTFMove(string), WTFMove(tokenizer));
+        });
+    });
+}
+
 CSSParserTokenRange CSSTokenizer::tokenRange() const
 {
     return m_tokens;
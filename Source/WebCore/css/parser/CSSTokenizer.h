@@ -32,6 +32,7 @@
 #include "CSSParserToken.h"
 #include "CSSTokenizerInputStream.h"
 #include <climits>
+#include <wtf/Function.h>
 #include <wtf/text/StringView.h>
 #include <wtf/text/WTFString.h>
 
@@ -53,6 +54,10 @@ public:
 
     Vector<String>&& escapedStringsForAdoption() { return WTFMove(m_stringPool); }
 
+    // Tokenizes an isolated copy of the string on a background queue, then hands it and its tokenizer
+    // to the completion handler on the main thread. The tokens point into that copy, not into the original.
+    static void tokenizeInBackground(const String&, Function<void(String&&, std::unique_ptr<CSSTokenizer>&&)>&&);
+
 private:
     CSSParserToken nextToken();
 
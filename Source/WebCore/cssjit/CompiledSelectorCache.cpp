@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "CompiledSelectorCache.h"
+
+#if ENABLE(CSS_SELECTOR_JIT)
+
+#include "CSSSelector.h"
+#include <wtf/NeverDestroyed.h>
+
+namespace WebCore {
+
+static const unsigned maximumCachedSelectors = 8192;
+
+CompiledSelector::CompiledSelector(const CSSSelectorList& selectorList)
+    : m_selectorList(selectorList)
+{
+}
+
+Ref<CompiledSelector> CompiledSelector::create(const CSSSelectorList& selectorList, unsigned selectorIndex, JSC::VM& vm)
+{
+    auto compiledSelector = adoptRef(*new CompiledSelector(selectorList));
+    compiledSelector->m_status = SelectorCompiler::compileSelector(compiledSelector->m_selectorList.selectorAt(selectorIndex), &vm, SelectorCompiler::SelectorContext::RuleCollector, compiledSelector->m_codeRef);
+    return compiledSelector;
+}
+
+CompiledSelectorCache& CompiledSelectorCache::singleton()
+{
+    static NeverDestroyed<CompiledSelectorCache> cache;
+    return cache;
+}
+
+// Selector text leaves out the namespaces of type and attribute selectors (a default namespace is not
+// serialized at all), so it only identifies selectors that do not involve namespaces.
+static bool selectorTextIdentifiesSelector(const CSSSelector& complexSelector)
+{
+    for (const CSSSelector* selector = &complexSelector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::Tag && selector->tagQName().namespaceURI() != starAtom)
+            return false;
+        if (selector->isAttributeSelector() && !selector->attribute().namespaceURI().isNull() && selector->attribute().namespaceURI() != starAtom)
+            return false;
+        if (auto* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subselector = selectorList->first(); subselector; subselector = CSSSelectorList::next(subselector)) {
+                if (!selectorTextIdentifiesSelector(*subselector))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+Ref<CompiledSelector> CompiledSelectorCache::compiledSelector(const CSSSelectorList& selectorList, unsigned selectorIndex, JSC::VM& vm)
+{
+    const CSSSelector& selector = *selectorList.selectorAt(selectorIndex);
+    if (!selectorTextIdentifiesSelector(selector))
+        return CompiledSelector::create(selectorList, selectorIndex, vm);
+
+    String selectorText = selector.selectorText();
+    m_recentlyUsedSelectors.appendOrMoveToLast(selectorText);
+
+    auto addResult = m_selectors.add(selectorText, nullptr);
+    if (!addResult.isNewEntry)
+        return *addResult.iterator->value;
+
+    auto compiledSelector = CompiledSelector::create(selectorList, selectorIndex, vm);
+    addResult.iterator->value = compiledSelector.ptr();
+
+    if (m_selectors.size() > maximumCachedSelectors)
+        m_selectors.remove(m_recentlyUsedSelectors.takeFirst());
+
+    return compiledSelector;
+}
+
+void CompiledSelectorCache::clear()
+{
+    m_selectors.clear();
+    m_recentlyUsedSelectors.clear();
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(CSS_SELECTOR_JIT)
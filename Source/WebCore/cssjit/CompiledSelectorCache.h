@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#pragma once
+
+#if ENABLE(CSS_SELECTOR_JIT)
+
+#include "CSSSelectorList.h"
+#include "SelectorCompiler.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/RefCounted.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+// Compiled code for one selector of a selector list. The code points into the selectors it was
+// compiled from, so it is compiled from a copy of the list that it owns. That lets it outlive the
+// style sheet it came from and be shared by every rule with the same selector.
+class CompiledSelector : public RefCounted<CompiledSelector> {
+public:
+    static Ref<CompiledSelector> create(const CSSSelectorList&, unsigned selectorIndex, JSC::VM&);
+
+    SelectorCompilationStatus status() const { return m_status; }
+    void* code() const { return m_codeRef.code().executableAddress(); }
+
+private:
+    CompiledSelector(const CSSSelectorList&);
+
+    CSSSelectorList m_selectorList;
+    SelectorCompilationStatus m_status;
+    JSC::MacroAssemblerCodeRef m_codeRef;
+};
+
+// Process-wide cache of the selectors compiled for style resolution, keyed by selector text, so that
+// documents using the same style sheets do not compile the same selectors over and over.
+class CompiledSelectorCache {
+    WTF_MAKE_NONCOPYABLE(CompiledSelectorCache); WTF_MAKE_FAST_ALLOCATED;
+    friend class NeverDestroyed<CompiledSelectorCache>;
+public:
+    WEBCORE_EXPORT static CompiledSelectorCache& singleton();
+
+    Ref<CompiledSelector> compiledSelector(const CSSSelectorList&, unsigned selectorIndex, JSC::VM&);
+
+    WEBCORE_EXPORT void clear();
+
+private:
+    CompiledSelectorCache() = default;
+
+    HashMap<String, RefPtr<CompiledSelector>> m_selectors;
+    // The text of the cached selectors, least recently used first.
+    ListHashSet<String> m_recentlyUsedSelectors;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(CSS_SELECTOR_JIT)
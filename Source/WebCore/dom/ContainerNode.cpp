@@ -58,6 +58,7 @@
 #include "SVGNames.h"
 #include "SVGUseElement.h"
 #include "SelectorQuery.h"
+#include "StaticNodeList.h"
 #include "TemplateContentDocumentFragment.h"
 #include <algorithm>
 #include <wtf/Variant.h>
@@ -889,7 +890,21 @@ ExceptionOr<Ref<NodeList>> ContainerNode::querySelectorAll(const String& selecto
     auto query = document().selectorQueryForString(selectors);
     if (query.hasException())
         return query.releaseException();
-    return query.releaseReturnValue().queryAll(*this);
+    auto& selectorQuery = query.releaseReturnValue();
+    if (!selectorQuery.canCacheResults())
+        return selectorQuery.queryAll(*this);
+
+    // Scripts tend to run the same query over and over on an unchanged tree. Each call still gets its own NodeList.
+    Vector<Ref<Element>> elements;
+    if (auto* cachedElements = document().cachedQuerySelectorAllResult(*this, selectors)) {
+        elements.reserveInitialCapacity(cachedElements->size());
+        for (auto& element : *cachedElements)
+            elements.uncheckedAppend(element.copyRef());
+    } else {
+        elements = selectorQuery.queryAllElements(*this);
+        document().addQuerySelectorAllResult(*this, selectors, elements);
+    }
+    return Ref<NodeList> { StaticElementList::create(WTFMove(elements)) };
 }
 
 Ref<HTMLCollection> ContainerNode::getElementsByTagName(const AtomicString& qualifiedName)
@@ -533,6 +533,7 @@ Document::Document(Frame* frame, const URL& url, unsigned documentClasses, unsig
 #endif
     , m_didAssociateFormControlsTimer(*this, &Document::didAssociateFormControlsTimerFired)
     , m_cookieCacheExpiryTimer(*this, &Document::invalidateDOMCookieCache)
+    , m_querySelectorAllResultsClearTimer(*this, &Document::clearQuerySelectorAllResults)
     , m_disabledFieldsetElementsCount(0)
     , m_hasInjectedPlugInsScript(false)
     , m_hasStyleWithViewportUnits(false)
@@ -679,6 +680,7 @@ void Document::removedLastRef()
         m_documentElement = nullptr;
         m_focusNavigationStartingNode = nullptr;
         m_userActionElements.documentDidRemoveLastRef();
+        clearQuerySelectorAllResults();
 #if ENABLE(FULLSCREEN_API)
         m_fullScreenElement = nullptr;
         m_fullScreenElementStack.clear();
@@ -779,6 +781,52 @@ ExceptionOr<SelectorQuery&> Document::selectorQueryForString(const String& selec
 void Document::clearSelectorQueryCache()
 {
     m_selectorQueryCache = nullptr;
+    // The results were computed with the old selector queries, e.g. in a different compatibility mode.
+    invalidateQuerySelectorAllResults();
+}
+
+const Vector<Ref<Element>>* Document::cachedQuerySelectorAllResult(ContainerNode& rootNode, const String& selectors) const
+{
+    if (m_querySelectorAllResultsAreStale)
+        return nullptr;
+    for (auto& result : m_querySelectorAllResults) {
+        if (result.selectors == selectors && (result.rootNode ? result.rootNode.get() : this) == &rootNode)
+            return &result.elements;
+    }
+    return nullptr;
+}
+
+void Document::addQuerySelectorAllResult(ContainerNode& rootNode, const String& selectors, const Vector<Ref<Element>>& elements)
+{
+    if (m_querySelectorAllResultsAreStale)
+        clearQuerySelectorAllResults();
+
+    static const unsigned maximumQuerySelectorAllResults = 8;
+    if (m_querySelectorAllResults.size() == maximumQuerySelectorAllResults)
+        m_querySelectorAllResults.remove(0);
+
+    Vector<Ref<Element>> elementsCopy;
+    elementsCopy.reserveInitialCapacity(elements.size());
+    for (auto& element : elements)
+        elementsCopy.uncheckedAppend(element.copyRef());
+    // Referencing the document from itself would keep it alive forever.
+    m_querySelectorAllResults.append({ &rootNode == this ? nullptr : &rootNode, selectors, WTFMove(elementsCopy) });
+}
+
+void Document::invalidateQuerySelectorAllResults()
+{
+    if (m_querySelectorAllResults.isEmpty() || m_querySelectorAllResultsAreStale)
+        return;
+    // This happens in the middle of DOM mutations, where letting go of the last reference to a node isn't safe.
+    m_querySelectorAllResultsAreStale = true;
+    m_querySelectorAllResultsClearTimer.startOneShot(0);
+}
+
+void Document::clearQuerySelectorAllResults()
+{
+    m_querySelectorAllResults.clear();
+    m_querySelectorAllResultsAreStale = false;
+    m_querySelectorAllResultsClearTimer.stop();
 }
 
 MediaQueryMatcher& Document::mediaQueryMatcher()
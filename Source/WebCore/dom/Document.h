@@ -928,9 +928,19 @@ public:
     TransformSource* transformSource() const { return m_transformSource.get(); }
 #endif
 
-    void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
+    void incDOMTreeVersion()
+    {
+        m_domTreeVersion = ++s_globalTreeVersion;
+        if (!m_querySelectorAllResults.isEmpty())
+            invalidateQuerySelectorAllResults();
+    }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // Results of querySelectorAll() for selectors that only depend on the tree. They are dropped as soon as the tree changes.
+    const Vector<Ref<Element>>* cachedQuerySelectorAllResult(ContainerNode& rootNode, const String& selectors) const;
+    void addQuerySelectorAllResult(ContainerNode& rootNode, const String& selectors, const Vector<Ref<Element>>&);
+    void invalidateQuerySelectorAllResults();
+
     // XPathEvaluator methods
     WEBCORE_EXPORT ExceptionOr<Ref<XPathExpression>> createExpression(const String& expression, RefPtr<XPathNSResolver>&&);
     WEBCORE_EXPORT Ref<XPathNSResolver> createNSResolver(Node* nodeResolver);
@@ -1372,6 +1382,8 @@ private:
     void invalidateDOMCookieCache();
     void didLoadResourceSynchronously() final;
 
+    void clearQuerySelectorAllResults();
+
     void checkViewportDependentPictures();
 
 #if USE(QUICK_LOOK)
@@ -1579,6 +1591,14 @@ private:
 
     std::unique_ptr<SelectorQueryCache> m_selectorQueryCache;
 
+    struct QuerySelectorAllResult {
+        RefPtr<ContainerNode> rootNode; // Null for the document itself.
+        String selectors;
+        Vector<Ref<Element>> elements;
+    };
+    Vector<QuerySelectorAllResult> m_querySelectorAllResults;
+    bool m_querySelectorAllResultsAreStale { false };
+
     DocumentClassFlags m_documentClasses;
 
     bool m_isSynthesized;
@@ -1707,6 +1727,7 @@ private:
 
     Timer m_didAssociateFormControlsTimer;
     Timer m_cookieCacheExpiryTimer;
+    Timer m_querySelectorAllResultsClearTimer;
     String m_cachedDOMCookies;
     HashSet<RefPtr<Element>> m_associatedFormControls;
     unsigned m_disabledFieldsetElementsCount;
@@ -76,6 +76,20 @@ static IdMatchingType findIdMatchingType(const CSSSelector& firstSelector)
     return IdMatchingType::None;
 }
 
+static bool isTagAndClassNamesCompound(const CSSSelector& firstSelector)
+{
+    bool hasClass = false;
+    for (const CSSSelector* selector = &firstSelector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::Class)
+            hasClass = true;
+        else if (selector->match() != CSSSelector::Tag || selector->tagQName().namespaceURI() != starAtom)
+            return false;
+        if (!selector->isLastInTagHistory() && selector->relation() != CSSSelector::Subselector)
+            return false;
+    }
+    return hasClass;
+}
+
 SelectorDataList::SelectorDataList(const CSSSelectorList& selectorList)
 {
     unsigned selectorCount = 0;
@@ -106,7 +120,7 @@ SelectorDataList::SelectorDataList(const CSSSelectorList& selectorList)
         } else {
             switch (findIdMatchingType(selector)) {
             case IdMatchingType::None:
-                m_matchType = CompilableSingle;
+                m_matchType = isTagAndClassNamesCompound(selector) ? TagAndClassNamesMatch : CompilableSingle;
                 break;
             case IdMatchingType::Rightmost:
                 m_matchType = RightMostWithIdMatch;
@@ -170,10 +184,15 @@ struct AllElementExtractorSelectorQueryTrait {
 };
 
 Ref<NodeList> SelectorDataList::queryAll(ContainerNode& rootNode) const
+{
+    return StaticElementList::create(queryAllElements(rootNode));
+}
+
+Vector<Ref<Element>> SelectorDataList::queryAllElements(ContainerNode& rootNode) const
 {
     Vector<Ref<Element>> result;
     execute<AllElementExtractorSelectorQueryTrait>(rootNode, result);
-    return StaticElementList::create(WTFMove(result));
+    return result;
 }
 
 struct SingleElementExtractorSelectorQueryTrait {
@@ -372,6 +391,42 @@ ALWAYS_INLINE void SelectorDataList::executeSingleClassNameSelectorData(const Co
     }
 }
 
+template <typename SelectorQueryTrait>
+ALWAYS_INLINE void SelectorDataList::executeTagAndClassNamesSelectorData(const ContainerNode& rootNode, const SelectorData& selectorData, typename SelectorQueryTrait::OutputType& output) const
+{
+    ASSERT(m_selectors.size() == 1);
+    ASSERT(isTagAndClassNamesCompound(*selectorData.selector));
+
+    const CSSSelector* tagSelector = nullptr;
+    Vector<const AtomicString*, 4> classNames;
+    for (const CSSSelector* selector = selectorData.selector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::Class)
+            classNames.append(&selector->value());
+        else if (selector->tagQName().localName() != starAtom)
+            tagSelector = selector;
+    }
+
+    for (auto& element : elementDescendants(const_cast<ContainerNode&>(rootNode))) {
+        if (!element.hasClass())
+            continue;
+        if (tagSelector && !localNameMatches(element, tagSelector->tagQName().localName(), tagSelector->tagLowercaseLocalName()))
+            continue;
+        auto& elementClassNames = element.classNames();
+        bool hasAllClassNames = true;
+        for (auto* className : classNames) {
+            if (!elementClassNames.contains(*className)) {
+                hasAllClassNames = false;
+                break;
+            }
+        }
+        if (!hasAllClassNames)
+            continue;
+        SelectorQueryTrait::appendOutputForElement(output, &element);
+        if (SelectorQueryTrait::shouldOnlyMatchFirstElement)
+            return;
+    }
+}
+
 template <typename SelectorQueryTrait>
 ALWAYS_INLINE void SelectorDataList::executeSingleSelectorData(const ContainerNode& rootNode, const ContainerNode& searchRootNode, const SelectorData& selectorData, typename SelectorQueryTrait::OutputType& output) const
 {
@@ -578,6 +633,9 @@ ALWAYS_INLINE void SelectorDataList::execute(ContainerNode& rootNode, typename S
     case ClassNameMatch:
         executeSingleClassNameSelectorData<SelectorQueryTrait>(*searchRootNode, m_selectors.first(), output);
         break;
+    case TagAndClassNamesMatch:
+        executeTagAndClassNamesSelectorData<SelectorQueryTrait>(*searchRootNode, m_selectors.first(), output);
+        break;
     case CompilableMultipleSelectorMatch:
 #if ENABLE(CSS_SELECTOR_JIT)
         {
@@ -610,9 +668,70 @@ ALWAYS_INLINE void SelectorDataList::execute(ContainerNode& rootNode, typename S
     }
 }
 
+static bool selectorOnlyDependsOnDOMTree(const CSSSelector& firstSelector)
+{
+    for (const CSSSelector* selector = &firstSelector; selector; selector = selector->tagHistory()) {
+        switch (selector->match()) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            break;
+        case CSSSelector::PseudoClass:
+            switch (selector->pseudoClassType()) {
+            case CSSSelector::PseudoClassEmpty:
+            case CSSSelector::PseudoClassFirstChild:
+            case CSSSelector::PseudoClassFirstOfType:
+            case CSSSelector::PseudoClassLastChild:
+            case CSSSelector::PseudoClassLastOfType:
+            case CSSSelector::PseudoClassOnlyChild:
+            case CSSSelector::PseudoClassOnlyOfType:
+            case CSSSelector::PseudoClassNthChild:
+            case CSSSelector::PseudoClassNthOfType:
+            case CSSSelector::PseudoClassNthLastChild:
+            case CSSSelector::PseudoClassNthLastOfType:
+            case CSSSelector::PseudoClassMatches:
+            case CSSSelector::PseudoClassNot:
+            case CSSSelector::PseudoClassRoot:
+            case CSSSelector::PseudoClassScope:
+                break;
+            default:
+                // Everything else depends on state that can change without a DOM mutation (focus, hover, form state, language...).
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector)) {
+                if (!selectorOnlyDependsOnDOMTree(*subSelector))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool selectorListOnlyDependsOnDOMTree(const CSSSelectorList& selectorList)
+{
+    for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
+        if (!selectorOnlyDependsOnDOMTree(*selector))
+            return false;
+    }
+    return true;
+}
+
 SelectorQuery::SelectorQuery(CSSSelectorList&& selectorList)
     : m_selectorList(WTFMove(selectorList))
     , m_selectors(m_selectorList)
+    , m_canCacheResults(selectorListOnlyDependsOnDOMTree(m_selectorList))
 {
 }
 
@@ -47,6 +47,7 @@ public:
     bool matches(Element&) const;
     Element* closest(Element&) const;
     Ref<NodeList> queryAll(ContainerNode& rootNode) const;
+    Vector<Ref<Element>> queryAllElements(ContainerNode& rootNode) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
 private:
@@ -82,6 +83,7 @@ private:
     template <typename SelectorQueryTrait> void executeFastPathForIdSelector(const ContainerNode& rootNode, const SelectorData&, const CSSSelector* idSelector, typename SelectorQueryTrait::OutputType&) const;
     template <typename SelectorQueryTrait> void executeSingleTagNameSelectorData(const ContainerNode& rootNode, const SelectorData&, typename SelectorQueryTrait::OutputType&) const;
     template <typename SelectorQueryTrait> void executeSingleClassNameSelectorData(const ContainerNode& rootNode, const SelectorData&, typename SelectorQueryTrait::OutputType&) const;
+    template <typename SelectorQueryTrait> void executeTagAndClassNamesSelectorData(const ContainerNode& rootNode, const SelectorData&, typename SelectorQueryTrait::OutputType&) const;
     template <typename SelectorQueryTrait> void executeSingleSelectorData(const ContainerNode& rootNode, const ContainerNode& searchRootNode, const SelectorData&, typename SelectorQueryTrait::OutputType&) const;
     template <typename SelectorQueryTrait> void executeSingleMultiSelectorData(const ContainerNode& rootNode, typename SelectorQueryTrait::OutputType&) const;
 #if ENABLE(CSS_SELECTOR_JIT)
@@ -104,6 +106,7 @@ private:
         RightMostWithIdMatch,
         TagNameMatch,
         ClassNameMatch,
+        TagAndClassNamesMatch,
         MultipleSelectorMatch,
     } m_matchType;
 };
@@ -117,11 +120,17 @@ public:
     bool matches(Element&) const;
     Element* closest(Element&) const;
     Ref<NodeList> queryAll(ContainerNode& rootNode) const;
+    Vector<Ref<Element>> queryAllElements(ContainerNode& rootNode) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
+    // True if the result only depends on the elements, attributes and text of the tree,
+    // so it stays valid as long as the document's DOM tree version does not change.
+    bool canCacheResults() const { return m_canCacheResults; }
+
 private:
     CSSSelectorList m_selectorList;
     SelectorDataList m_selectors;
+    bool m_canCacheResults;
 };
 
 class SelectorQueryCache {
@@ -147,6 +156,11 @@ inline Ref<NodeList> SelectorQuery::queryAll(ContainerNode& rootNode) const
     return m_selectors.queryAll(rootNode);
 }
 
+inline Vector<Ref<Element>> SelectorQuery::queryAllElements(ContainerNode& rootNode) const
+{
+    return m_selectors.queryAllElements(rootNode);
+}
+
 inline Element* SelectorQuery::queryFirst(ContainerNode& rootNode) const
 {
     return m_selectors.queryFirst(rootNode);
@@ -151,6 +151,8 @@ void StyledElement::invalidateStyleAttribute()
         document().setHasElementUsingStyleBasedEditability();
 
     elementData()->setStyleAttributeIsDirty(true);
+    // The style attribute is synchronized lazily, so this is the only point where it visibly changes.
+    document().invalidateQuerySelectorAllResults();
     invalidateStyle();
 }
 
@@ -26,6 +26,7 @@
 #include "HTMLLinkElement.h"
 
 #include "Attribute.h"
+#include "CSSTokenizer.h"
 #include "CachedCSSStyleSheet.h"
 #include "CachedResource.h"
 #include "CachedResourceLoader.h"
@@ -241,6 +242,7 @@ void HTMLLinkElement::process()
             removePendingSheet();
             m_cachedSheet->removeClient(*this);
             m_cachedSheet = nullptr;
+            m_styleSheetBeingTokenized = nullptr;
         }
 
         if (!shouldLoadLink())
@@ -322,6 +324,7 @@ void HTMLLinkElement::removedFrom(ContainerNode& insertionPoint)
         return;
 
     m_linkLoader.cancelLoad();
+    m_styleSheetBeingTokenized = nullptr;
 
     if (m_sheet)
         clearSheet();
@@ -382,16 +385,51 @@ void HTMLLinkElement::setCSSStyleSheet(const String& href, const URL& baseURL, c
     }
 
     auto styleSheet = StyleSheetContents::create(href, parserContext);
+
+    String sheetText;
+    bool hasSheetText = styleSheet.get().authorStyleSheetText(cachedStyleSheet, &document().securityOrigin(), &document(), sheetText);
+
+    // Tokenizing big sheets off the main thread is worth the round trip; the sheet stays pending until it is parsed.
+    static const unsigned minimumLengthForBackgroundTokenization = 32 * 1024;
+    if (hasSheetText && document().settings().backgroundCSSTokenizationEnabled() && sheetText.length() >= minimumLengthForBackgroundTokenization) {
+        tokenizeStyleSheetInBackground(WTFMove(styleSheet), *cachedStyleSheet, sheetText);
+        return;
+    }
+
     initializeStyleSheet(styleSheet.copyRef(), *cachedStyleSheet);
+    if (hasSheetText)
+        styleSheet.get().parseAuthorStyleSheetText(sheetText);
 
-    styleSheet.get().parseAuthorStyleSheet(cachedStyleSheet, &document().securityOrigin());
+    didParseStyleSheet(WTFMove(styleSheet), *cachedStyleSheet);
+}
 
+void HTMLLinkElement::tokenizeStyleSheetInBackground(Ref<StyleSheetContents>&& styleSheet, const CachedCSSStyleSheet& cachedStyleSheet, const String& sheetText)
+{
+    m_styleSheetBeingTokenized = styleSheet.copyRef();
+
+    CachedResourceHandle<CachedCSSStyleSheet> protectedCachedStyleSheet(const_cast<CachedCSSStyleSheet*>(&cachedStyleSheet));
+    CSSTokenizer::tokenizeInBackground(sheetText, [protectedThis = makeRef(*this), styleSheet = WTFMove(styleSheet), cachedStyleSheet = WTFMove(protectedCachedStyleSheet)](String&& sheetText, std::unique_ptr<CSSTokenizer>&& tokenizer) mutable {
+        // The element may have been removed, or started loading another sheet, in the meantime.
+        if (protectedThis->m_styleSheetBeingTokenized != styleSheet.ptr())
+            return;
+        protectedThis->m_styleSheetBeingTokenized = nullptr;
+
+        // The CSSOM sheet is only created now, so script never sees, or modifies, a sheet that is still being parsed.
+        // Parsing doesn't run script, and the contents need their owner node to load @import rules.
+        protectedThis->initializeStyleSheet(styleSheet.copyRef(), *cachedStyleSheet);
+        styleSheet->parseAuthorStyleSheetText(sheetText, WTFMove(tokenizer));
+        protectedThis->didParseStyleSheet(WTFMove(styleSheet), *cachedStyleSheet);
+    });
+}
+
+void HTMLLinkElement::didParseStyleSheet(Ref<StyleSheetContents>&& styleSheet, const CachedCSSStyleSheet& cachedStyleSheet)
+{
     m_loading = false;
-    styleSheet.get().notifyLoadedSheet(cachedStyleSheet);
+    styleSheet.get().notifyLoadedSheet(&cachedStyleSheet);
     styleSheet.get().checkLoaded();
 
     if (styleSheet.get().isCacheable())
-        const_cast<CachedCSSStyleSheet*>(cachedStyleSheet)->saveParsedStyleSheet(WTFMove(styleSheet));
+        const_cast<CachedCSSStyleSheet&>(cachedStyleSheet).saveParsedStyleSheet(WTFMove(styleSheet));
 }
 
 bool HTMLLinkElement::styleSheetIsLoading() const
@@ -83,6 +83,8 @@ private:
     void removedFrom(ContainerNode&) final;
 
     void initializeStyleSheet(Ref<StyleSheetContents>&&, const CachedCSSStyleSheet&);
+    void tokenizeStyleSheetInBackground(Ref<StyleSheetContents>&&, const CachedCSSStyleSheet&, const String& sheetText);
+    void didParseStyleSheet(Ref<StyleSheetContents>&&, const CachedCSSStyleSheet&);
 
     // from CachedResourceClient
     void setCSSStyleSheet(const String& href, const URL& baseURL, const String& charset, const CachedCSSStyleSheet*) final;
@@ -117,6 +119,7 @@ private:
     Style::Scope* m_styleScope { nullptr };
     CachedResourceHandle<CachedCSSStyleSheet> m_cachedSheet;
     RefPtr<CSSStyleSheet> m_sheet;
+    RefPtr<StyleSheetContents> m_styleSheetBeingTokenized;
     enum DisabledState {
         Unset,
         EnabledViaScript,
@@ -83,6 +83,7 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
     ASSERT(!m_insertionPreloadScanner);
+    ASSERT(!m_backgroundPreloadScanner);
 }
 
 void HTMLDocumentParser::detach()
@@ -95,6 +96,10 @@ void HTMLDocumentParser::detach()
     // Yet during fast/dom/HTMLScriptElement/script-load-events.html we do.
     m_preloadScanner = nullptr;
     m_insertionPreloadScanner = nullptr;
+    if (m_backgroundPreloadScanner) {
+        m_backgroundPreloadScanner->detach();
+        m_backgroundPreloadScanner = nullptr;
+    }
     m_parserScheduler = nullptr; // Deleting the scheduler will clear any timers.
 }
 
@@ -289,6 +294,9 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
 
     if (isWaitingForScripts()) {
         ASSERT(m_tokenizer.isInDataState());
+        // The background scanner is already looking at all of the input we have been given.
+        if (m_backgroundPreloadScanner)
+            return;
         if (!m_preloadScanner) {
             m_preloadScanner = std::make_unique<HTMLPreloadScanner>(m_options, document()->url(), document()->deviceScaleFactor());
             m_preloadScanner->appendToEnd(m_input.current());
@@ -365,7 +373,12 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
 
     String source { WTFMove(inputSource) };
 
-    if (m_preloadScanner) {
+    if (m_options.backgroundPreloadScanningEnabled && !m_backgroundPreloadScanner && !isParsingFragment())
+        m_backgroundPreloadScanner = BackgroundHTMLPreloadScanner::create(m_options, document()->url(), document()->deviceScaleFactor(), *m_preloader, *document());
+
+    if (m_backgroundPreloadScanner)
+        m_backgroundPreloadScanner->appendToEnd(source);
+    else if (m_preloadScanner) {
         if (m_input.current().isEmpty() && !isWaitingForScripts()) {
             // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
             // Clear the scanner so we know to scan starting from the current input point if we block again.
@@ -37,6 +37,7 @@
 
 namespace WebCore {
 
+class BackgroundHTMLPreloadScanner;
 class DocumentFragment;
 class Element;
 class HTMLDocument;
@@ -129,6 +130,8 @@ private:
     std::unique_ptr<HTMLTreeBuilder> m_treeBuilder;
     std::unique_ptr<HTMLPreloadScanner> m_preloadScanner;
     std::unique_ptr<HTMLPreloadScanner> m_insertionPreloadScanner;
+    // Replaces m_preloadScanner for network input when enabled. It does not tokenize for m_treeBuilder.
+    RefPtr<BackgroundHTMLPreloadScanner> m_backgroundPreloadScanner;
     std::unique_ptr<HTMLParserScheduler> m_parserScheduler;
     HTMLSourceTracker m_sourceTracker;
     TextPosition m_textPosition;
@@ -39,6 +39,7 @@ HTMLParserOptions::HTMLParserOptions()
     : scriptEnabled(false)
     , pluginsEnabled(false)
     , usePreHTML5ParserQuirks(false)
+    , backgroundPreloadScanningEnabled(false)
     , maximumDOMTreeDepth(Settings::defaultMaximumHTMLParserDOMTreeDepth)
 {
 }
@@ -50,6 +51,7 @@ HTMLParserOptions::HTMLParserOptions(Document& document)
     pluginsEnabled = frame && frame->loader().subframeLoader().allowPlugins();
 
     usePreHTML5ParserQuirks = document.settings().usePreHTML5ParserQuirks();
+    backgroundPreloadScanningEnabled = document.settings().backgroundHTMLPreloadScanningEnabled();
     maximumDOMTreeDepth = document.settings().maximumHTMLParserDOMTreeDepth();
 }
 
@@ -37,6 +37,7 @@ public:
     bool scriptEnabled;
     bool pluginsEnabled;
     bool usePreHTML5ParserQuirks;
+    bool backgroundPreloadScanningEnabled;
     unsigned maximumDOMTreeDepth;
 };
 
@@ -39,6 +39,8 @@
 #include "RenderView.h"
 #include "SizesAttributeParser.h"
 #include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
 
 namespace WebCore {
 
@@ -441,6 +443,111 @@ void HTMLPreloadScanner::scan(HTMLResourcePreloader& preloader, Document& docume
     preloader.preload(WTFMove(requests));
 }
 
+static WorkQueue& backgroundPreloadScanningQueue()
+{
+    static NeverDestroyed<Ref<WorkQueue>> queue(WorkQueue::create("com.apple.WebCore.HTMLPreloadScanner"));
+    return queue.get();
+}
+
+static bool tagNameIs(const HTMLToken::DataVector& name, const QualifiedName& tag)
+{
+    return equal(tag.localName().impl(), name.data(), name.size());
+}
+
+// The tags TokenPreloadScanner::tagIdFor() knows about, matched without AtomicStrings.
+static bool isTagScannedForPreloads(const HTMLToken::DataVector& name)
+{
+    return tagNameIs(name, imgTag)
+        || tagNameIs(name, inputTag)
+        || tagNameIs(name, linkTag)
+        || tagNameIs(name, scriptTag)
+        || tagNameIs(name, styleTag)
+        || tagNameIs(name, baseTag)
+        || tagNameIs(name, templateTag)
+        || tagNameIs(name, metaTag)
+        || tagNameIs(name, pictureTag)
+        || tagNameIs(name, sourceTag);
+}
+
+BackgroundHTMLPreloadScanner::BackgroundHTMLPreloadScanner(const HTMLParserOptions& options, const URL& documentURL, float deviceScaleFactor, HTMLResourcePreloader& preloader, Document& document)
+    : m_tokenizer(options)
+    , m_scanner(documentURL, deviceScaleFactor)
+    , m_preloader(&preloader)
+    , m_document(&document)
+{
+}
+
+void BackgroundHTMLPreloadScanner::appendToEnd(const String& source)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_document);
+
+    backgroundPreloadScanningQueue().dispatch([protectedThis = makeRef(*this), source = source.isolatedCopy()]() mutable {
+        auto tokens = protectedThis->tokenize(source);
+        // Always go back to the main thread, so that is where the last reference is dropped.
+        callOnMainThread([protectedThis = WTFMove(protectedThis), tokens = WTFMove(tokens)]() mutable {
+            protectedThis->scan(WTFMove(tokens));
+        });
+    });
+}
+
+void BackgroundHTMLPreloadScanner::detach()
+{
+    ASSERT(isMainThread());
+    m_preloader = nullptr;
+    m_document = nullptr;
+}
+
+Vector<HTMLToken> BackgroundHTMLPreloadScanner::tokenize(const String& source)
+{
+    ASSERT(!isMainThread());
+
+    m_source.append(source);
+
+    Vector<HTMLToken> tokens;
+    while (auto token = m_tokenizer.nextToken(m_source)) {
+        switch (token->type()) {
+        case HTMLToken::StartTag:
+            m_tokenizer.updateStateFor(token->name());
+            if (tagNameIs(token->name(), styleTag))
+                m_inStyle = true;
+            if (isTagScannedForPreloads(token->name()))
+                tokens.append(WTFMove(*token));
+            break;
+        case HTMLToken::EndTag:
+            if (tagNameIs(token->name(), styleTag))
+                m_inStyle = false;
+            if (isTagScannedForPreloads(token->name()))
+                tokens.append(WTFMove(*token));
+            break;
+        case HTMLToken::Character:
+            if (m_inStyle)
+                tokens.append(WTFMove(*token));
+            break;
+        default:
+            break;
+        }
+    }
+    return tokens;
+}
+
+void BackgroundHTMLPreloadScanner::scan(Vector<HTMLToken>&& tokens)
+{
+    ASSERT(isMainThread());
+    if (!m_document || tokens.isEmpty())
+        return;
+
+    const URL& baseElementURL = m_document->baseElementURL();
+    if (!baseElementURL.isEmpty())
+        m_scanner.setPredictedBaseElementURL(baseElementURL);
+
+    PreloadRequestStream requests;
+    for (auto& token : tokens)
+        m_scanner.scan(token, requests, *m_document);
+
+    m_preloader->preload(WTFMove(requests));
+}
+
 bool testPreloadScannerViewportSupport(Document* document)
 {
     ASSERT(document);
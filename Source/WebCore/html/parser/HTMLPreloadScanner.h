@@ -29,6 +29,7 @@
 #include "CSSPreloadScanner.h"
 #include "HTMLTokenizer.h"
 #include "SegmentedString.h"
+#include <wtf/ThreadSafeRefCounted.h>
 
 namespace WebCore {
 
@@ -95,6 +96,45 @@ private:
     HTMLTokenizer m_tokenizer;
 };
 
+// Tokenizes network input on a background thread, ahead of the parser, so that looking for
+// resources to preload does not take time away from parsing, script and layout on the main
+// thread. Only the tokens TokenPreloadScanner looks at are handed back, and those are scanned
+// on the main thread since that needs the Document.
+//
+// This is a preload scanner only. HTMLDocumentParser still decodes and tokenizes its input
+// on the main thread; these tokens are never given to the tree builder, because the tree
+// builder changes the tokenizer's state and document.write() can change the input under it.
+// Network input is therefore tokenized twice, once here and once by the parser, as it is
+// with the main-thread lookahead scanner this replaces.
+class BackgroundHTMLPreloadScanner : public ThreadSafeRefCounted<BackgroundHTMLPreloadScanner> {
+public:
+    static Ref<BackgroundHTMLPreloadScanner> create(const HTMLParserOptions& options, const URL& documentURL, float deviceScaleFactor, HTMLResourcePreloader& preloader, Document& document)
+    {
+        return adoptRef(*new BackgroundHTMLPreloadScanner(options, documentURL, deviceScaleFactor, preloader, document));
+    }
+
+    void appendToEnd(const String&);
+
+    // Tokens that are still on their way back from the background thread will be dropped.
+    void detach();
+
+private:
+    BackgroundHTMLPreloadScanner(const HTMLParserOptions&, const URL& documentURL, float deviceScaleFactor, HTMLResourcePreloader&, Document&);
+
+    Vector<HTMLToken> tokenize(const String&);
+    void scan(Vector<HTMLToken>&&);
+
+    // Only used on the background thread.
+    HTMLTokenizer m_tokenizer;
+    SegmentedString m_source;
+    bool m_inStyle { false };
+
+    // Only used on the main thread.
+    TokenPreloadScanner m_scanner;
+    HTMLResourcePreloader* m_preloader;
+    Document* m_document;
+};
+
 WEBCORE_EXPORT bool testPreloadScannerViewportSupport(Document*);
 
 } // namespace WebCore
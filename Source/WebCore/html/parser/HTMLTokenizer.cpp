@@ -220,6 +220,11 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
         }
         if (character == kEndOfFileMarker)
             return emitEndOfFile(source);
+        const LChar* characters;
+        if (unsigned length = source.advancePastCharactersExcept('<', '&', characters)) {
+            m_token.appendToCharacter(characters, length);
+            SWITCH_TO(DataState);
+        }
         bufferCharacter(character);
         ADVANCE_TO(DataState);
     END_STATE()
@@ -807,6 +812,11 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
             m_token.endAttribute(source.numberOfCharactersConsumed());
             RECONSUME_IN(DataState);
         }
+        const LChar* characters;
+        if (unsigned length = source.advancePastCharactersExcept('"', '&', characters)) {
+            m_token.appendToAttributeValue(characters, length);
+            SWITCH_TO(AttributeValueDoubleQuotedState);
+        }
         m_token.appendToAttributeValue(character);
         ADVANCE_TO(AttributeValueDoubleQuotedState);
     END_STATE()
@@ -825,6 +835,11 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
             m_token.endAttribute(source.numberOfCharactersConsumed());
             RECONSUME_IN(DataState);
         }
+        const LChar* characters;
+        if (unsigned length = source.advancePastCharactersExcept('\'', '&', characters)) {
+            m_token.appendToAttributeValue(characters, length);
+            SWITCH_TO(AttributeValueSingleQuotedState);
+        }
         m_token.appendToAttributeValue(character);
         ADVANCE_TO(AttributeValueSingleQuotedState);
     END_STATE()
@@ -1406,23 +1421,38 @@ String HTMLTokenizer::bufferedCharacters() const
     return characters.toString();
 }
 
-void HTMLTokenizer::updateStateFor(const AtomicString& tagName)
+template<typename TagNameMatcher>
+inline void HTMLTokenizer::updateStateForTagName(const TagNameMatcher& is)
 {
-    if (tagName == textareaTag || tagName == titleTag)
+    if (is(textareaTag) || is(titleTag))
         m_state = RCDATAState;
-    else if (tagName == plaintextTag)
+    else if (is(plaintextTag))
         m_state = PLAINTEXTState;
-    else if (tagName == scriptTag)
+    else if (is(scriptTag))
         m_state = ScriptDataState;
-    else if (tagName == styleTag
-        || tagName == iframeTag
-        || tagName == xmpTag
-        || (tagName == noembedTag && m_options.pluginsEnabled)
-        || tagName == noframesTag
-        || (tagName == noscriptTag && m_options.scriptEnabled))
+    else if (is(styleTag)
+        || is(iframeTag)
+        || is(xmpTag)
+        || (is(noembedTag) && m_options.pluginsEnabled)
+        || is(noframesTag)
+        || (is(noscriptTag) && m_options.scriptEnabled))
         m_state = RAWTEXTState;
 }
 
+void HTMLTokenizer::updateStateFor(const AtomicString& tagName)
+{
+    updateStateForTagName([&tagName](const QualifiedName& tag) {
+        return tagName == tag.localName();
+    });
+}
+
+void HTMLTokenizer::updateStateFor(const HTMLToken::DataVector& tagName)
+{
+    updateStateForTagName([&tagName](const QualifiedName& tag) {
+        return equal(tag.localName().impl(), tagName.data(), tagName.size());
+    });
+}
+
 inline void HTMLTokenizer::appendToTemporaryBuffer(UChar character)
 {
     ASSERT(isASCII(character));
@@ -64,6 +64,9 @@ public:
     // https://html.spec.whatwg.org/multipage/syntax.html#parsing-html-fragments
     void updateStateFor(const AtomicString& tagName);
 
+    // Same as above, but compares characters instead of AtomicStrings so that it can be used off the main thread.
+    void updateStateFor(const HTMLToken::DataVector& tagName);
+
     void setForceNullCharacterReplacement(bool);
 
     bool shouldAllowCDATA() const;
@@ -184,6 +187,8 @@ private:
 
     bool haveBufferedCharacterToken() const;
 
+    template<typename TagNameMatcher> void updateStateForTagName(const TagNameMatcher&);
+
     static bool isNullCharacterSkippingState(State);
 
     State m_state { DataState };
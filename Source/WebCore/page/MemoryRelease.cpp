@@ -30,6 +30,7 @@
 #include "Chrome.h"
 #include "ChromeClient.h"
 #include "CommonVM.h"
+#include "CompiledSelectorCache.h"
 #include "Document.h"
 #include "FontCache.h"
 #include "GCController.h"
@@ -43,6 +44,7 @@
 #include "PageCache.h"
 #include "RenderTheme.h"
 #include "ScrollingThread.h"
+#include "ShadowBlur.h"
 #include "StyleScope.h"
 #include "StyledElement.h"
 #include "WorkerThread.h"
@@ -65,9 +67,15 @@ static void releaseNoncriticalMemory()
     for (auto* document : Document::allDocuments())
         document->clearSelectorQueryCache();
 
+#if ENABLE(CSS_SELECTOR_JIT)
+    CompiledSelectorCache::singleton().clear();
+#endif
+
     MemoryCache::singleton().pruneDeadResourcesToSize(0);
 
     InlineStyleSheetOwner::clearCache();
+
+    ShadowBlur::clearTemplateCache();
 }
 
 static void releaseCriticalMemory(Synchronous synchronous)
@@ -343,6 +343,12 @@ GraphicsContext::~GraphicsContext()
     platformDestroy();
 }
 
+void GraphicsContext::didSkipUnrecordableDrawing()
+{
+    if (isRecording())
+        m_displayListRecorder->didSkipUnrecordableDrawing();
+}
+
 void GraphicsContext::save()
 {
     if (paintingDisabled())
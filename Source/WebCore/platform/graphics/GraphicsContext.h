@@ -262,6 +262,8 @@ public:
 
     void setDisplayListRecorder(DisplayList::Recorder* recorder) { m_displayListRecorder = recorder; }
     bool isRecording() const { return m_displayListRecorder; }
+    // Called by code that can only paint into a platform context when it skips painting while recording.
+    void didSkipUnrecordableDrawing();
 
     void setStrokeThickness(float);
     float strokeThickness() const { return m_state.strokeThickness; }
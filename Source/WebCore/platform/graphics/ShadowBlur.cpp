@@ -160,6 +160,102 @@ ScratchBuffer& ScratchBuffer::singleton()
     return scratchBuffer;
 }
 
+// The templates used by the tiled rect and inset shadows don't depend on where the shadow is drawn,
+// so we keep the most recently used ones around and share them between all the shadows that have
+// the same parameters, instead of blurring the scratch buffer again each time.
+class ShadowTemplateCache {
+    WTF_MAKE_NONCOPYABLE(ShadowTemplateCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Key {
+        bool operator==(const Key& other) const
+        {
+            return isInset == other.isInset && radius == other.radius && color == other.color && templateSize == other.templateSize
+                && shadowRect == other.shadowRect && radii == other.radii;
+        }
+
+        bool isInset;
+        FloatSize radius;
+        Color color;
+        IntSize templateSize;
+        FloatRect shadowRect;
+        FloatRoundedRect::Radii radii;
+    };
+
+    ShadowTemplateCache() = default;
+
+    static ShadowTemplateCache& singleton();
+
+    // Templates that are too big to cache are drawn in the scratch buffer instead.
+    static bool canCache(const IntSize& templateSize) { return templateCost(templateSize) <= maximumTemplateCost; }
+
+    ImageBuffer* find(const Key& key)
+    {
+        // The most recently used entry is the last one.
+        for (size_t i = m_entries.size(); i--;) {
+            if (!(m_entries[i].key == key))
+                continue;
+            if (i != m_entries.size() - 1) {
+                Entry entry = WTFMove(m_entries[i]);
+                m_entries.remove(i);
+                m_entries.append(WTFMove(entry));
+            }
+            return m_entries.last().image.get();
+        }
+        return nullptr;
+    }
+
+    void add(const Key& key, std::unique_ptr<ImageBuffer> image)
+    {
+        if (!canCache(key.templateSize))
+            return;
+        size_t cost = templateCost(key.templateSize);
+
+        m_entries.append(Entry { key, WTFMove(image) });
+        m_totalCost += cost;
+
+        while (m_totalCost > totalCostLimit || m_entries.size() > maximumEntryCount) {
+            m_totalCost -= templateCost(m_entries.first().key.templateSize);
+            m_entries.remove(0);
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_totalCost = 0;
+    }
+
+private:
+    static const size_t totalCostLimit = 4 * 1024 * 1024;
+    static const size_t maximumTemplateCost = totalCostLimit / 8;
+    static const size_t maximumEntryCount = 128;
+
+    struct Entry {
+        Key key;
+        std::unique_ptr<ImageBuffer> image;
+    };
+
+    static size_t templateCost(const IntSize& templateSize)
+    {
+        return templateSize.area().unsafeGet() * 4;
+    }
+
+    Vector<Entry> m_entries;
+    size_t m_totalCost { 0 };
+};
+
+ShadowTemplateCache& ShadowTemplateCache::singleton()
+{
+    static NeverDestroyed<ShadowTemplateCache> cache;
+    return cache;
+}
+
+void ShadowBlur::clearTemplateCache()
+{
+    ShadowTemplateCache::singleton().clear();
+}
+
 static const int templateSideLength = 1;
 
 #if USE(CG)
@@ -667,17 +763,33 @@ void ShadowBlur::drawInsetShadowWithoutTiling(GraphicsContext& graphicsContext,
 
 void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext& graphicsContext, const FloatRect& rect, const FloatRoundedRect& holeRect, const IntSize& templateSize, const IntSize& edgeSize)
 {
-    m_layerImage = ScratchBuffer::singleton().getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
-
     // Draw the rectangle with hole.
     FloatRect templateBounds(0, 0, templateSize.width(), templateSize.height());
     FloatRect templateHole = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
 
-    // Only redraw in the scratch buffer if its cached contents don't match our needs
-    bool redrawNeeded = ScratchBuffer::singleton().setCachedInsetShadowValues(m_blurRadius, m_color, templateBounds, templateHole, holeRect.radii());
+    // Only draw a new template if there is no cached one that matches our needs.
+    bool usesScratchBuffer = !ShadowTemplateCache::canCache(templateSize);
+    ShadowTemplateCache::Key templateKey { true, m_blurRadius, m_color, templateSize, templateHole, holeRect.radii() };
+    std::unique_ptr<ImageBuffer> newTemplate;
+    bool redrawNeeded;
+    if (usesScratchBuffer) {
+        m_layerImage = ScratchBuffer::singleton().getScratchBuffer(templateSize);
+        if (!m_layerImage)
+            return;
+        redrawNeeded = ScratchBuffer::singleton().setCachedInsetShadowValues(m_blurRadius, m_color, templateBounds, templateHole, holeRect.radii());
+    } else {
+        m_layerImage = ShadowTemplateCache::singleton().find(templateKey);
+        redrawNeeded = !m_layerImage;
+    }
     if (redrawNeeded) {
+        if (!m_layerImage) {
+            // ShadowBlur is not used with accelerated drawing, so it's OK to make an unconditionally unaccelerated buffer.
+            newTemplate = ImageBuffer::create(templateSize, Unaccelerated, 1);
+            if (!newTemplate)
+                return;
+            m_layerImage = newTemplate.get();
+        }
+
         // Draw shadow into a new ImageBuffer.
         GraphicsContext& shadowContext = m_layerImage->context();
         GraphicsContextStateSaver shadowStateSaver(shadowContext);
@@ -727,21 +839,40 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext& graphicsContext, con
     drawLayerPieces(graphicsContext, destHoleBounds, holeRect.radii(), edgeSize, templateSize, InnerShadow);
 
     m_layerImage = nullptr;
-    ScratchBuffer::singleton().scheduleScratchBufferPurge();
+    if (usesScratchBuffer)
+        ScratchBuffer::singleton().scheduleScratchBufferPurge();
+    else if (newTemplate)
+        ShadowTemplateCache::singleton().add(templateKey, WTFMove(newTemplate));
 }
 
 void ShadowBlur::drawRectShadowWithTiling(GraphicsContext& graphicsContext, const FloatRoundedRect& shadowedRect, const IntSize& templateSize, const IntSize& edgeSize)
 {
-    auto& scratchBuffer = ScratchBuffer::singleton();
-    m_layerImage = scratchBuffer.getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
-
     FloatRect templateShadow = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
 
-    // Only redraw in the scratch buffer if its cached contents don't match our needs
-    bool redrawNeeded = scratchBuffer.setCachedShadowValues(m_blurRadius, m_color, templateShadow, shadowedRect.radii(), m_layerSize);
+    // Only draw a new template if there is no cached one that matches our needs.
+    bool usesScratchBuffer = !ShadowTemplateCache::canCache(templateSize);
+    ShadowTemplateCache::Key templateKey { false, m_blurRadius, m_color, templateSize, templateShadow, shadowedRect.radii() };
+    std::unique_ptr<ImageBuffer> newTemplate;
+    bool redrawNeeded;
+    if (usesScratchBuffer) {
+        auto& scratchBuffer = ScratchBuffer::singleton();
+        m_layerImage = scratchBuffer.getScratchBuffer(templateSize);
+        if (!m_layerImage)
+            return;
+        redrawNeeded = scratchBuffer.setCachedShadowValues(m_blurRadius, m_color, templateShadow, shadowedRect.radii(), m_layerSize);
+    } else {
+        m_layerImage = ShadowTemplateCache::singleton().find(templateKey);
+        redrawNeeded = !m_layerImage;
+    }
     if (redrawNeeded) {
+        if (!m_layerImage) {
+            // ShadowBlur is not used with accelerated drawing, so it's OK to make an unconditionally unaccelerated buffer.
+            newTemplate = ImageBuffer::create(templateSize, Unaccelerated, 1);
+            if (!newTemplate)
+                return;
+            m_layerImage = newTemplate.get();
+        }
+
         // Draw shadow into the ImageBuffer.
         GraphicsContext& shadowContext = m_layerImage->context();
         GraphicsContextStateSaver shadowStateSaver(shadowContext);
@@ -773,7 +904,10 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext& graphicsContext, cons
     drawLayerPieces(graphicsContext, shadowBounds, shadowedRect.radii(), edgeSize, templateSize, OuterShadow);
 
     m_layerImage = nullptr;
-    ScratchBuffer::singleton().scheduleScratchBufferPurge();
+    if (usesScratchBuffer)
+        ScratchBuffer::singleton().scheduleScratchBufferPurge();
+    else if (newTemplate)
+        ShadowTemplateCache::singleton().add(templateKey, WTFMove(newTemplate));
 }
 
 void ShadowBlur::drawLayerPieces(GraphicsContext& graphicsContext, const FloatRect& shadowBounds, const FloatRoundedRect::Radii& radii, const IntSize& bufferPadding, const IntSize& templateSize, ShadowDirection direction)
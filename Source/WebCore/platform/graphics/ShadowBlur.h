@@ -71,6 +71,8 @@ public:
 
     ShadowType type() const { return m_type; }
 
+    static void clearTemplateCache();
+
 private:
     void updateShadowBlurValues();
 
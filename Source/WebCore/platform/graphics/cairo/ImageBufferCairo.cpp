@@ -38,6 +38,7 @@
 #include "MIMETypeRegistry.h"
 #include "NotImplemented.h"
 #include "Pattern.h"
+#include "PixelConversionSSE2.h"
 #include "PlatformContextCairo.h"
 #include "RefPtrCairo.h"
 #include <cairo.h>
@@ -383,7 +384,11 @@ RefPtr<Uint8ClampedArray> getImageData(const IntRect& rect, const IntRect& logic
     unsigned char* destRows = dataDst + desty * destBytesPerRow + destx * 4;
     for (int y = 0; y < numRows; ++y) {
         unsigned* row = reinterpret_cast_ptr<unsigned*>(dataSrc + stride * (y + originy));
-        for (int x = 0; x < numColumns; x++) {
+        int x = 0;
+#if CPU(X86_SSE2)
+        x = convertARGB32ToRGBA8SSE2<multiplied == Unmultiplied>(row + originx, destRows, numColumns);
+#endif
+        for (; x < numColumns; x++) {
             int basex = x * 4;
             unsigned* pixel = row + x + originx;
 
@@ -503,7 +508,14 @@ void ImageBuffer::putByteArray(Multiply multiplied, Uint8ClampedArray* source, c
     unsigned char* srcRows = source->data() + originy * srcBytesPerRow + originx * 4;
     for (int y = 0; y < numRows; ++y) {
         unsigned* row = reinterpret_cast_ptr<unsigned*>(pixelData + stride * (y + desty));
-        for (int x = 0; x < numColumns; x++) {
+        int x = 0;
+#if CPU(X86_SSE2)
+        if (multiplied == Unmultiplied)
+            x = convertRGBA8ToARGB32SSE2<true>(srcRows, row + destx, numColumns);
+        else
+            x = convertRGBA8ToARGB32SSE2<false>(srcRows, row + destx, numColumns);
+#endif
+        for (; x < numColumns; x++) {
             int basex = x * 4;
             unsigned* pixel = row + x + destx;
 
@@ -49,11 +49,6 @@ short* feLightingConstantsForNeon()
     return s_FELightingConstantsForNeon;
 }
 
-void FELighting::platformApplyNeonWorker(FELightingPaintingDataForNeon* parameters)
-{
-    neonDrawLighting(parameters);
-}
-
 #define ASSTRING(str) #str
 #define TOSTRING(value) ASSTRING(value)
 
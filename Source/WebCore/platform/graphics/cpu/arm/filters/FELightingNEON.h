@@ -30,7 +30,7 @@
 #if CPU(ARM_NEON) && CPU(ARM_TRADITIONAL) && COMPILER(GCC_OR_CLANG)
 
 #include "FELighting.h"
-#include <wtf/ParallelJobs.h>
+#include <wtf/WorkQueue.h>
 
 namespace WebCore {
 
@@ -163,33 +163,15 @@ inline void FELighting::platformApplyNeon(LightingData& data, LightSource::Paint
     if (floatArguments.diffuseConstant == 1)
         neonData.flags |= FLAG_DIFFUSE_CONST_IS_1;
 
-    int optimalThreadNumber = ((data.widthDecreasedByOne - 1) * (data.heightDecreasedByOne - 1)) / s_minimalRectDimension;
-    if (optimalThreadNumber > 1) {
-        // Initialize parallel jobs
-        ParallelJobs<FELightingPaintingDataForNeon> parallelJobs(&WebCore::FELighting::platformApplyNeonWorker, optimalThreadNumber);
-
-        // Fill the parameter array
-        int job = parallelJobs.numberOfJobs();
-        if (job > 1) {
-            int yStart = 1;
-            int yStep = (data.heightDecreasedByOne - 1) / job;
-            for (--job; job >= 0; --job) {
-                FELightingPaintingDataForNeon& params = parallelJobs.parameter(job);
-                params = neonData;
-                params.yStart = yStart;
-                params.pixels += (yStart - 1) * (data.widthDecreasedByOne + 1) * 4;
-                if (job > 0) {
-                    params.absoluteHeight = yStep;
-                    yStart += yStep;
-                } else
-                    params.absoluteHeight = data.heightDecreasedByOne - yStart;
-            }
-            parallelJobs.execute();
-            return;
-        }
-    }
-
-    neonDrawLighting(&neonData);
+    int rowsPerTile = std::max(1, s_minimalRectDimension / neonData.widthDecreasedByTwo);
+    WorkQueue::concurrentApply((neonData.absoluteHeight + rowsPerTile - 1) / rowsPerTile, [&](size_t index) {
+        int yStart = 1 + index * rowsPerTile;
+        FELightingPaintingDataForNeon tileData = neonData;
+        tileData.yStart = yStart;
+        tileData.pixels += (yStart - 1) * (data.widthDecreasedByOne + 1) * 4;
+        tileData.absoluteHeight = std::min(rowsPerTile, data.heightDecreasedByOne - yStart);
+        neonDrawLighting(&tileData);
+    });
 }
 
 } // namespace WebCore
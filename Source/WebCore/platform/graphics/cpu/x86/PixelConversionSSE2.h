@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+namespace WebCore {
+
+// Returns floor(channel * 255 / alpha). The quotient computed with the reciprocal of alpha is off by
+// at most one, and the remainder, which is exact in float, tells in which direction.
+inline __m128i unpremultiplyChannelSSE2(__m128i channel, __m128 alpha, __m128 reciprocal)
+{
+    __m128 one = _mm_set1_ps(1);
+    __m128 value = _mm_cvtepi32_ps(channel);
+    __m128 quotient = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(value, _mm_set1_ps(255)), reciprocal)));
+    __m128 remainder = _mm_sub_ps(_mm_mul_ps(value, _mm_set1_ps(255)), _mm_mul_ps(quotient, alpha));
+    quotient = _mm_sub_ps(quotient, _mm_and_ps(_mm_cmplt_ps(remainder, _mm_setzero_ps()), one));
+    quotient = _mm_add_ps(quotient, _mm_and_ps(_mm_cmpge_ps(remainder, alpha), one));
+    return _mm_cvttps_epi32(quotient);
+}
+
+// Converts the leading multiple of 4 pixels of a row of Cairo ARGB32 pixels to the RGBA8 byte order of
+// ImageData, dividing the color channels by alpha exactly like the scalar loop of getImageData() when
+// unpremultiply is set. Returns the number of pixels converted.
+template<bool unpremultiply>
+inline int convertARGB32ToRGBA8SSE2(const uint32_t* source, unsigned char* destination, int pixelCount)
+{
+    __m128i byteMask = _mm_set1_epi32(0xff);
+
+    int x = 0;
+    for (; x + 4 <= pixelCount; x += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x));
+        __m128i alpha = _mm_srli_epi32(pixels, 24);
+        __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+        __m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+        __m128i blue = _mm_and_si128(pixels, byteMask);
+
+        if (unpremultiply) {
+            // Transparent pixels are left as they are, the lanes computed for them are garbage.
+            __m128i isTransparent = _mm_cmpeq_epi32(alpha, _mm_setzero_si128());
+            __m128 alphaValue = _mm_cvtepi32_ps(alpha);
+            __m128 reciprocal = _mm_div_ps(_mm_set1_ps(1), alphaValue);
+            red = _mm_or_si128(_mm_and_si128(isTransparent, red), _mm_andnot_si128(isTransparent, unpremultiplyChannelSSE2(red, alphaValue, reciprocal)));
+            green = _mm_or_si128(_mm_and_si128(isTransparent, green), _mm_andnot_si128(isTransparent, unpremultiplyChannelSSE2(green, alphaValue, reciprocal)));
+            blue = _mm_or_si128(_mm_and_si128(isTransparent, blue), _mm_andnot_si128(isTransparent, unpremultiplyChannelSSE2(blue, alphaValue, reciprocal)));
+
+            // Like the scalar stores, keep only the low byte of invalid premultiplied colors.
+            red = _mm_and_si128(red, byteMask);
+            green = _mm_and_si128(green, byteMask);
+            blue = _mm_and_si128(blue, byteMask);
+        }
+
+        __m128i result = _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 8)), _mm_or_si128(_mm_slli_epi32(blue, 16), _mm_slli_epi32(alpha, 24)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4), result);
+    }
+    return x;
+}
+
+// pixels holds two RGBA8 pixels widened to 16 bits per channel. Returns them in the BGRA order of
+// little endian ARGB32, multiplying the color channels by alpha when premultiply is set.
+template<bool premultiply>
+inline __m128i convertRGBA16PairToBGRA16SSE2(__m128i pixels)
+{
+    if (premultiply) {
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        // (channel * alpha + 254) / 255, where the division of a value below 65535 by 255 is (value + 1 + (value >> 8)) >> 8.
+        __m128i product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(254));
+        __m128i quotient = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)), _mm_srli_epi16(product, 8)), 8);
+        __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+        pixels = _mm_or_si128(_mm_and_si128(alphaMask, pixels), _mm_andnot_si128(alphaMask, quotient));
+    }
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+// Converts the leading multiple of 4 pixels of a row of RGBA8 ImageData pixels to Cairo ARGB32,
+// premultiplying them exactly like the scalar loop of putByteArray() when premultiply is set.
+// Returns the number of pixels converted.
+template<bool premultiply>
+inline int convertRGBA8ToARGB32SSE2(const unsigned char* source, uint32_t* destination, int pixelCount)
+{
+    __m128i zero = _mm_setzero_si128();
+
+    int x = 0;
+    for (; x + 4 <= pixelCount; x += 4) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+        __m128i low = convertRGBA16PairToBGRA16SSE2<premultiply>(_mm_unpacklo_epi8(pixels, zero));
+        __m128i high = convertRGBA16PairToBGRA16SSE2<premultiply>(_mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x), _mm_packus_epi16(low, high));
+    }
+    return x;
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
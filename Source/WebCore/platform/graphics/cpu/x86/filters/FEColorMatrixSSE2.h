@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include "SSE2Helpers.h"
+
+namespace WebCore {
+
+// Each column holds the coefficients that one input channel contributes to the red, green, blue and
+// alpha outputs, so a pixel is transformed with one multiply-add per input channel. The sums are
+// accumulated in the same order as the scalar matrix() and saturateAndHueRotate().
+struct ColorMatrixColumnsSSE2 {
+    __m128 red;
+    __m128 green;
+    __m128 blue;
+    __m128 alpha;
+    __m128 constant;
+};
+
+// Rounds like Uint8ClampedArray::set(): NaN and negative values become 0, values above 255 become 255
+// and everything else is rounded to the nearest integer, ties to even.
+inline __m128i clampAndRoundToInt32(__m128 value)
+{
+    // _mm_max_ps() returns its second operand when the first one is NaN.
+    return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(255)));
+}
+
+template<bool preservesAlpha>
+inline __m128i transformPixelSSE2(__m128 pixel, const ColorMatrixColumnsSSE2& columns)
+{
+    __m128 result = _mm_mul_ps(_mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(0, 0, 0, 0)), columns.red);
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(1, 1, 1, 1)), columns.green));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(2, 2, 2, 2)), columns.blue));
+    if (preservesAlpha) {
+        __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        result = _mm_or_ps(_mm_and_ps(alphaMask, pixel), _mm_andnot_ps(alphaMask, result));
+    } else {
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3)), columns.alpha));
+        result = _mm_add_ps(result, columns.constant);
+    }
+    return clampAndRoundToInt32(result);
+}
+
+template<bool preservesAlpha>
+inline void transformPixelsSSE2(unsigned char* pixels, unsigned pixelArrayLength, const ColorMatrixColumnsSSE2& columns)
+{
+    unsigned offset = 0;
+    for (; offset + 16 <= pixelArrayLength; offset += 16) {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + offset);
+        __m128 pixel[4];
+        unpackBytesAsFloat(_mm_loadu_si128(block), pixel[0], pixel[1], pixel[2], pixel[3]);
+
+        __m128i result[4];
+        for (unsigned i = 0; i < 4; ++i)
+            result[i] = transformPixelSSE2<preservesAlpha>(pixel[i], columns);
+        _mm_storeu_si128(block, packInt32AsBytes(result[0], result[1], result[2], result[3]));
+    }
+
+    for (; offset < pixelArrayLength; offset += 4) {
+        uint32_t* pixel = reinterpret_cast<uint32_t*>(pixels + offset);
+        storeInt32AsRGBA8(transformPixelSSE2<preservesAlpha>(loadRGBA8AsFloat(pixel), columns), pixel);
+    }
+}
+
+// values is the row-major 4x5 matrix of FECOLORMATRIX_TYPE_MATRIX.
+inline void colorMatrixSSE2(unsigned char* pixels, unsigned pixelArrayLength, const float* values)
+{
+    ColorMatrixColumnsSSE2 columns;
+    columns.red = _mm_setr_ps(values[0], values[5], values[10], values[15]);
+    columns.green = _mm_setr_ps(values[1], values[6], values[11], values[16]);
+    columns.blue = _mm_setr_ps(values[2], values[7], values[12], values[17]);
+    columns.alpha = _mm_setr_ps(values[3], values[8], values[13], values[18]);
+    columns.constant = _mm_setr_ps(values[4] * 255, values[9] * 255, values[14] * 255, values[19] * 255);
+    transformPixelsSSE2<false>(pixels, pixelArrayLength, columns);
+}
+
+// components is the row-major 3x3 matrix computed for FECOLORMATRIX_TYPE_SATURATE and FECOLORMATRIX_TYPE_HUEROTATE.
+inline void saturateAndHueRotateSSE2(unsigned char* pixels, unsigned pixelArrayLength, const float* components)
+{
+    ColorMatrixColumnsSSE2 columns;
+    columns.red = _mm_setr_ps(components[0], components[3], components[6], 0);
+    columns.green = _mm_setr_ps(components[1], components[4], components[7], 0);
+    columns.blue = _mm_setr_ps(components[2], components[5], components[8], 0);
+    columns.alpha = _mm_setzero_ps();
+    columns.constant = _mm_setzero_ps();
+    transformPixelsSSE2<true>(pixels, pixelArrayLength, columns);
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
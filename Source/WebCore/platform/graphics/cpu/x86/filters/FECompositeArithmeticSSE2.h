@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include "SSE2Helpers.h"
+#include <string.h>
+
+namespace WebCore {
+
+template <int b1, int b4>
+inline __m128 computeArithmeticSSE2(__m128 i1, __m128 i2, __m128 k1x4, __m128 k2x4, __m128 k3x4, __m128 k4x4)
+{
+    __m128 result = _mm_add_ps(_mm_mul_ps(k2x4, i1), _mm_mul_ps(k3x4, i2));
+    if (b1)
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(k1x4, i1), i2));
+    if (b4)
+        result = _mm_add_ps(result, k4x4);
+    return result;
+}
+
+// Evaluates the arithmetic operator in the same order as computeArithmeticPixels() and truncates the
+// same way. Out of range values (including the ones that overflow the int conversion) saturate like
+// clampByte() does, so the output is identical to the scalar code.
+template <int b1, int b4>
+inline void computeArithmeticPixelsSSE2(const unsigned char* source, unsigned char* destination, unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    __m128 k1x4 = _mm_set1_ps(k1 / 255.0f);
+    __m128 k2x4 = _mm_set1_ps(k2);
+    __m128 k3x4 = _mm_set1_ps(k3);
+    __m128 k4x4 = _mm_set1_ps(k4 * 255.0f);
+
+    auto computeBlock = [&](const unsigned char* blockSource, unsigned char* blockDestination) {
+        __m128 i1[4];
+        __m128 i2[4];
+        unpackBytesAsFloat(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blockSource)), i1[0], i1[1], i1[2], i1[3]);
+        unpackBytesAsFloat(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blockDestination)), i2[0], i2[1], i2[2], i2[3]);
+
+        __m128i result[4];
+        for (unsigned i = 0; i < 4; ++i)
+            result[i] = _mm_cvttps_epi32(computeArithmeticSSE2<b1, b4>(i1[i], i2[i], k1x4, k2x4, k3x4, k4x4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(blockDestination), packInt32AsBytes(result[0], result[1], result[2], result[3]));
+    };
+
+    unsigned offset = 0;
+    for (; offset + 16 <= pixelArrayLength; offset += 16)
+        computeBlock(source + offset, destination + offset);
+
+    if (unsigned remainingLength = pixelArrayLength - offset) {
+        unsigned char lastSource[16] = { };
+        unsigned char lastDestination[16] = { };
+        memcpy(lastSource, source + offset, remainingLength);
+        memcpy(lastDestination, destination + offset, remainingLength);
+        computeBlock(lastSource, lastDestination);
+        memcpy(destination + offset, lastDestination, remainingLength);
+    }
+}
+
+inline void platformArithmeticSSE2(const unsigned char* source, unsigned char* destination,
+    unsigned pixelArrayLength, float k1, float k2, float k3, float k4)
+{
+    if (!k4) {
+        if (!k1) {
+            computeArithmeticPixelsSSE2<0, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+            return;
+        }
+
+        computeArithmeticPixelsSSE2<1, 0>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        return;
+    }
+
+    if (!k1) {
+        computeArithmeticPixelsSSE2<0, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+        return;
+    }
+    computeArithmeticPixelsSSE2<1, 1>(source, destination, pixelArrayLength, k1, k2, k3, k4);
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
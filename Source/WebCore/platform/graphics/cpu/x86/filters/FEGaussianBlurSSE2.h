@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include "SSE2Helpers.h"
+#include <algorithm>
+
+namespace WebCore {
+
+// Same sliding window as boxBlur() with EDGEMODE_NONE, blurring all four channels of a pixel at once.
+// The sums stay integers and the division is done in float, which is exact because a sum never
+// exceeds 255 * (gMaxKernelSize + 1), so the truncated quotient matches the scalar sum / dx.
+inline void boxBlurSSE2(const unsigned char* srcData, unsigned char* dstData,
+    unsigned dx, int dxLeft, int dxRight, int stride, int strideLine, int effectWidth, int effectHeight)
+{
+    const uint32_t* sourcePixel = reinterpret_cast<const uint32_t*>(srcData);
+    uint32_t* destinationPixel = reinterpret_cast<uint32_t*>(dstData);
+
+    __m128 divisor = _mm_set1_ps(static_cast<float>(dx));
+    int pixelLine = strideLine / 4;
+    int pixelStride = stride / 4;
+    int maxKernelSize = std::min(dxRight, effectWidth);
+
+    for (int y = 0; y < effectHeight; ++y) {
+        int line = y * pixelLine;
+        __m128i sum = _mm_setzero_si128();
+
+        // Fill the kernel.
+        for (int i = 0; i < maxKernelSize; ++i)
+            sum = _mm_add_epi32(sum, loadRGBA8AsInt32(sourcePixel + line + i * pixelStride));
+
+        // Blurring.
+        for (int x = 0; x < effectWidth; ++x) {
+            int pixelOffset = line + x * pixelStride;
+            storeInt32AsRGBA8(_mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sum), divisor)), destinationPixel + pixelOffset);
+
+            // Shift kernel.
+            if (x >= dxLeft)
+                sum = _mm_sub_epi32(sum, loadRGBA8AsInt32(sourcePixel + pixelOffset - dxLeft * pixelStride));
+            if (x + dxRight < effectWidth)
+                sum = _mm_add_epi32(sum, loadRGBA8AsInt32(sourcePixel + pixelOffset + dxRight * pixelStride));
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include "SSE2Helpers.h"
+#include <algorithm>
+#include <string.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+template<bool isErode>
+inline __m128i morphologyExtremumSSE2(__m128i a, __m128i b)
+{
+    return isErode ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+}
+
+// Computes the per-channel extremum of rows [yStart, yEnd) for the pixels in columns [xStart, xEnd).
+// Row yStart is always included, even when yEnd <= yStart + 1.
+template<bool isErode>
+inline void columnExtremaSSE2(const uint32_t* source, int width, int xStart, int xEnd, int yStart, int yEnd, uint32_t* extrema)
+{
+    if (xStart >= xEnd)
+        return;
+
+    memcpy(extrema + xStart, source + yStart * width + xStart, (xEnd - xStart) * sizeof(uint32_t));
+    for (int y = yStart + 1; y < yEnd; ++y) {
+        const uint32_t* row = source + y * width;
+        int x = xStart;
+        for (; x + 4 <= xEnd; x += 4) {
+            __m128i* extremum = reinterpret_cast<__m128i*>(extrema + x);
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+            _mm_storeu_si128(extremum, morphologyExtremumSSE2<isErode>(_mm_loadu_si128(extremum), pixels));
+        }
+        for (; x < xEnd; ++x)
+            extrema[x] = _mm_cvtsi128_si32(morphologyExtremumSSE2<isErode>(_mm_cvtsi32_si128(extrema[x]), _mm_cvtsi32_si128(row[x])));
+    }
+}
+
+// Produces the same pixels as FEMorphology::platformApplyGeneric() for rows [yStart, yEnd), including
+// its quirk of leaving the last row of the window out of the first radiusX columns. radiusX must be
+// less than width.
+template<bool isErode>
+inline void morphologySSE2(const unsigned char* srcData, unsigned char* dstData, int width, int height, int radiusX, int radiusY, int yStart, int yEnd)
+{
+    const uint32_t* source = reinterpret_cast<const uint32_t*>(srcData);
+    uint32_t* destination = reinterpret_cast<uint32_t*>(dstData);
+
+    // The column extrema are padded with radiusX neutral pixels on the left and radiusX + 3 on the
+    // right, so every block of 4 output pixels reduces the same 2 * radiusX + 1 wide window.
+    const uint32_t neutralPixel = isErode ? 0xffffffff : 0;
+    Vector<uint32_t> paddedExtrema(width + 2 * radiusX + 3, neutralPixel);
+    uint32_t* extrema = paddedExtrema.data() + radiusX;
+
+    for (int y = yStart; y < yEnd; ++y) {
+        int yStartExtrema = std::max(0, y - radiusY);
+        int yEndExtrema = std::min(height - 1, y + radiusY);
+
+        columnExtremaSSE2<isErode>(source, width, 0, radiusX, yStartExtrema, yEndExtrema, extrema);
+        columnExtremaSSE2<isErode>(source, width, radiusX, width, yStartExtrema, yEndExtrema + 1, extrema);
+
+        uint32_t* destinationRow = destination + y * width;
+        for (int x = 0; x < width; x += 4) {
+            __m128i extremum = _mm_loadu_si128(reinterpret_cast<const __m128i*>(extrema + x - radiusX));
+            for (int offset = -radiusX + 1; offset <= radiusX; ++offset)
+                extremum = morphologyExtremumSSE2<isErode>(extremum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(extrema + x + offset)));
+
+            if (x + 4 <= width) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destinationRow + x), extremum);
+                continue;
+            }
+            uint32_t lastPixels[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lastPixels), extremum);
+            memcpy(destinationRow + x, lastPixels, (width - x) * sizeof(uint32_t));
+        }
+    }
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#if CPU(X86_SSE2)
+
+#include <emmintrin.h>
+#include <stdint.h>
+
+namespace WebCore {
+
+inline __m128i loadRGBA8AsInt32(const uint32_t* source)
+{
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*source), zero), zero);
+}
+
+inline __m128 loadRGBA8AsFloat(const uint32_t* source)
+{
+    return _mm_cvtepi32_ps(loadRGBA8AsInt32(source));
+}
+
+// Values outside of [0, 255] saturate, like clampByte() in the scalar filters.
+inline void storeInt32AsRGBA8(__m128i data, uint32_t* destination)
+{
+    __m128i packed = _mm_packs_epi32(data, data);
+    *destination = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+}
+
+// Splits 16 bytes (4 RGBA8 pixels) into 4 vectors holding one channel value per lane, in memory order.
+inline void unpackBytesAsFloat(__m128i bytes, __m128& bytes0To3, __m128& bytes4To7, __m128& bytes8To11, __m128& bytes12To15)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    bytes0To3 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero));
+    bytes4To7 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero));
+    bytes8To11 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero));
+    bytes12To15 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero));
+}
+
+inline __m128i packInt32AsBytes(__m128i bytes0To3, __m128i bytes4To7, __m128i bytes8To11, __m128i bytes12To15)
+{
+    return _mm_packus_epi16(_mm_packs_epi32(bytes0To3, bytes4To7), _mm_packs_epi32(bytes8To11, bytes12To15));
+}
+
+} // namespace WebCore
+
+#endif // CPU(X86_SSE2)
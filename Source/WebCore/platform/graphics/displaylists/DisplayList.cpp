@@ -51,6 +51,7 @@ void DisplayList::dump() const
 void DisplayList::clear()
 {
     m_list.clear();
+    m_hasUnrecordedDrawing = false;
 }
 
 void DisplayList::removeItemsFromIndex(size_t index)
@@ -120,6 +121,36 @@ size_t DisplayList::sizeInBytes() const
     return result;
 }
 
+bool DisplayList::canBeReplayedOffMainThread() const
+{
+    static const GraphicsContextState::StateChangeFlags unsafeStateChanges = GraphicsContextState::StrokeGradientChange
+        | GraphicsContextState::StrokePatternChange
+        | GraphicsContextState::FillGradientChange
+        | GraphicsContextState::FillPatternChange
+        | GraphicsContextState::ShadowChange;
+
+    for (auto& item : m_list) {
+        switch (item->type()) {
+        case ItemType::SetState:
+            if (downcast<SetState>(item.get()).state().m_changeFlags & unsafeStateChanges)
+                return false;
+            break;
+        case ItemType::DrawImage:
+        case ItemType::DrawTiledImage:
+        case ItemType::DrawTiledScaledImage:
+#if USE(CG) || USE(CAIRO)
+        case ItemType::DrawNativeImage:
+#endif
+        case ItemType::DrawPattern:
+        case ItemType::FillRectWithGradient:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
 } // namespace DisplayList
 
 TextStream& operator<<(TextStream& ts, const DisplayList::DisplayList& displayList)
@@ -72,6 +72,14 @@ public:
 
     size_t itemCount() const { return m_list.size(); }
     size_t sizeInBytes() const;
+
+    // Whether the list can be replayed on a thread other than the one that recorded it. Lists that
+    // draw images, gradients, patterns or shadows can't, as those create or share state lazily.
+    bool canBeReplayedOffMainThread() const;
+
+    // Whether some drawing was left out of the list because it can only be done into a platform
+    // context, in which case replaying the list doesn't reproduce what was painted.
+    bool hasUnrecordedDrawing() const { return m_hasUnrecordedDrawing; }
     
     String asText(AsTextFlags) const;
 
@@ -98,6 +106,7 @@ private:
     Vector<Ref<Item>>& list() { return m_list; }
 
     Vector<Ref<Item>> m_list;
+    bool m_hasUnrecordedDrawing { false };
 };
 
 } // DisplayList
@@ -120,6 +120,8 @@ public:
 
     size_t itemCount() const { return m_displayList.itemCount(); }
 
+    void didSkipUnrecordableDrawing() { m_displayList.m_hasUnrecordedDrawing = true; }
+
 private:
     Item& appendItem(Ref<Item>&&);
     void willAppendItem(const Item&);
@@ -23,6 +23,7 @@
 #include "config.h"
 #include "FEColorMatrix.h"
 
+#include "FEColorMatrixSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "TextStream.h"
@@ -113,6 +114,18 @@ void effectType(Uint8ClampedArray* pixelArray, const Vector<float>& values)
     else if (filterType == FECOLORMATRIX_TYPE_HUEROTATE)
         FEColorMatrix::calculateHueRotateComponents(components, values[0]);
 
+#if CPU(X86_SSE2)
+    // The luminance conversion is computed in double precision, so it stays on the scalar path below.
+    if (filterType == FECOLORMATRIX_TYPE_MATRIX) {
+        colorMatrixSSE2(pixelArray->data(), pixelArrayLength, values.data());
+        return;
+    }
+    if (filterType == FECOLORMATRIX_TYPE_SATURATE || filterType == FECOLORMATRIX_TYPE_HUEROTATE) {
+        saturateAndHueRotateSSE2(pixelArray->data(), pixelArrayLength, components);
+        return;
+    }
+#endif
+
     for (unsigned pixelByteOffset = 0; pixelByteOffset < pixelArrayLength; pixelByteOffset += 4) {
         float red = pixelArray->item(pixelByteOffset);
         float green = pixelArray->item(pixelByteOffset + 1);
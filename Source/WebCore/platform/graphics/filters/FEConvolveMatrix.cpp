@@ -28,7 +28,6 @@
 #include "TextStream.h"
 
 #include <runtime/Uint8ClampedArray.h>
-#include <wtf/ParallelJobs.h>
 #include <wtf/WorkQueue.h>
 
 namespace WebCore {
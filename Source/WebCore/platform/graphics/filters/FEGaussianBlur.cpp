@@ -27,6 +27,7 @@
 #include "FEGaussianBlur.h"
 
 #include "FEGaussianBlurNEON.h"
+#include "FEGaussianBlurSSE2.h"
 #include "Filter.h"
 #include "GraphicsContext.h"
 #include "TextStream.h"
@@ -39,7 +40,8 @@
 #include <runtime/TypedArrayInlines.h>
 #include <runtime/Uint8ClampedArray.h>
 #include <wtf/MathExtras.h>
-#include <wtf/ParallelJobs.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/WorkQueue.h>
 
 static inline float gaussianKernelFactor()
 {
@@ -349,6 +351,11 @@ inline void standardBoxBlur(Uint8ClampedArray* src, Uint8ClampedArray* dst, unsi
                 boxBlurNEON(src, dst, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height());
             else
                 boxBlur(src, dst, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height(), true, edgeMode);
+#elif CPU(X86_SSE2)
+            if (!isAlphaImage && edgeMode == EDGEMODE_NONE)
+                boxBlurSSE2(src->data(), dst->data(), kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height());
+            else
+                boxBlur(src, dst, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height(), isAlphaImage, edgeMode);
 #else
             boxBlur(src, dst, kernelSizeX, dxLeft, dxRight, 4, stride, paintSize.width(), paintSize.height(), isAlphaImage, edgeMode);
 #endif
@@ -362,6 +369,11 @@ inline void standardBoxBlur(Uint8ClampedArray* src, Uint8ClampedArray* dst, unsi
                 boxBlurNEON(src, dst, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width());
             else
                 boxBlur(src, dst, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width(), true, edgeMode);
+#elif CPU(X86_SSE2)
+            if (!isAlphaImage && edgeMode == EDGEMODE_NONE)
+                boxBlurSSE2(src->data(), dst->data(), kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width());
+            else
+                boxBlur(src, dst, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width(), isAlphaImage, edgeMode);
 #else
             boxBlur(src, dst, kernelSizeY, dyLeft, dyRight, stride, 4, paintSize.height(), paintSize.width(), isAlphaImage, edgeMode);
 #endif
@@ -390,13 +402,6 @@ inline void FEGaussianBlur::platformApplyGeneric(Uint8ClampedArray* srcPixelArra
     standardBoxBlur(srcPixelArray, tmpPixelArray, kernelSizeX, kernelSizeY, stride, paintSize, isAlphaImage(), m_edgeMode);
 }
 
-void FEGaussianBlur::platformApplyWorker(PlatformApplyParameters* parameters)
-{
-    IntSize paintSize(parameters->width, parameters->height);
-    parameters->filter->platformApplyGeneric(parameters->srcPixelArray.get(), parameters->dstPixelArray.get(),
-        parameters->kernelSizeX, parameters->kernelSizeY, paintSize);
-}
-
 inline void FEGaussianBlur::platformApply(Uint8ClampedArray* srcPixelArray, Uint8ClampedArray* tmpPixelArray, unsigned kernelSizeX, unsigned kernelSizeY, IntSize& paintSize)
 {
 #if !USE(ACCELERATE)
@@ -405,10 +410,12 @@ inline void FEGaussianBlur::platformApply(Uint8ClampedArray* srcPixelArray, Uint
     int optimalThreadNumber = (paintSize.width() * paintSize.height()) / (s_minimalRectDimension + extraHeight * paintSize.width());
 
     if (optimalThreadNumber > 1) {
-        WTF::ParallelJobs<PlatformApplyParameters> parallelJobs(&platformApplyWorker, optimalThreadNumber);
-
-        int jobs = parallelJobs.numberOfJobs();
+        // Every block also blurs extraHeight rows of its neighbours, so unlike the other filters the
+        // image is not split into more blocks than there are cores.
+        int jobs = std::min<int>(optimalThreadNumber, numberOfProcessorCores());
         if (jobs > 1) {
+            Vector<PlatformApplyParameters> parallelJobs(jobs);
+
             // Split the job into "blockHeight"-sized jobs but there a few jobs that need to be slightly larger since
             // blockHeight * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
             const int blockHeight = paintSize.height() / jobs;
@@ -416,8 +423,7 @@ inline void FEGaussianBlur::platformApply(Uint8ClampedArray* srcPixelArray, Uint
 
             int currentY = 0;
             for (int job = 0; job < jobs; job++) {
-                PlatformApplyParameters& params = parallelJobs.parameter(job);
-                params.filter = this;
+                PlatformApplyParameters& params = parallelJobs[job];
 
                 int startY = !job ? 0 : currentY - extraHeight;
                 currentY += job < jobsWithExtra ? blockHeight + 1 : blockHeight;
@@ -439,12 +445,16 @@ inline void FEGaussianBlur::platformApply(Uint8ClampedArray* srcPixelArray, Uint
                 params.kernelSizeY = kernelSizeY;
             }
 
-            parallelJobs.execute();
+            WorkQueue::concurrentApply(jobs, [&](size_t index) {
+                PlatformApplyParameters& params = parallelJobs[index];
+                IntSize blockSize(params.width, params.height);
+                platformApplyGeneric(params.srcPixelArray.get(), params.dstPixelArray.get(), params.kernelSizeX, params.kernelSizeY, blockSize);
+            });
 
             // Copy together the parts of the image.
             currentY = 0;
             for (int job = 1; job < jobs; job++) {
-                PlatformApplyParameters& params = parallelJobs.parameter(job);
+                PlatformApplyParameters& params = parallelJobs[job];
                 int sourceOffset;
                 int destinationOffset;
                 int size;
@@ -53,11 +53,7 @@ public:
 private:
     static const int s_minimalRectDimension = 100 * 100; // Empirical data limit for parallel jobs
 
-    template<typename Type>
-    friend class ParallelJobs;
-
     struct PlatformApplyParameters {
-        FEGaussianBlur* filter;
         RefPtr<Uint8ClampedArray> srcPixelArray;
         RefPtr<Uint8ClampedArray> dstPixelArray;
         int width;
@@ -66,8 +62,6 @@ private:
         unsigned kernelSizeY;
     };
 
-    static void platformApplyWorker(PlatformApplyParameters*);
-
     FEGaussianBlur(Filter&, float, float, EdgeModeType);
 
     inline void platformApply(Uint8ClampedArray* srcPixelArray, Uint8ClampedArray* tmpPixelArray, unsigned kernelSizeX, unsigned kernelSizeY, IntSize& paintSize);
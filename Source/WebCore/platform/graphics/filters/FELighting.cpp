@@ -28,7 +28,7 @@
 #include "FELighting.h"
 
 #include "FELightingNEON.h"
-#include <wtf/ParallelJobs.h>
+#include <wtf/WorkQueue.h>
 
 namespace WebCore {
 
@@ -240,43 +240,16 @@ inline void FELighting::platformApplyGenericPaint(LightingData& data, LightSourc
     }
 }
 
-void FELighting::platformApplyGenericWorker(PlatformApplyGenericParameters* parameters)
-{
-    parameters->filter->platformApplyGenericPaint(parameters->data, parameters->paintingData, parameters->yStart, parameters->yEnd);
-}
-
 inline void FELighting::platformApplyGeneric(LightingData& data, LightSource::PaintingData& paintingData)
 {
-    int optimalThreadNumber = ((data.widthDecreasedByOne - 1) * (data.heightDecreasedByOne - 1)) / s_minimalRectDimension;
-    if (optimalThreadNumber > 1) {
-        // Initialize parallel jobs
-        WTF::ParallelJobs<PlatformApplyGenericParameters> parallelJobs(&platformApplyGenericWorker, optimalThreadNumber);
-
-        // Fill the parameter array
-        int job = parallelJobs.numberOfJobs();
-        if (job > 1) {
-            // Split the job into "yStep"-sized jobs but there a few jobs that need to be slightly larger since
-            // yStep * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int yStep = (data.heightDecreasedByOne - 1) / job;
-            const int jobsWithExtra = (data.heightDecreasedByOne - 1) % job;
-
-            int yStart = 1;
-            for (--job; job >= 0; --job) {
-                PlatformApplyGenericParameters& params = parallelJobs.parameter(job);
-                params.filter = this;
-                params.data = data;
-                params.paintingData = paintingData;
-                params.yStart = yStart;
-                yStart += job < jobsWithExtra ? yStep + 1 : yStep;
-                params.yEnd = yStart;
-            }
-            parallelJobs.execute();
-            return;
-        }
-        // Fallback to single threaded mode.
-    }
-
-    platformApplyGenericPaint(data, paintingData, 1, data.heightDecreasedByOne);
+    // The light source updates the painting data for every pixel, so each tile works on its own copy.
+    int height = data.heightDecreasedByOne - 1;
+    int rowsPerTile = std::max(1, s_minimalRectDimension / (data.widthDecreasedByOne - 1));
+    WorkQueue::concurrentApply((height + rowsPerTile - 1) / rowsPerTile, [&](size_t index) {
+        LightSource::PaintingData tilePaintingData = paintingData;
+        int yStart = 1 + index * rowsPerTile;
+        platformApplyGenericPaint(data, tilePaintingData, yStart, std::min(yStart + rowsPerTile, data.heightDecreasedByOne));
+    });
 }
 
 inline void FELighting::platformApply(LightingData& data, LightSource::PaintingData& paintingData)
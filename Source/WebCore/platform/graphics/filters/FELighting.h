@@ -39,8 +39,6 @@
 
 namespace WebCore {
 
-struct FELightingPaintingDataForNeon;
-
 class FELighting : public FilterEffect {
 public:
     void platformApplySoftware() override;
@@ -48,7 +46,7 @@ public:
     void determineAbsolutePaintRect() override { setAbsolutePaintRect(enclosingIntRect(maxEffectRect())); }
 
 protected:
-    static const int s_minimalRectDimension = 100 * 100; // Empirical data limit for parallel jobs
+    static const int s_minimalRectDimension = 100 * 100; // Number of pixels painted by each parallel task
 
     enum LightingType {
         DiffuseLighting,
@@ -74,20 +72,6 @@ protected:
         inline void bottomRight(int offset, IntPoint& normalVector);
     };
 
-    template<typename Type>
-    friend class ParallelJobs;
-
-    struct PlatformApplyGenericParameters {
-        FELighting* filter;
-        LightingData data;
-        LightSource::PaintingData paintingData;
-        int yStart;
-        int yEnd;
-    };
-
-    static void platformApplyGenericWorker(PlatformApplyGenericParameters*);
-    static void platformApplyNeonWorker(FELightingPaintingDataForNeon*);
-
     FELighting(Filter&, LightingType, const Color&, float, float, float, float, float, float, PassRefPtr<LightSource>);
 
     bool drawLighting(Uint8ClampedArray*, int, int);
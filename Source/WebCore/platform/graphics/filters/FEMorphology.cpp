@@ -24,12 +24,13 @@
 #include "config.h"
 #include "FEMorphology.h"
 
+#include "FEMorphologySSE2.h"
 #include "Filter.h"
 #include "TextStream.h"
 
 #include <runtime/Uint8ClampedArray.h>
-#include <wtf/ParallelJobs.h>
 #include <wtf/Vector.h>
+#include <wtf/WorkQueue.h>
 
 namespace WebCore {
 
@@ -128,6 +129,13 @@ void FEMorphology::platformApplyGeneric(PaintingData* paintingData, int yStart,
     ASSERT(radiusX <= width || radiusY <= height);
     ASSERT(yStart >= 0 && yEnd <= height && yStart < yEnd);
 
+#if CPU(X86_SSE2)
+    ASSERT(radiusX < width);
+    if (m_type == FEMORPHOLOGY_OPERATOR_ERODE)
+        morphologySSE2<true>(srcPixelArray->data(), dstPixelArray->data(), width, height, radiusX, radiusY, yStart, yEnd);
+    else
+        morphologySSE2<false>(srcPixelArray->data(), dstPixelArray->data(), width, height, radiusX, radiusY, yStart, yEnd);
+#else
     Vector<unsigned char> extrema;
     for (int y = yStart; y < yEnd; ++y) {
         int yStartExtrema = std::max(0, y - radiusY);
@@ -157,40 +165,16 @@ void FEMorphology::platformApplyGeneric(PaintingData* paintingData, int yStart,
             }
         }
     }
-}
-
-void FEMorphology::platformApplyWorker(PlatformApplyParameters* param)
-{
-    param->filter->platformApplyGeneric(param->paintingData, param->startY, param->endY);
+#endif
 }
 
 void FEMorphology::platformApply(PaintingData* paintingData)
 {
-    int optimalThreadNumber = (paintingData->width * paintingData->height) / s_minimalArea;
-    if (optimalThreadNumber > 1) {
-        ParallelJobs<PlatformApplyParameters> parallelJobs(&WebCore::FEMorphology::platformApplyWorker, optimalThreadNumber);
-        int numOfThreads = parallelJobs.numberOfJobs();
-        if (numOfThreads > 1) {
-            // Split the job into "jobSize"-sized jobs but there a few jobs that need to be slightly larger since
-            // jobSize * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int jobSize = paintingData->height / numOfThreads;
-            const int jobsWithExtra = paintingData->height % numOfThreads;
-            int currentY = 0;
-            for (int job = numOfThreads - 1; job >= 0; --job) {
-                PlatformApplyParameters& param = parallelJobs.parameter(job);
-                param.filter = this;
-                param.startY = currentY;
-                currentY += job < jobsWithExtra ? jobSize + 1 : jobSize;
-                param.endY = currentY;
-                param.paintingData = paintingData;
-            }
-            parallelJobs.execute();
-            return;
-        }
-        // Fallback to single thread model
-    }
-
-    platformApplyGeneric(paintingData, 0, paintingData->height);
+    int rowsPerTile = std::max(1, s_minimalArea / paintingData->width);
+    WorkQueue::concurrentApply((paintingData->height + rowsPerTile - 1) / rowsPerTile, [&](size_t index) {
+        int startY = index * rowsPerTile;
+        platformApplyGeneric(paintingData, startY, std::min(startY + rowsPerTile, paintingData->height));
+    });
 }
 
 bool FEMorphology::platformApplyDegenerate(Uint8ClampedArray* dstPixelArray, const IntRect& imageRect, int radiusX, int radiusY)
@@ -240,8 +224,10 @@ void FEMorphology::platformApplySoftware()
     paintingData.dstPixelArray = dstPixelArray;
     paintingData.width = ceilf(effectDrawingRect.width() * filter.filterScale());
     paintingData.height = ceilf(effectDrawingRect.height() * filter.filterScale());
-    paintingData.radiusX = ceilf(radiusX * filter.filterScale());
-    paintingData.radiusY = ceilf(radiusY * filter.filterScale());
+    // Rounding up at a filter scale below 1 can make the radius reach the scaled size. Any radius
+    // past size - 1 already spans the whole row or column, so clamp it there as above.
+    paintingData.radiusX = std::min(paintingData.width - 1, static_cast<int>(ceilf(radiusX * filter.filterScale())));
+    paintingData.radiusY = std::min(paintingData.height - 1, static_cast<int>(ceilf(radiusY * filter.filterScale())));
 
     platformApply(&paintingData);
 }
@@ -62,16 +62,7 @@ public:
         int radiusY;
     };
 
-    static const int s_minimalArea = (300 * 300); // Empirical data limit for parallel jobs
-
-    struct PlatformApplyParameters {
-        FEMorphology* filter;
-        int startY;
-        int endY;
-        PaintingData* paintingData;
-    };
-
-    static void platformApplyWorker(PlatformApplyParameters*);
+    static const int s_minimalArea = (300 * 300); // Number of pixels processed by each parallel task
 
     inline void platformApply(PaintingData*);
     inline void platformApplyGeneric(PaintingData*, const int yStart, const int yEnd);
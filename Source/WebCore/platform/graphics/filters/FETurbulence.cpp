@@ -30,7 +30,7 @@
 
 #include <runtime/Uint8ClampedArray.h>
 #include <wtf/MathExtras.h>
-#include <wtf/ParallelJobs.h>
+#include <wtf/WorkQueue.h>
 
 namespace WebCore {
 
@@ -348,11 +348,6 @@ inline void FETurbulence::fillRegion(Uint8ClampedArray* pixelArray, PaintingData
     }
 }
 
-void FETurbulence::fillRegionWorker(FillRegionParameters* parameters)
-{
-    parameters->filter->fillRegion(parameters->pixelArray, *parameters->paintingData, parameters->startY, parameters->endY);
-}
-
 void FETurbulence::platformApplySoftware()
 {
     Uint8ClampedArray* pixelArray = createUnmultipliedImageResult();
@@ -367,38 +362,12 @@ void FETurbulence::platformApplySoftware()
     PaintingData paintingData(m_seed, roundedIntSize(filterPrimitiveSubregion().size()));
     initPaint(paintingData);
 
-    int optimalThreadNumber = (absolutePaintRect().width() * absolutePaintRect().height()) / s_minimalRectDimension;
-    if (optimalThreadNumber > 1) {
-        // Initialize parallel jobs
-        WTF::ParallelJobs<FillRegionParameters> parallelJobs(&WebCore::FETurbulence::fillRegionWorker, optimalThreadNumber);
-
-        // Fill the parameter array
-        int i = parallelJobs.numberOfJobs();
-        if (i > 1) {
-            // Split the job into "stepY"-sized jobs but there a few jobs that need to be slightly larger since
-            // stepY * jobs < total size. These extras are handled by the remainder "jobsWithExtra".
-            const int stepY = absolutePaintRect().height() / i;
-            const int jobsWithExtra = absolutePaintRect().height() % i;
-
-            int startY = 0;
-            for (; i > 0; --i) {
-                FillRegionParameters& params = parallelJobs.parameter(i-1);
-                params.filter = this;
-                params.pixelArray = pixelArray;
-                params.paintingData = &paintingData;
-                params.startY = startY;
-                startY += i < jobsWithExtra ? stepY + 1 : stepY;
-                params.endY = startY;
-            }
-
-            // Execute parallel jobs
-            parallelJobs.execute();
-            return;
-        }
-    }
-
-    // Fallback to single threaded mode if there is no room for a new thread or the paint area is too small.
-    fillRegion(pixelArray, paintingData, 0, absolutePaintRect().height());
+    int height = absolutePaintRect().height();
+    int rowsPerTile = std::max(1, s_minimalRectDimension / absolutePaintRect().width());
+    WorkQueue::concurrentApply((height + rowsPerTile - 1) / rowsPerTile, [&](size_t index) {
+        int startY = index * rowsPerTile;
+        fillRegion(pixelArray, paintingData, startY, std::min(startY + rowsPerTile, height));
+    });
 }
 
 void FETurbulence::dump()
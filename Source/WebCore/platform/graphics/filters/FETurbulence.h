@@ -57,8 +57,6 @@ public:
     bool stitchTiles() const;
     bool setStitchTiles(bool);
 
-    static void fillRegionWorker(void*);
-
     void platformApplySoftware() override;
     void dump() override;
     
@@ -70,7 +68,7 @@ private:
     static const int s_blockSize = 256;
     static const int s_blockMask = s_blockSize - 1;
 
-    static const int s_minimalRectDimension = (100 * 100); // Empirical data limit for parallel jobs.
+    static const int s_minimalRectDimension = (100 * 100); // Number of pixels filled by each parallel task.
 
     struct PaintingData {
         PaintingData(long paintingSeed, const IntSize& paintingSize)
@@ -102,19 +100,6 @@ private:
         int wrapY;
     };
 
-    template<typename Type>
-    friend class ParallelJobs;
-
-    struct FillRegionParameters {
-        FETurbulence* filter;
-        Uint8ClampedArray* pixelArray;
-        PaintingData* paintingData;
-        int startY;
-        int endY;
-    };
-
-    static void fillRegionWorker(FillRegionParameters*);
-
     FETurbulence(Filter&, TurbulenceType, float, float, int, float, bool);
 
     inline void initPaint(PaintingData&);
@@ -312,6 +312,15 @@ void CoordinatedGraphicsLayer::setContentsOpaque(bool b)
     didChangeLayerState();
 }
 
+void CoordinatedGraphicsLayer::setUsesDisplayListDrawing(bool usesDisplayListDrawing)
+{
+    if (usesDisplayListDrawing == this->usesDisplayListDrawing())
+        return;
+    if (m_mainBackingStore)
+        m_mainBackingStore->setUsesDisplayListDrawing(usesDisplayListDrawing);
+    GraphicsLayer::setUsesDisplayListDrawing(usesDisplayListDrawing);
+}
+
 void CoordinatedGraphicsLayer::setBackfaceVisibility(bool b)
 {
     if (backfaceVisibility() == b)
@@ -837,6 +846,7 @@ void CoordinatedGraphicsLayer::createBackingStore()
 {
     m_mainBackingStore = std::make_unique<TiledBackingStore>(this, effectiveContentsScale());
     m_mainBackingStore->setSupportsAlpha(!contentsOpaque());
+    m_mainBackingStore->setUsesDisplayListDrawing(usesDisplayListDrawing());
 }
 
 void CoordinatedGraphicsLayer::tiledBackingStorePaint(GraphicsContext& context, const IntRect& rect)
@@ -84,6 +84,7 @@ public:
     void setContentsVisible(bool) override;
     void setContentsOpaque(bool) override;
     void setBackfaceVisibility(bool) override;
+    void setUsesDisplayListDrawing(bool) override;
     void setOpacity(float) override;
     void setContentsRect(const FloatRect&) override;
     void setContentsTilePhase(const FloatSize&) override;
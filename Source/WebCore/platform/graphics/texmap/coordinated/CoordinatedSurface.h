@@ -23,6 +23,7 @@
 
 #if USE(COORDINATED_GRAPHICS)
 #include "IntRect.h"
+#include <wtf/Function.h>
 #include <wtf/RefPtr.h>
 #include <wtf/ThreadSafeRefCounted.h>
 
@@ -42,6 +43,10 @@ public:
     public:
         virtual ~Client() { }
         virtual void paintToSurfaceContext(GraphicsContext&) = 0;
+
+        // Returns a function that does the same painting as paintToSurfaceContext() and is safe to
+        // call on another thread, or null if the client can only paint on the main thread.
+        virtual Function<void(GraphicsContext&)> createThreadSafePaintFunction() { return nullptr; }
     };
 
     typedef RefPtr<CoordinatedSurface> Factory(const IntSize&, Flags);
@@ -55,6 +60,13 @@ public:
 
     virtual void paintToSurface(const IntRect&, Client&) = 0;
 
+    // Returns a function that paints |rect| through the client's thread-safe paint function and
+    // can be called on any thread, or null if the surface or the client only supports painting
+    // synchronously on the main thread. The function must be destroyed on the main thread.
+    virtual Function<void()> createThreadSafePainter(const IntRect&, Client&) { return nullptr; }
+    // Called on the main thread once the painter created for |rect| has finished.
+    virtual void didPaintOnRasterThread(const IntRect&) { }
+
 #if USE(TEXTURE_MAPPER)
     virtual void copyToTexture(RefPtr<BitmapTexture>, const IntRect& target, const IntPoint& sourceOffset) = 0;
 #endif
@@ -27,15 +27,34 @@
 #include "Tile.h"
 
 #if USE(COORDINATED_GRAPHICS)
+#include "DisplayListRecorder.h"
+#include "DisplayListReplayer.h"
 #include "GraphicsContext.h"
 #include "SurfaceUpdateInfo.h"
 #include "TiledBackingStore.h"
 #include "TiledBackingStoreClient.h"
+#include <wtf/SetForScope.h>
 
 namespace WebCore {
 
 static const uint32_t InvalidTileID = 0;
 
+TileContentsRecording::TileContentsRecording(TiledBackingStoreClient& client, const IntRect& contentsRect)
+{
+    GraphicsContext context;
+    {
+        DisplayList::Recorder recorder(context, m_displayList, contentsRect, AffineTransform());
+        client.tiledBackingStorePaint(context, contentsRect);
+    }
+    m_canBeReplayedOffMainThread = m_displayList.canBeReplayedOffMainThread();
+}
+
+void TileContentsRecording::replay(GraphicsContext& context, const IntRect& contentsRect) const
+{
+    DisplayList::Replayer replayer(context, m_displayList);
+    replayer.replay(contentsRect);
+}
+
 Tile::Tile(TiledBackingStore& tiledBackingStore, const Coordinate& tileCoordinate)
     : m_tiledBackingStore(tiledBackingStore)
     , m_coordinate(tileCoordinate)
@@ -65,11 +84,13 @@ void Tile::invalidate(const IntRect& dirtyRect)
     m_dirtyRect.unite(tileDirtyRect);
 }
 
-bool Tile::updateBackBuffer()
+bool Tile::updateBackBuffer(TileContentsRecording* contentsRecording)
 {
     if (!isDirty())
         return false;
 
+    SetForScope<RefPtr<TileContentsRecording>> contentsRecordingForScope(m_contentsRecording, contentsRecording);
+
     SurfaceUpdateInfo updateInfo;
 
     if (!m_tiledBackingStore.client()->paintToSurface(m_dirtyRect.size(), updateInfo.atlasID, updateInfo.surfaceOffset, *this))
@@ -97,9 +118,26 @@ void Tile::paintToSurfaceContext(GraphicsContext& context)
 {
     context.translate(-m_dirtyRect.x(), -m_dirtyRect.y());
     context.scale(FloatSize(m_tiledBackingStore.contentsScale(), m_tiledBackingStore.contentsScale()));
+    if (m_contentsRecording) {
+        m_contentsRecording->replay(context, m_tiledBackingStore.mapToContents(m_dirtyRect));
+        return;
+    }
     m_tiledBackingStore.client()->tiledBackingStorePaint(context, m_tiledBackingStore.mapToContents(m_dirtyRect));
 }
 
+Function<void(GraphicsContext&)> Tile::createThreadSafePaintFunction()
+{
+    if (!m_contentsRecording || !m_contentsRecording->canBeReplayedOffMainThread())
+        return nullptr;
+
+    // Capture everything by value; the tile and its backing store may be gone by the time this runs.
+    return [contentsRecording = makeRef(*m_contentsRecording), dirtyRect = m_dirtyRect, contentsRect = m_tiledBackingStore.mapToContents(m_dirtyRect), contentsScale = m_tiledBackingStore.contentsScale()](GraphicsContext& context) {
+        context.translate(-dirtyRect.x(), -dirtyRect.y());
+        context.scale(FloatSize(contentsScale, contentsScale));
+        contentsRecording->replay(context, contentsRect);
+    };
+}
+
 bool Tile::isReadyToPaint() const
 {
     return m_ID != InvalidTileID;
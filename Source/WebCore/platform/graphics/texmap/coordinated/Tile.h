@@ -28,15 +28,38 @@
 
 #if USE(COORDINATED_GRAPHICS)
 #include "CoordinatedSurface.h"
+#include "DisplayList.h"
 #include "IntPoint.h"
 #include "IntPointHash.h"
 #include "IntRect.h"
 #include <wtf/RefCounted.h>
+#include <wtf/ThreadSafeRefCounted.h>
 
 namespace WebCore {
 
 class GraphicsContext;
 class TiledBackingStore;
+class TiledBackingStoreClient;
+
+// The contents of a backing store's dirty tiles, recorded once on the main thread and replayed
+// into each tile, on a raster thread when the surface supports it.
+class TileContentsRecording : public ThreadSafeRefCounted<TileContentsRecording> {
+public:
+    static Ref<TileContentsRecording> create(TiledBackingStoreClient& client, const IntRect& contentsRect)
+    {
+        return adoptRef(*new TileContentsRecording(client, contentsRect));
+    }
+
+    bool canBeReplayedOffMainThread() const { return m_canBeReplayedOffMainThread; }
+    bool hasUnrecordedDrawing() const { return m_displayList.hasUnrecordedDrawing(); }
+    void replay(GraphicsContext&, const IntRect& contentsRect) const;
+
+private:
+    TileContentsRecording(TiledBackingStoreClient&, const IntRect& contentsRect);
+
+    DisplayList::DisplayList m_displayList;
+    bool m_canBeReplayedOffMainThread;
+};
 
 class Tile : public CoordinatedSurface::Client {
 public:
@@ -46,8 +69,9 @@ public:
     ~Tile();
 
     bool isDirty() const;
+    const IntRect& dirtyRect() const { return m_dirtyRect; }
     void invalidate(const IntRect&);
-    bool updateBackBuffer();
+    bool updateBackBuffer(TileContentsRecording* = nullptr);
     bool isReadyToPaint() const;
 
     const Coordinate& coordinate() const { return m_coordinate; }
@@ -55,6 +79,7 @@ public:
     void resize(const IntSize&);
 
     void paintToSurfaceContext(GraphicsContext&) override;
+    Function<void(GraphicsContext&)> createThreadSafePaintFunction() override;
 
 private:
     TiledBackingStore& m_tiledBackingStore;
@@ -63,6 +88,7 @@ private:
 
     uint32_t m_ID;
     IntRect m_dirtyRect;
+    RefPtr<TileContentsRecording> m_contentsRecording;
 };
 
 } // namespace WebCore
@@ -42,6 +42,7 @@ TiledBackingStore::TiledBackingStore(TiledBackingStoreClient* client, float cont
     , m_coverAreaMultiplier(2.0f)
     , m_contentsScale(contentsScale)
     , m_supportsAlpha(false)
+    , m_usesDisplayListDrawing(false)
     , m_pendingTileCreation(false)
 {
 }
@@ -95,18 +96,47 @@ void TiledBackingStore::updateTileBuffers()
     // FIXME: In single threaded case, tile back buffers could be updated asynchronously 
     // one by one and then swapped to front in one go. This would minimize the time spent
     // blocking on tile updates.
+    RefPtr<TileContentsRecording> contentsRecording = recordDirtyTileContents();
+
     bool updated = false;
     for (auto& tile : m_tiles.values()) {
         if (!tile->isDirty())
             continue;
 
-        updated |= tile->updateBackBuffer();
+        updated |= tile->updateBackBuffer(contentsRecording.get());
     }
 
     if (updated)
         m_client->didUpdateTileBuffers();
 }
 
+RefPtr<TileContentsRecording> TiledBackingStore::recordDirtyTileContents()
+{
+    if (!m_usesDisplayListDrawing)
+        return nullptr;
+
+    IntRect dirtyRect;
+    unsigned dirtyTileCount = 0;
+    for (auto& tile : m_tiles.values()) {
+        if (!tile->isDirty())
+            continue;
+        dirtyRect.unite(tile->dirtyRect());
+        ++dirtyTileCount;
+    }
+
+    // A single tile is cheaper to paint directly than to record and replay.
+    if (dirtyTileCount < 2)
+        return nullptr;
+
+    auto contentsRecording = TileContentsRecording::create(*m_client, mapToContents(dirtyRect));
+
+    // Native theme and scrollbar painting can't be recorded, so the tiles paint the layer directly instead.
+    if (contentsRecording->hasUnrecordedDrawing())
+        return nullptr;
+
+    return WTFMove(contentsRecording);
+}
+
 double TiledBackingStore::tileDistance(const IntRect& viewport, const Tile::Coordinate& tileCoordinate) const
 {
     if (viewport.intersects(tileRectForCoordinate(tileCoordinate)))
@@ -64,6 +64,7 @@ public:
     void removeAllNonVisibleTiles(const IntRect& unscaledVisibleRect, const IntRect& contentsRect);
 
     void setSupportsAlpha(bool);
+    void setUsesDisplayListDrawing(bool usesDisplayListDrawing) { m_usesDisplayListDrawing = usesDisplayListDrawing; }
 
 private:
     void createTiles(const IntRect& visibleRect, const IntRect& scaledContentsRect, float coverAreaMultiplier);
@@ -78,6 +79,8 @@ private:
 
     void paintCheckerPattern(GraphicsContext*, const IntRect&, const Tile::Coordinate&);
 
+    RefPtr<TileContentsRecording> recordDirtyTileContents();
+
 private:
     TiledBackingStoreClient* m_client;
 
@@ -98,6 +101,7 @@ private:
     float m_contentsScale;
 
     bool m_supportsAlpha;
+    bool m_usesDisplayListDrawing;
     bool m_pendingTileCreation;
 
     friend class Tile;
@@ -466,6 +466,12 @@ bool ScrollbarThemeGtk::paint(Scrollbar& scrollbar, GraphicsContext& graphicsCon
     if (graphicsContext.paintingDisabled())
         return false;
 
+    // GTK renders straight into the cairo context, which display list recording doesn't have.
+    if (UNLIKELY(graphicsContext.isRecording())) {
+        graphicsContext.didSkipUnrecordableDrawing();
+        return false;
+    }
+
     if (!scrollbar.enabled())
         return true;
 
@@ -712,6 +718,12 @@ bool ScrollbarThemeGtk::paint(Scrollbar& scrollbar, GraphicsContext& graphicsCon
     if (graphicsContext.paintingDisabled())
         return false;
 
+    // GTK renders straight into the cairo context, which display list recording doesn't have.
+    if (UNLIKELY(graphicsContext.isRecording())) {
+        graphicsContext.didSkipUnrecordableDrawing();
+        return false;
+    }
+
     GRefPtr<GtkStyleContext> styleContext = createStyleContext(&scrollbar);
 
     // Create the ScrollbarControlPartMask based on the damageRect
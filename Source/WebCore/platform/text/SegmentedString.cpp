@@ -20,9 +20,14 @@
 #include "config.h"
 #include "SegmentedString.h"
 
+#include <wtf/MathExtras.h>
 #include <wtf/text/StringBuilder.h>
 #include <wtf/text/TextPosition.h>
 
+#if CPU(X86_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace WebCore {
 
 inline void SegmentedString::Substring::appendTo(StringBuilder& builder) const
@@ -220,6 +225,60 @@ void SegmentedString::updateAdvanceFunctionPointersForSingleCharacterSubstring()
         m_advanceAndUpdateLineNumberFunction = &SegmentedString::advancePastSingleCharacterSubstringWithoutUpdatingLineNumber;
 }
 
+static inline bool isRunTerminator(LChar character, LChar delimiter1, LChar delimiter2)
+{
+    return character == delimiter1 || character == delimiter2 || !character || character == '\n' || character == '\r';
+}
+
+static const LChar* findRunTerminator(const LChar* characters, const LChar* end, LChar delimiter1, LChar delimiter2)
+{
+#if CPU(X86_SSE2)
+    // Text and attribute values are mostly long runs of ordinary characters, so check 16 at a time.
+    const __m128i delimiter1Vector = _mm_set1_epi8(delimiter1);
+    const __m128i delimiter2Vector = _mm_set1_epi8(delimiter2);
+    const __m128i nullVector = _mm_setzero_si128();
+    const __m128i newlineVector = _mm_set1_epi8('\n');
+    const __m128i carriageReturnVector = _mm_set1_epi8('\r');
+    for (; end - characters >= static_cast<ptrdiff_t>(sizeof(__m128i)); characters += sizeof(__m128i)) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiter1Vector), _mm_cmpeq_epi8(chunk, delimiter2Vector));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, nullVector));
+        matches = _mm_or_si128(matches, _mm_or_si128(_mm_cmpeq_epi8(chunk, newlineVector), _mm_cmpeq_epi8(chunk, carriageReturnVector)));
+        if (unsigned mask = _mm_movemask_epi8(matches))
+            return characters + WTF::countTrailingZeros(mask);
+    }
+#endif
+
+    for (; characters < end; ++characters) {
+        if (isRunTerminator(*characters, delimiter1, delimiter2))
+            return characters;
+    }
+    return end;
+}
+
+unsigned SegmentedString::advancePastCharactersExcept(LChar delimiter1, LChar delimiter2, const LChar*& run)
+{
+    if (!(m_fastPathFlags & Use8BitAdvance))
+        return 0;
+
+    ASSERT(m_currentSubstring.length > 1);
+    run = m_currentSubstring.currentCharacter8;
+    // Never consume the last character of the substring, so moving on to the next substring
+    // stays the job of the regular advance functions.
+    const LChar* runEnd = findRunTerminator(run, run + m_currentSubstring.length - 1, delimiter1, delimiter2);
+    unsigned length = runEnd - run;
+    if (!length)
+        return 0;
+
+    // The run contains no newlines, so there are no line numbers to update.
+    m_currentSubstring.currentCharacter8 = runEnd;
+    m_currentSubstring.length -= length;
+    m_currentCharacter = *runEnd;
+    if (m_currentSubstring.length == 1)
+        updateAdvanceFunctionPointersForSingleCharacterSubstring();
+    return length;
+}
+
 OrdinalNumber SegmentedString::currentLine() const
 {
     return OrdinalNumber::fromZeroBasedInt(m_currentLine);
@@ -66,6 +66,12 @@ public:
     template<unsigned length> AdvancePastResult advancePast(const char (&literal)[length]) { return advancePast<length, false>(literal); }
     template<unsigned length> AdvancePastResult advancePastLettersIgnoringASCIICase(const char (&literal)[length]) { return advancePast<length, true>(literal); }
 
+    // Consumes the run of 8-bit characters starting at the current character that contains neither
+    // delimiter nor any character the input stream preprocessor cares about ('\0', '\n', '\r').
+    // Returns the length of the run and points |run| at it; returns 0 without consuming anything if
+    // the current substring is not 8-bit or the current character ends the run.
+    unsigned advancePastCharactersExcept(LChar delimiter1, LChar delimiter2, const LChar*& run);
+
     unsigned numberOfCharactersConsumed() const;
 
     String toString() const;
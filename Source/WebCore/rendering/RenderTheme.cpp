@@ -278,8 +278,10 @@ bool RenderTheme::paint(const RenderBox& box, ControlStates& controlStates, cons
     if (paintInfo.context().paintingDisabled())
         return false;
 
-    if (UNLIKELY(paintInfo.context().isRecording()))
+    if (UNLIKELY(paintInfo.context().isRecording())) {
+        paintInfo.context().didSkipUnrecordableDrawing();
         return false;
+    }
 
     ControlPart part = box.style().appearance();
     IntRect integralSnappedRect = snappedIntRect(rect);
@@ -428,6 +430,11 @@ bool RenderTheme::paintBorderOnly(const RenderBox& box, const PaintInfo& paintIn
     UNUSED_PARAM(rect);
     return box.style().appearance() != NoControlPart;
 #else
+    if (UNLIKELY(paintInfo.context().isRecording())) {
+        paintInfo.context().didSkipUnrecordableDrawing();
+        return false;
+    }
+
     FloatRect devicePixelSnappedRect = snapRectToDevicePixels(rect, box.document().deviceScaleFactor());
     // Call the appropriate paint method based off the appearance value.
     switch (box.style().appearance()) {
@@ -478,6 +485,11 @@ bool RenderTheme::paintDecorations(const RenderBox& box, const PaintInfo& paintI
     if (paintInfo.context().paintingDisabled())
         return false;
 
+    if (UNLIKELY(paintInfo.context().isRecording())) {
+        paintInfo.context().didSkipUnrecordableDrawing();
+        return false;
+    }
+
     IntRect integralSnappedRect = snappedIntRect(rect);
     FloatRect devicePixelSnappedRect = snapRectToDevicePixels(rect, box.document().deviceScaleFactor());
 
@@ -107,6 +107,7 @@ void AttributeChangeInvalidation::invalidateStyle(const QualifiedName& attribute
 
         if (oldMatches != newMatches) {
             m_descendantInvalidationRuleSet = attributeRules->ruleSet.get();
+            m_descendantInvalidationSet = &attributeRules->invalidationSet;
             return;
         }
     }
@@ -116,7 +117,7 @@ void AttributeChangeInvalidation::invalidateDescendants()
 {
     if (!m_descendantInvalidationRuleSet)
         return;
-    StyleInvalidationAnalysis invalidationAnalysis(*m_descendantInvalidationRuleSet);
+    StyleInvalidationAnalysis invalidationAnalysis(*m_descendantInvalidationRuleSet, m_descendantInvalidationSet);
     invalidationAnalysis.invalidateStyle(m_element);
 }
 
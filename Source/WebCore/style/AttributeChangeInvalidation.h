@@ -30,6 +30,7 @@
 namespace WebCore {
 
 class RuleSet;
+struct DescendantInvalidationSet;
 
 namespace Style {
 
@@ -46,6 +47,7 @@ private:
     Element& m_element;
 
     const RuleSet* m_descendantInvalidationRuleSet { nullptr };
+    const DescendantInvalidationSet* m_descendantInvalidationSet { nullptr };
 };
 
 inline AttributeChangeInvalidation::AttributeChangeInvalidation(Element& element, const QualifiedName& attributeName, const AtomicString& oldValue, const AtomicString& newValue)
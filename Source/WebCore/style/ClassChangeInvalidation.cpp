@@ -142,14 +142,14 @@ void ClassChangeInvalidation::invalidateStyle(const SpaceSplitString& oldClasses
         auto* ancestorClassRules = ruleSets.ancestorClassRules(changedClass);
         if (!ancestorClassRules)
             continue;
-        m_descendantInvalidationRuleSets.append(ancestorClassRules);
+        m_descendantInvalidationRuleSets.append({ ancestorClassRules, ruleSets.ancestorClassInvalidationSet(changedClass) });
     }
 }
 
 void ClassChangeInvalidation::invalidateDescendantStyle()
 {
-    for (auto* ancestorClassRules : m_descendantInvalidationRuleSets) {
-        StyleInvalidationAnalysis invalidationAnalysis(*ancestorClassRules);
+    for (auto& rules : m_descendantInvalidationRuleSets) {
+        StyleInvalidationAnalysis invalidationAnalysis(*rules.first, rules.second);
         invalidationAnalysis.invalidateStyle(m_element);
     }
 }
@@ -32,6 +32,7 @@ namespace WebCore {
 
 class DocumentRuleSets;
 class RuleSet;
+struct DescendantInvalidationSet;
 class SpaceSplitString;
 
 namespace Style {
@@ -48,7 +49,7 @@ private:
     const bool m_isEnabled;
     Element& m_element;
 
-    Vector<const RuleSet*, 4> m_descendantInvalidationRuleSets;
+    Vector<std::pair<const RuleSet*, const DescendantInvalidationSet*>, 4> m_descendantInvalidationRuleSets;
 };
 
 inline ClassChangeInvalidation::ClassChangeInvalidation(Element& element, const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses)
@@ -688,6 +688,13 @@ void SVGElement::attributeChanged(const QualifiedName& name, const AtomicString&
         svgAttributeChanged(name);
 }
 
+void SVGElement::invalidateSVGAttributes()
+{
+    ensureUniqueElementData().setAnimatedSVGAttributesAreDirty(true);
+    // Animated attributes are synchronized lazily, so this is the only point where they visibly change.
+    document().invalidateQuerySelectorAllResults();
+}
+
 void SVGElement::synchronizeAllAnimatedSVGAttribute(SVGElement* svgElement)
 {
     ASSERT(svgElement->elementData());
@@ -85,7 +85,7 @@ public:
 
     virtual AffineTransform* supplementalTransform() { return nullptr; }
 
-    void invalidateSVGAttributes() { ensureUniqueElementData().setAnimatedSVGAttributesAreDirty(true); }
+    void invalidateSVGAttributes();
     void invalidateSVGPresentationAttributeStyle()
     {
         ensureUniqueElementData().setPresentationAttributeStyleIsDirty(true);
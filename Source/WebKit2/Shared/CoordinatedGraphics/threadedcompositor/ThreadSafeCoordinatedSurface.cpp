@@ -31,6 +31,12 @@
 #include <WebCore/TextureMapperGL.h>
 #include <wtf/StdLibExtras.h>
 
+#if USE(CAIRO)
+#include <WebCore/PlatformContextCairo.h>
+#include <WebCore/RefPtrCairo.h>
+#include <cairo.h>
+#endif
+
 using namespace WebCore;
 
 namespace WebKit {
@@ -59,6 +65,41 @@ void ThreadSafeCoordinatedSurface::paintToSurface(const IntRect& rect, Coordinat
     endPaint();
 }
 
+#if USE(CAIRO)
+Function<void()> ThreadSafeCoordinatedSurface::createThreadSafePainter(const IntRect& rect, CoordinatedSurface::Client& client)
+{
+    ASSERT(m_imageBuffer);
+    auto paintFunction = client.createThreadSafePaintFunction();
+    if (!paintFunction)
+        return nullptr;
+
+    // The painter draws through an image surface of its own that shares the pixels of |rect|,
+    // so raster threads never touch the buffer's cairo objects, which belong to the main thread.
+    // The areas handed out by the update atlas don't overlap, so painters don't race either.
+    // Cairo is told about the new pixels in didPaintOnRasterThread(), once they have been written.
+    cairo_surface_t* surface = cairo_get_target(m_imageBuffer->context().platformContext()->cr());
+    cairo_surface_flush(surface);
+
+    cairo_format_t format = cairo_image_surface_get_format(surface);
+    int stride = cairo_image_surface_get_stride(surface);
+    unsigned char* data = cairo_image_surface_get_data(surface) + rect.y() * stride + rect.x() * 4;
+
+    return [protectedThis = makeRef(*this), data, format, stride, size = rect.size(), paintFunction = WTFMove(paintFunction)] {
+        RefPtr<cairo_surface_t> rectSurface = adoptRef(cairo_image_surface_create_for_data(data, format, size.width(), size.height(), stride));
+        RefPtr<cairo_t> cr = adoptRef(cairo_create(rectSurface.get()));
+        GraphicsContext context(cr.get());
+        paintFunction(context);
+    };
+}
+
+void ThreadSafeCoordinatedSurface::didPaintOnRasterThread(const IntRect& rect)
+{
+    ASSERT(m_imageBuffer);
+    cairo_surface_t* surface = cairo_get_target(m_imageBuffer->context().platformContext()->cr());
+    cairo_surface_mark_dirty_rectangle(surface, rect.x(), rect.y(), rect.width(), rect.height());
+}
+#endif
+
 GraphicsContext& ThreadSafeCoordinatedSurface::beginPaint(const IntRect& rect)
 {
     ASSERT(m_imageBuffer);
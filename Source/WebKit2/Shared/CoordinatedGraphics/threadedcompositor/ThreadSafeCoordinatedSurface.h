@@ -40,6 +40,10 @@ public:
     static Ref<ThreadSafeCoordinatedSurface> create(const WebCore::IntSize&, WebCore::CoordinatedSurface::Flags);
 
     void paintToSurface(const WebCore::IntRect&, WebCore::CoordinatedSurface::Client&) override;
+#if USE(CAIRO)
+    Function<void()> createThreadSafePainter(const WebCore::IntRect&, WebCore::CoordinatedSurface::Client&) override;
+    void didPaintOnRasterThread(const WebCore::IntRect&) override;
+#endif
     void copyToTexture(RefPtr<WebCore::BitmapTexture>, const WebCore::IntRect& target, const WebCore::IntPoint& sourceOffset) override;
 
 private:
@@ -38,6 +38,7 @@
 #include <WebCore/MemoryPressureHandler.h>
 #include <WebCore/Page.h>
 #include <wtf/SetForScope.h>
+#include <wtf/WorkQueue.h>
 
 using namespace WebCore;
 
@@ -114,6 +115,7 @@ bool CompositingCoordinator::flushPendingLayerChanges()
 
     auto& coordinatedLayer = downcast<CoordinatedGraphicsLayer>(*m_rootLayer);
     coordinatedLayer.updateContentBuffersIncludingSubLayers();
+    flushPendingRasterTasks();
     coordinatedLayer.syncPendingStateChangesIncludingSubLayers();
 
     flushPendingImageBackingChanges();
@@ -252,6 +254,23 @@ void CompositingCoordinator::flushPendingImageBackingChanges()
         imageBacking->update();
 }
 
+void CompositingCoordinator::flushPendingRasterTasks()
+{
+    if (m_pendingRasterTasks.isEmpty())
+        return;
+
+    // Replay the recorded tile contents on all cores, including this one, and wait for them
+    // so that every tile update is complete before the scene state is committed. The tasks
+    // are destroyed here, on the main thread, where the recordings they hold were made.
+    auto tasks = WTFMove(m_pendingRasterTasks);
+    WorkQueue::concurrentApply(tasks.size(), [&tasks](size_t index) {
+        tasks[index].painter();
+    });
+
+    for (auto& task : tasks)
+        task.completionHandler();
+}
+
 void CompositingCoordinator::notifyAnimationStarted(const GraphicsLayer*, const String&, double /* time */)
 {
 }
@@ -300,6 +319,12 @@ void CompositingCoordinator::removeUpdateAtlas(uint32_t atlasID)
     m_state.updateAtlasesToRemove.append(atlasID);
 }
 
+void CompositingCoordinator::paintOnRasterThread(Function<void()>&& painter, Function<void()>&& completionHandler)
+{
+    ASSERT(isFlushingLayerChanges());
+    m_pendingRasterTasks.append({ WTFMove(painter), WTFMove(completionHandler) });
+}
+
 FloatRect CompositingCoordinator::visibleContentsRect() const
 {
     return m_visibleContentsRect;
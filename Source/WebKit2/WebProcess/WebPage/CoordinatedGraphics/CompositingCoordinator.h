@@ -119,12 +119,14 @@ private:
     // UpdateAtlas::Client
     void createUpdateAtlas(uint32_t atlasID, RefPtr<WebCore::CoordinatedSurface>&&) override;
     void removeUpdateAtlas(uint32_t atlasID) override;
+    void paintOnRasterThread(Function<void()>&&, Function<void()>&&) override;
 
     // GraphicsLayerFactory
     std::unique_ptr<WebCore::GraphicsLayer> createGraphicsLayer(WebCore::GraphicsLayer::Type, WebCore::GraphicsLayerClient&) override;
 
     void initializeRootCompositingLayerIfNeeded();
     void flushPendingImageBackingChanges();
+    void flushPendingRasterTasks();
     void clearPendingStateChanges();
 
     void purgeBackingStores();
@@ -149,6 +151,11 @@ private:
     typedef HashMap<WebCore::CoordinatedImageBackingID, RefPtr<WebCore::CoordinatedImageBacking> > ImageBackingMap;
     ImageBackingMap m_imageBackings;
     Vector<std::unique_ptr<UpdateAtlas>> m_updateAtlases;
+    struct RasterTask {
+        Function<void()> painter;
+        Function<void()> completionHandler;
+    };
+    Vector<RasterTask> m_pendingRasterTasks;
 
     // We don't send the messages related to releasing resources to renderer during purging, because renderer already had removed all resources.
     bool m_isDestructing { false };
@@ -43,16 +43,34 @@ public:
 
     void paintToSurfaceContext(GraphicsContext& context) override
     {
-        if (m_supportsAlpha) {
-            context.setCompositeOperation(CompositeCopy);
-            context.fillRect(IntRect(IntPoint::zero(), m_size), Color::transparent);
-            context.setCompositeOperation(CompositeSourceOver);
-        }
+        if (m_supportsAlpha)
+            clear(context, m_size);
 
         m_client.paintToSurfaceContext(context);
     }
 
+    Function<void(GraphicsContext&)> createThreadSafePaintFunction() override
+    {
+        auto paintFunction = m_client.createThreadSafePaintFunction();
+        if (!paintFunction)
+            return nullptr;
+
+        return [size = m_size, supportsAlpha = m_supportsAlpha, paintFunction = WTFMove(paintFunction)](GraphicsContext& context) {
+            if (supportsAlpha)
+                clear(context, size);
+
+            paintFunction(context);
+        };
+    }
+
 private:
+    static void clear(GraphicsContext& context, const IntSize& size)
+    {
+        context.setCompositeOperation(CompositeCopy);
+        context.fillRect(IntRect(IntPoint::zero(), size), Color::transparent);
+        context.setCompositeOperation(CompositeSourceOver);
+    }
+
     CoordinatedSurface::Client& m_client;
     IntSize m_size;
     bool m_supportsAlpha;
@@ -107,6 +125,13 @@ bool UpdateAtlas::paintOnAvailableBuffer(const IntSize& size, uint32_t& atlasID,
     offset = rect.location();
 
     UpdateAtlasSurfaceClient surfaceClient(client, size, supportsAlpha());
+    if (auto painter = m_surface->createThreadSafePainter(rect, surfaceClient)) {
+        m_client.paintOnRasterThread(WTFMove(painter), [surface = m_surface, rect] {
+            surface->didPaintOnRasterThread(rect);
+        });
+        return true;
+    }
+
     m_surface->paintToSurface(rect, surfaceClient);
 
     return true;
@@ -42,6 +42,9 @@ public:
     public:
         virtual void createUpdateAtlas(uint32_t /* id */, RefPtr<WebCore::CoordinatedSurface>&&) = 0;
         virtual void removeUpdateAtlas(uint32_t /* id */) = 0;
+        // The painter has to run before the painted area is committed, and be destroyed on the main thread.
+        // The completion handler runs on the main thread once the painter has finished.
+        virtual void paintOnRasterThread(Function<void()>&& /* painter */, Function<void()>&& /* completionHandler */) = 0;
     };
 
     UpdateAtlas(Client&, int dimension, WebCore::CoordinatedSurface::Flags);
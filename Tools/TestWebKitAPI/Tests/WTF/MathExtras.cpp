@@ -174,4 +174,21 @@ TEST(WTF, clampToUnsignedLongLong)
     EXPECT_EQ(clampTo<unsigned>(-1), 0u);
 }
 
+TEST(WTF, countTrailingZeros)
+{
+    EXPECT_EQ(0u, WTF::countTrailingZeros(1));
+    EXPECT_EQ(0u, WTF::countTrailingZeros(0xffffffff));
+    EXPECT_EQ(1u, WTF::countTrailingZeros(2));
+    EXPECT_EQ(2u, WTF::countTrailingZeros(0x0c));
+    EXPECT_EQ(4u, WTF::countTrailingZeros(0xf0));
+    EXPECT_EQ(16u, WTF::countTrailingZeros(0x10000));
+    EXPECT_EQ(16u, WTF::countTrailingZeros(0xffff0000));
+    EXPECT_EQ(31u, WTF::countTrailingZeros(0x80000000));
+
+    for (unsigned i = 0; i < 32; ++i) {
+        EXPECT_EQ(i, WTF::countTrailingZeros(1u << i));
+        EXPECT_EQ(i, WTF::countTrailingZeros(0xffffffffu << i));
+    }
+}
+
 } // namespace TestWebKitAPI
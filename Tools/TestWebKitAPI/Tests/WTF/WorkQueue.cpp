@@ -30,6 +30,8 @@
 #include <wtf/Lock.h>
 #include <wtf/Vector.h>
 #include <wtf/WorkQueue.h>
+#include <atomic>
+#include <limits>
 #include <string>
 #include <thread>
 
@@ -233,4 +235,80 @@ TEST(WTF_WorkQueue, DestroyOnSelf)
     }
 }
 
+TEST(WTF_WorkQueue, ConcurrentApply)
+{
+    static const size_t iterations = 1000;
+    Lock lock;
+    Vector<unsigned> visits(iterations, 0);
+
+    WorkQueue::concurrentApply(iterations, [&](size_t index) {
+        LockHolder locker(lock);
+        ++visits[index];
+    });
+
+    for (size_t i = 0; i < iterations; ++i)
+        EXPECT_EQ(1u, visits[i]);
+}
+
+TEST(WTF_WorkQueue, ConcurrentApplyZeroAndOneIterations)
+{
+    unsigned calls = 0;
+    WorkQueue::concurrentApply(0, [&](size_t) {
+        ++calls;
+    });
+    EXPECT_EQ(0u, calls);
+
+    size_t lastIndex = std::numeric_limits<size_t>::max();
+    WorkQueue::concurrentApply(1, [&](size_t index) {
+        ++calls;
+        lastIndex = index;
+    });
+    EXPECT_EQ(1u, calls);
+    EXPECT_EQ(static_cast<size_t>(0), lastIndex);
+}
+
+TEST(WTF_WorkQueue, ConcurrentApplyNested)
+{
+    // Nested calls must not deadlock, even when every worker of the pool is busy with an outer iteration.
+    static const size_t outerIterations = 64;
+    static const size_t innerIterations = 64;
+    std::atomic<size_t> visits { 0 };
+
+    WorkQueue::concurrentApply(outerIterations, [&](size_t) {
+        WorkQueue::concurrentApply(innerIterations, [&](size_t) {
+            ++visits;
+        });
+    });
+
+    EXPECT_EQ(outerIterations * innerIterations, visits.load());
+}
+
+TEST(WTF_WorkQueue, ConcurrentApplyFromWorkQueue)
+{
+    static const size_t iterations = 100;
+    Lock lock;
+    Condition testCompleted;
+    bool completed = false;
+    std::atomic<size_t> visits { 0 };
+
+    auto queue = WorkQueue::create("com.apple.WebKit.Test.concurrentApply");
+
+    LockHolder locker(lock);
+    queue->dispatch([&](void) {
+        WorkQueue::concurrentApply(iterations, [&](size_t) {
+            ++visits;
+        });
+
+        LockHolder locker(lock);
+        completed = true;
+        testCompleted.notifyOne();
+    });
+
+    testCompleted.wait(lock, [&] {
+        return completed;
+    });
+
+    EXPECT_EQ(iterations, visits.load());
+}
+
 } // namespace TestWebKitAPI
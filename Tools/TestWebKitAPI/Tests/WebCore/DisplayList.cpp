@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if USE(CAIRO)
+
+#include "Test.h"
+#include <WebCore/Color.h>
+#include <WebCore/DisplayList.h>
+#include <WebCore/DisplayListRecorder.h>
+#include <WebCore/DisplayListReplayer.h>
+#include <WebCore/FloatRect.h>
+#include <WebCore/FloatRoundedRect.h>
+#include <WebCore/GraphicsContext.h>
+#include <WebCore/RefPtrCairo.h>
+#include <cairo.h>
+#include <wtf/Function.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+static const int surfaceSize = 64;
+
+static void paintContents(GraphicsContext& context)
+{
+    context.fillRect(FloatRect(0, 0, surfaceSize, surfaceSize), Color::white);
+    context.save();
+    context.translate(8, 8);
+    context.fillRect(FloatRect(0, 0, 24, 16), Color(255, 0, 0));
+    context.setStrokeColor(Color(0, 0, 255));
+    context.strokeRect(FloatRect(4, 20, 30, 30), 3);
+    context.restore();
+    context.fillRoundedRect(FloatRoundedRect(FloatRect(36, 36, 20, 20), FloatRoundedRect::Radii(4)), Color(0, 128, 0, 128), BlendModeNormal);
+}
+
+static RefPtr<cairo_surface_t> paintToSurface(const WTF::Function<void(GraphicsContext&)>& paint)
+{
+    RefPtr<cairo_surface_t> surface = adoptRef(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, surfaceSize, surfaceSize));
+    RefPtr<cairo_t> cr = adoptRef(cairo_create(surface.get()));
+    {
+        GraphicsContext context(cr.get());
+        paint(context);
+    }
+    cairo_surface_flush(surface.get());
+    return surface;
+}
+
+static bool surfacesHaveSamePixels(cairo_surface_t* a, cairo_surface_t* b)
+{
+    int stride = cairo_image_surface_get_stride(a);
+    if (stride != cairo_image_surface_get_stride(b))
+        return false;
+    return !memcmp(cairo_image_surface_get_data(a), cairo_image_surface_get_data(b), stride * surfaceSize);
+}
+
+TEST(WebCoreDisplayList, ReplayMatchesDirectPainting)
+{
+    FloatRect clip(0, 0, surfaceSize, surfaceSize);
+
+    DisplayList::DisplayList displayList;
+    {
+        GraphicsContext recordingContext;
+        DisplayList::Recorder recorder(recordingContext, displayList, clip, AffineTransform());
+        paintContents(recordingContext);
+    }
+    EXPECT_FALSE(displayList.hasUnrecordedDrawing());
+    EXPECT_TRUE(displayList.canBeReplayedOffMainThread());
+
+    auto directSurface = paintToSurface([](GraphicsContext& context) {
+        paintContents(context);
+    });
+    auto replayedSurface = paintToSurface([&](GraphicsContext& context) {
+        DisplayList::Replayer replayer(context, displayList);
+        replayer.replay(clip);
+    });
+    EXPECT_TRUE(surfacesHaveSamePixels(directSurface.get(), replayedSurface.get()));
+}
+
+TEST(WebCoreDisplayList, SkippedDrawingIsRemembered)
+{
+    FloatRect clip(0, 0, surfaceSize, surfaceSize);
+
+    DisplayList::DisplayList displayList;
+    {
+        GraphicsContext recordingContext;
+        DisplayList::Recorder recorder(recordingContext, displayList, clip, AffineTransform());
+        recordingContext.fillRect(clip, Color::white);
+        EXPECT_FALSE(displayList.hasUnrecordedDrawing());
+
+        // This is what native theme painting does when it finds a recording context.
+        recordingContext.save();
+        recordingContext.didSkipUnrecordableDrawing();
+        recordingContext.restore();
+    }
+    EXPECT_TRUE(displayList.hasUnrecordedDrawing());
+
+    displayList.clear();
+    EXPECT_FALSE(displayList.hasUnrecordedDrawing());
+
+    // Outside of recording there is nothing to remember.
+    paintToSurface([](GraphicsContext& context) {
+        context.didSkipUnrecordableDrawing();
+    });
+}
+
+} // namespace TestWebKitAPI
+
+#endif // USE(CAIRO)
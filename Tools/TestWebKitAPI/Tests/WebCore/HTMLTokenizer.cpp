@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "Test.h"
+#include <WebCore/HTMLNames.h>
+#include <WebCore/HTMLTokenizer.h>
+#include <WebCore/SegmentedString.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace WebCore;
+
+namespace TestWebKitAPI {
+
+enum class TagNameKind { Atomic, Characters };
+
+// Tokenizes the whole input, switching states after start tags the way the preload scanners do,
+// and returns a summary of the tokens.
+static String tokenize(const String& input, TagNameKind tagNameKind)
+{
+    HTMLNames::init();
+
+    HTMLTokenizer tokenizer;
+    SegmentedString source(input);
+    StringBuilder result;
+    while (auto token = tokenizer.nextToken(source)) {
+        switch (token->type()) {
+        case HTMLToken::StartTag:
+            result.append("start(");
+            result.append(token->name().data(), token->name().size());
+            result.append(')');
+            if (tagNameKind == TagNameKind::Atomic)
+                tokenizer.updateStateFor(AtomicString(token->name().data(), token->name().size()));
+            else
+                tokenizer.updateStateFor(token->name());
+            break;
+        case HTMLToken::EndTag:
+            result.append("end(");
+            result.append(token->name().data(), token->name().size());
+            result.append(')');
+            break;
+        case HTMLToken::Character:
+            result.append("text(");
+            result.append(token->characters().data(), token->characters().size());
+            result.append(')');
+            break;
+        default:
+            result.append("other");
+            break;
+        }
+    }
+    return result.toString();
+}
+
+TEST(WebCoreHTMLTokenizer, UpdateStateForTagNameCharacters)
+{
+    static const char* inputs[] = {
+        "<p>text<b>bold</b></p>",
+        "<title><b>not a tag</b></title>after",
+        "<textarea>&lt;<i></textarea>",
+        "<script>if (a <b) c();</script><img src=x>",
+        "<style>a { background: url(<img>) }</style><link href=y>",
+        "<iframe><p></iframe><xmp><p></xmp><noframes><p></noframes>",
+        "<TITLE><p></TITLE><Style><p></Style>",
+        "<titles><p></titles>",
+        "<plaintext><p></plaintext>",
+    };
+
+    for (auto* input : inputs)
+        EXPECT_EQ(tokenize(input, TagNameKind::Atomic), tokenize(input, TagNameKind::Characters)) << input;
+
+    // The character overload has to switch states, and only for exact tag names.
+    EXPECT_EQ(notFound, tokenize("<title><b>not a tag</b></title>after", TagNameKind::Characters).find("start(b)"));
+    EXPECT_EQ(notFound, tokenize("<TITLE><p></TITLE>", TagNameKind::Characters).find("start(p)"));
+    EXPECT_NE(notFound, tokenize("<titles><p></titles>", TagNameKind::Characters).find("start(p)"));
+    EXPECT_EQ(notFound, tokenize("<plaintext><p></plaintext>", TagNameKind::Characters).find("end(plaintext)"));
+}
+
+} // namespace TestWebKitAPI
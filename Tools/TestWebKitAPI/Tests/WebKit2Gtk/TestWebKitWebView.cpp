@@ -994,6 +994,50 @@ static void testWebViewPreferredSize(WebViewTest* test, gconstpointer)
     g_assert_cmpint(naturalSize.height, ==, 615);
 }
 
+static void testWebViewQuerySelectorAllResultsInvalidation(WebViewTest* test, gconstpointer)
+{
+    test->loadHtml("<html><body></body></html>", nullptr);
+    test->waitUntilLoadFinished();
+
+    // Every query runs twice, so that the second one can come from the cache of querySelectorAll() results.
+    static const char* script =
+        "(function() {"
+        "    document.body.innerHTML = \"<div id='a' class='item'></div><div id='b'></div><p></p><span style='color: red'></span><svg><rect width='10' height='10'></rect></svg>\";"
+        "    var failures = [];"
+        "    function expectCount(change, selector, count) {"
+        "        for (var i = 0; i < 2; ++i) {"
+        "            var found = document.querySelectorAll(selector).length;"
+        "            if (found != count)"
+        "                failures.push(change + ': ' + selector + ' matched ' + found + ' elements instead of ' + count);"
+        "        }"
+        "    }"
+        "    expectCount('initial', '.item', 1);"
+        "    document.getElementById('b').setAttribute('class', 'item');"
+        "    expectCount('attribute', '.item', 2);"
+        "    var paragraph = document.querySelector('p');"
+        "    paragraph.appendChild(document.createTextNode(''));"
+        "    expectCount('empty text', 'p:empty', 1);"
+        "    paragraph.firstChild.data = 'text';"
+        "    expectCount('text', 'p:empty', 0);"
+        "    expectCount('initial', 'span[style*=blue]', 0);"
+        "    document.querySelector('span').style.color = 'blue';"
+        "    expectCount('style', 'span[style*=blue]', 1);"
+        "    expectCount('initial', 'rect[width=\"20\"]', 0);"
+        "    document.querySelector('rect').width.baseVal.value = 20;"
+        "    expectCount('SVG animated attribute', 'rect[width=\"20\"]', 1);"
+        "    document.getElementById('a').remove();"
+        "    expectCount('removal', '.item', 1);"
+        "    return failures.length ? failures.join('; ') : 'PASS';"
+        "})();";
+
+    GUniqueOutPtr<GError> error;
+    WebKitJavascriptResult* javascriptResult = test->runJavaScriptAndWaitUntilFinished(script, &error.outPtr());
+    g_assert(javascriptResult);
+    g_assert(!error.get());
+    GUniquePtr<char> valueString(WebViewTest::javascriptResultToCString(javascriptResult));
+    g_assert_cmpstr(valueString.get(), ==, "PASS");
+}
+
 class WebViewTitleTest: public WebViewTest {
 public:
     MAKE_GLIB_TEST_FIXTURE(WebViewTitleTest);
@@ -1078,6 +1122,7 @@ void beforeAll()
     IsPlayingAudioWebViewTest::add("WebKitWebView", "is-playing-audio", testWebViewIsPlayingAudio);
     WebViewTest::add("WebKitWebView", "background-color", testWebViewBackgroundColor);
     WebViewTest::add("WebKitWebView", "preferred-size", testWebViewPreferredSize);
+    WebViewTest::add("WebKitWebView", "query-selector-all-results-invalidation", testWebViewQuerySelectorAllResultsInvalidation);
     WebViewTitleTest::add("WebKitWebView", "title-change", testWebViewTitleChange);
 }
 